@@ -75,6 +75,7 @@
 #include <Base/PlacementPy.h>
 #include <Base/RotationPy.h>
 #include <Base/Sequencer.h>
+#include <Base/StartupTrace.h>
 #include <Base/Tools.h>
 #include <Base/Translate.h>
 #include <Base/UnitsApi.h>
@@ -454,6 +455,7 @@ Document* Application::newDocument(const char * Name, const char * UserName, boo
     }
 
     signalNewDocument(*_pActiveDoc, createView);
+    Expression::invalidateBindings();
 
     // set the UserName after notifying all observers
     _pActiveDoc->Label.setValue(userName);
@@ -476,6 +478,7 @@ bool Application::closeDocument(const char* name)
     // Trigger observers before removing the document from the internal map.
     // Some observers might rely on this document still being there.
     signalDeleteDocument(*pos->second);
+    Expression::invalidateBindings();
 
     // For exception-safety use a smart pointer
     if (_pActiveDoc == pos->second)
@@ -1362,12 +1365,14 @@ void Application::slotNewObject(const App::DocumentObject&O)
 {
     this->signalNewObject(O);
     _objCount = -1;
+    Expression::invalidateBindings();
 }
 
 void Application::slotDeletedObject(const App::DocumentObject&O)
 {
     this->signalDeletedObject(O);
     _objCount = -1;
+    Expression::invalidateBindings();
 }
 
 void Application::slotBeforeChangeObject(const DocumentObject& O, const Property& Prop)
@@ -1383,6 +1388,7 @@ void Application::slotChangedObject(const App::DocumentObject&O, const App::Prop
 void Application::slotRelabelObject(const App::DocumentObject&O)
 {
     this->signalRelabelObject(O);
+    Expression::invalidateBindings();
 }
 
 void Application::slotActivatedObject(const App::DocumentObject&O)
@@ -1456,6 +1462,9 @@ char ** Application::_argv;
 
 void Application::destruct(void)
 {
+    // in case the startup has never been completed
+    Base::StartupTrace::instance().finish();
+
     // saving system parameter
     Console().Log("Saving system parameter...\n");
     _pcSysParamMngr->SaveDocument();
@@ -1666,14 +1675,28 @@ void Application::init(int argc, char ** argv)
 #if defined(FC_SE_TRANSLATOR)
         _set_se_translator(my_se_translator_filter);
 #endif
-        initTypes();
+        // the trace is written once the application is up, see runApplication()
+        const char* traceFile = getenv("FREECAD_STARTUP_TRACE");
+        if (traceFile)
+            Base::StartupTrace::instance().start(traceFile);
+
+        {
+            Base::StartupTrace::Scope trace("init", "initTypes");
+            initTypes();
+        }
 
 #if (BOOST_VERSION < 104600) || (BOOST_FILESYSTEM_VERSION == 2)
         boost::filesystem::path::default_name_check(boost::filesystem::no_check);
 #endif
 
-        initConfig(argc,argv);
-        initApplication();
+        {
+            Base::StartupTrace::Scope trace("init", "initConfig");
+            initConfig(argc,argv);
+        }
+        {
+            Base::StartupTrace::Scope trace("init", "initApplication");
+            initApplication();
+        }
     }
     catch (...) {
         // force the log to flush
@@ -1927,7 +1950,11 @@ void Application::initConfig(int argc, char ** argv)
     PyImport_AppendInittab ("FreeCAD", init_freecad_module);
     PyImport_AppendInittab ("__FreeCADBase__", init_freecad_base_module);
 #endif
-    const char* pythonpath = Interpreter().init(argc,argv);
+    const char* pythonpath;
+    {
+        Base::StartupTrace::Scope trace("init", "Python");
+        pythonpath = Interpreter().init(argc,argv);
+    }
     if (pythonpath)
         mConfig["PythonSearchPath"] = pythonpath;
     else
@@ -1971,7 +1998,10 @@ void Application::initConfig(int argc, char ** argv)
                               mConfig["BuildVersionMinor"].c_str(),
                               mConfig["BuildRevision"].c_str());
     }
-    LoadParameters();
+    {
+        Base::StartupTrace::Scope trace("init", "LoadParameters");
+        LoadParameters();
+    }
 
     auto loglevelParam = _pcUserParamMngr->GetGroup("BaseApp/LogLevels");
     const auto &loglevels = loglevelParam->GetIntMap();
@@ -2078,6 +2108,7 @@ void Application::initApplication(void)
     Console().Log("Run App init script\n");
     try {
         Interpreter().runString(Base::ScriptFactory().ProduceScript("CMakeVariables"));
+        Base::StartupTrace::Scope trace("script", "FreeCADInit.py");
         Interpreter().runString(Base::ScriptFactory().ProduceScript("FreeCADInit"));
     }
     catch (const Base::Exception& e) {
@@ -2220,6 +2251,8 @@ void Application::processCmdLineFiles(void)
 
 void Application::runApplication()
 {
+    Base::StartupTrace::instance().finish();
+
     // process all files given through command line interface
     processCmdLineFiles();
 
@@ -45,6 +45,7 @@
 #include <Base/FileInfo.h>
 #include <Base/UnitsApi.h>
 #include <Base/Sequencer.h>
+#include <Base/StartupTrace.h>
 
 //using Base::GetConsole;
 using namespace Base;
@@ -185,6 +186,12 @@ PyMethodDef Application::Methods[] = {
      "There is an active sequencer during document restore and recomputation. User may\n"
      "abort the operation by pressing the ESC key. Once detected, this function will\n"
      "trigger a BaseExceptionFreeCADAbort exception."},
+    {"beginStartupTrace", (PyCFunction) Application::sBeginStartupTrace, METH_VARARGS,
+     "beginStartupTrace(category, name) -- open an event of the startup trace\n\n"
+     "The event is closed by endStartupTrace(). Nothing is recorded unless the\n"
+     "environment variable FREECAD_STARTUP_TRACE is set when starting the application."},
+    {"endStartupTrace", (PyCFunction) Application::sEndStartupTrace, METH_VARARGS,
+     "endStartupTrace() -- close the event opened last by beginStartupTrace()"},
     {NULL, NULL, 0, NULL}		/* Sentinel */
 };
 
@@ -971,3 +978,22 @@ PyObject *Application::sCheckAbort(PyObject * /*self*/, PyObject *args)
         Py_Return;
     }PY_CATCH
 }
+
+PyObject *Application::sBeginStartupTrace(PyObject * /*self*/, PyObject *args)
+{
+    char *category, *name;
+    if (!PyArg_ParseTuple(args, "ss", &category, &name))
+        return 0;
+
+    Base::StartupTrace::instance().begin(category, name);
+    Py_Return;
+}
+
+PyObject *Application::sEndStartupTrace(PyObject * /*self*/, PyObject *args)
+{
+    if (!PyArg_ParseTuple(args, ""))
+        return 0;
+
+    Base::StartupTrace::instance().end();
+    Py_Return;
+}
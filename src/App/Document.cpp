@@ -97,6 +97,7 @@ recompute path. Also, it enables more complicated dependencies beyond trees.
 #include "DocumentObject.h"
 #include "MergeDocuments.h"
 #include "ExpressionParser.h"
+#include "RecomputeProfiler.h"
 #include <App/DocumentPy.h>
 
 #include <Base/Console.h>
@@ -190,6 +191,15 @@ struct DocumentP
 #endif //USE_OLD_DAG
     std::multimap<const App::DocumentObject*, 
         std::unique_ptr<App::DocumentObjectExecReturn> > _RecomputeLog;
+    RecomputeProfiler profiler;
+
+    // state of Document::beginBulkInsert()
+    int bulkInsert;
+    std::vector<DocumentObject*> bulkObjects;
+    Base::UniqueNameTable bulkNames;
+    Base::UniqueNameTable bulkLabels;
+    std::unordered_map<std::string, int> bulkLabelCount;
+    boost::signals2::scoped_connection connectBulkRelabel;
 
     DocumentP() {
         static std::random_device _RD;
@@ -211,6 +221,35 @@ struct DocumentP
         iUndoMode = 0;
         UndoMemSize = 0;
         UndoMaxStackSize = 20;
+        bulkInsert = 0;
+    }
+
+    void addBulkLabel(const std::string &label) {
+        ++bulkLabelCount[label];
+        bulkLabels.addName(label);
+    }
+
+    void removeBulkLabel(const std::string &label) {
+        auto it = bulkLabelCount.find(label);
+        if(it!=bulkLabelCount.end() && --it->second<=0)
+            bulkLabelCount.erase(it);
+    }
+
+    void addBulkObject(const std::string &name, DocumentObject *obj) {
+        if(!bulkInsert)
+            return;
+        bulkNames.addName(name);
+        // Track the current label, the relabel signal will replace it
+        addBulkLabel(obj->Label.getStrValue());
+        bulkObjects.push_back(obj);
+    }
+
+    void removeBulkObject(DocumentObject *obj) {
+        if(!bulkInsert)
+            return;
+        removeBulkLabel(obj->Label.getStrValue());
+        bulkObjects.erase(std::remove(bulkObjects.begin(), bulkObjects.end(), obj),
+                          bulkObjects.end());
     }
 
     void addRecomputeLog(const char *why, App::DocumentObject *obj) {
@@ -1229,6 +1268,15 @@ void Document::_commitTransaction(bool notify)
             delete mUndoTransactions.front();
             mUndoTransactions.pop_front();
         }
+        if(d->UndoMemSize) {
+            unsigned int size = getUndoMemSize();
+            while(size > d->UndoMemSize && mUndoTransactions.size() > 1) {
+                size -= std::min(size, mUndoTransactions.front()->getMemSize());
+                mUndoMap.erase(mUndoTransactions.front()->getID());
+                delete mUndoTransactions.front();
+                mUndoTransactions.pop_front();
+            }
+        }
         signalCommitTransaction(*this);
 
         if(notify)
@@ -1325,6 +1373,7 @@ void Document::clearDocument()
         }
         this->d->objectMap.clear();
         this->d->objectIdMap.clear();
+        Expression::invalidateBindings();
         GetApplication().signalNewDocument(*this,false);
     }
 
@@ -1424,7 +1473,12 @@ int Document::getUndoMode(void) const
 
 unsigned int Document::getUndoMemSize (void) const
 {
-    return d->UndoMemSize;
+    unsigned int size = 0;
+    for (auto transaction : mUndoTransactions)
+        size += transaction->getMemSize();
+    for (auto transaction : mRedoTransactions)
+        size += transaction->getMemSize();
+    return size;
 }
 
 void Document::setUndoLimit(unsigned int UndoMemSize)
@@ -1456,6 +1510,7 @@ void Document::onChanged(const Property* prop)
     // the Name property is a label for display purposes
     if (prop == &Label) {
         Base::FlagToggler<> flag(_IsRelabeling);
+        Expression::invalidateBindings();
         App::GetApplication().signalRelabelDocument(*this);
     } else if(prop == &ShowHidden) {
         App::GetApplication().signalShowHidden(*this);
@@ -1506,6 +1561,8 @@ void Document::onBeforeChangeProperty(const TransactionalObject *Who, const Prop
 
 void Document::onChangedProperty(const DocumentObject *Who, const Property *What)
 {
+    if (d->profiler.isEnabled() && !testStatus(Document::Restoring))
+        d->profiler.propertyChanged(Who, What);
     signalChangedObject(*Who, *What);
 }
 
@@ -2688,6 +2745,7 @@ void Document::restore (const char *filename,
         }
         d->objectMap.clear();
         d->objectIdMap.clear();
+        Expression::invalidateBindings();
     }
 
     Base::FlagToggler<> flag(_IsRestoring,false);
@@ -3451,6 +3509,8 @@ int Document::recompute(const std::vector<App::DocumentObject*> &objs, bool forc
     for(auto obj : topoSortedObjects)
         obj->setStatus(ObjectStatus::PendingRecompute,true);
 
+    RecomputeProfiler::Recompute profilerRecompute(d->profiler, topoSortedObjects);
+
     ParameterGrp::handle hGrp = GetApplication().GetParameterGroupByPath(
             "User parameter:BaseApp/Preferences/Document");
     bool canAbort = hGrp->GetBool("CanAbortRecompute",true);
@@ -3495,8 +3555,11 @@ int Document::recompute(const std::vector<App::DocumentObject*> &objs, bool forc
                     signalRecomputedObject(*obj);
                     obj->purgeTouched();
                     // set all dependent object touched to force recompute
-                    for (auto inObjIt : obj->getInList())
+                    for (auto inObjIt : obj->getInList()) {
+                        if(d->profiler.isEnabled())
+                            d->profiler.recomputeEnforced(inObjIt,obj);
                         inObjIt->enforceRecompute();
+                    }
                 }
             }
             // check if all objects are recomputed but still thouched 
@@ -3711,6 +3774,11 @@ std::vector<App::DocumentObject*> Document::topologicalSort() const
     return d->topologicalSort(d->objectArray);
 }
 
+RecomputeProfiler &Document::getRecomputeProfiler() const
+{
+    return d->profiler;
+}
+
 const char * Document::getErrorDescription(const App::DocumentObject*Obj) const
 {
     return d->findRecomputeLog(Obj);
@@ -3721,6 +3789,7 @@ int Document::_recomputeFeature(DocumentObject* Feat)
 {
     FC_LOG("Recomputing " << Feat->getFullName());
 
+    RecomputeProfiler::Measure measure(d->profiler, Feat);
     DocumentObjectExecReturn  *returnCode = 0;
     try {
         returnCode = Feat->ExpressionEngine.execute(PropertyExpressionEngine::ExecuteNonOutput);
@@ -3835,6 +3904,7 @@ DocumentObject * Document::addObject(const char* sType, const char* pObjectName,
     pcObject->pcNameInDocument = &(d->objectMap.find(ObjectName)->first);
     // insert in the vector
     d->objectArray.push_back(pcObject);
+    d->addBulkObject(ObjectName, pcObject);
     // insert in the adjacence list and reference through the ConectionMap
     //_DepConMap[pcObject] = add_vertex(_DepList);
 
@@ -3866,7 +3936,8 @@ DocumentObject * Document::addObject(const char* sType, const char* pObjectName,
         signalTransactionAppend(*pcObject, d->activeUndoTransaction);
     }
 
-    signalActivatedObject(*pcObject);
+    if (!d->bulkInsert)
+        signalActivatedObject(*pcObject);
 
     // return the Object
     return pcObject;
@@ -3937,6 +4008,7 @@ std::vector<DocumentObject *> Document::addObjects(const char* sType, const std:
         pcObject->pcNameInDocument = &(d->objectMap.find(ObjectName)->first);
         // insert in the vector
         d->objectArray.push_back(pcObject);
+        d->addBulkObject(ObjectName, pcObject);
 
         pcObject->Label.setValue(ObjectName);
 
@@ -3961,7 +4033,8 @@ std::vector<DocumentObject *> Document::addObjects(const char* sType, const std:
 
     if (!objects.empty()) {
         d->activeObject = objects.back();
-        signalActivatedObject(*objects.back());
+        if (!d->bulkInsert)
+            signalActivatedObject(*objects.back());
     }
 
     return objects;
@@ -4001,6 +4074,7 @@ void Document::addObject(DocumentObject* pcObject, const char* pObjectName)
     pcObject->pcNameInDocument = &(d->objectMap.find(ObjectName)->first);
     // insert in the vector
     d->objectArray.push_back(pcObject);
+    d->addBulkObject(ObjectName, pcObject);
 
     pcObject->Label.setValue( ObjectName );
 
@@ -4017,7 +4091,8 @@ void Document::addObject(DocumentObject* pcObject, const char* pObjectName)
         signalTransactionAppend(*pcObject, d->activeUndoTransaction);
     }
 
-    signalActivatedObject(*pcObject);
+    if (!d->bulkInsert)
+        signalActivatedObject(*pcObject);
 }
 
 void Document::_addObject(DocumentObject* pcObject, const char* pObjectName)
@@ -4028,6 +4103,7 @@ void Document::_addObject(DocumentObject* pcObject, const char* pObjectName)
     if(!pcObject->_Id) pcObject->_Id = ++d->lastObjectId;
     d->objectIdMap[pcObject->_Id] = pcObject;
     d->objectArray.push_back(pcObject);
+    d->addBulkObject(ObjectName, pcObject);
     // cache the pointer to the name string in the Object (for performance of DocumentObject::getNameInDocument())
     pcObject->pcNameInDocument = &(d->objectMap.find(ObjectName)->first);
 
@@ -4051,7 +4127,8 @@ void Document::_addObject(DocumentObject* pcObject, const char* pObjectName)
     }
 
     d->activeObject = pcObject;
-    signalActivatedObject(*pcObject);
+    if (!d->bulkInsert)
+        signalActivatedObject(*pcObject);
 }
 
 /// Remove an object out of the document
@@ -4160,6 +4237,7 @@ void Document::removeObject(const char* sName)
         }
     }
 
+    d->removeBulkObject(pos->second);
     pos->second->setStatus(ObjectStatus::Remove, false); // Unset the bit to be on the safe side
     d->objectIdMap.erase(pos->second->_Id);
     d->objectMap.erase(pos);
@@ -4224,6 +4302,7 @@ void Document::_removeObject(DocumentObject* pcObject)
     }
 
     // remove from map
+    d->removeBulkObject(pcObject);
     pcObject->setStatus(ObjectStatus::Remove, false); // Unset the bit to be on the safe side
     d->objectIdMap.erase(pcObject->_Id);
     d->objectMap.erase(pos);
@@ -4501,6 +4580,9 @@ std::string Document::getUniqueObjectName(const char *Name) const
             }
         }
 
+        if (d->bulkInsert)
+            return d->bulkNames.getUniqueName(CleanName, 3);
+
         std::vector<std::string> names;
         names.reserve(d->objectMap.size());
         for (pos = d->objectMap.begin();pos != d->objectMap.end();++pos) {
@@ -4510,6 +4592,75 @@ std::string Document::getUniqueObjectName(const char *Name) const
     }
 }
 
+void Document::beginBulkInsert(std::size_t reserve)
+{
+    if (d->bulkInsert++)
+        return;
+
+    d->StatusBits.set((size_t)BulkInsert, true);
+
+    std::size_t count = d->objectArray.size() + reserve;
+    d->objectArray.reserve(count);
+    d->objectMap.reserve(count);
+    d->objectIdMap.reserve(count);
+    d->bulkObjects.reserve(reserve);
+    d->bulkNames.reserve(count);
+    d->bulkLabels.reserve(count);
+    d->bulkLabelCount.reserve(count);
+    for (auto &v : d->objectMap)
+        d->bulkNames.addName(v.first);
+    for (auto obj : d->objectArray)
+        d->addBulkLabel(obj->Label.getStrValue());
+
+    d->connectBulkRelabel = signalRelabelObject.connect([this](const DocumentObject &obj) {
+        d->removeBulkLabel(obj.getOldLabel());
+        d->addBulkLabel(obj.Label.getStrValue());
+    });
+}
+
+void Document::endBulkInsert()
+{
+    if (d->bulkInsert <= 0 || --d->bulkInsert)
+        return;
+
+    d->connectBulkRelabel.disconnect();
+    d->bulkNames.clear();
+    d->bulkLabels.clear();
+    d->bulkLabelCount.clear();
+    std::vector<DocumentObject*> objs;
+    objs.swap(d->bulkObjects);
+    d->StatusBits.set((size_t)BulkInsert, false);
+
+    FC_LOG("bulk insert of " << objs.size() << " objects into " << getName());
+    if (objs.empty())
+        return;
+
+    signalNewObjects(objs);
+    if (d->activeObject)
+        signalActivatedObject(*d->activeObject);
+}
+
+bool Document::isBulkInserting() const
+{
+    return d->bulkInsert > 0;
+}
+
+bool Document::hasBulkLabel(const std::string &label, const DocumentObject *exclude) const
+{
+    auto it = d->bulkLabelCount.find(label);
+    if (it == d->bulkLabelCount.end())
+        return false;
+    int count = it->second;
+    if (exclude && exclude->Label.getStrValue() == label)
+        --count;
+    return count > 0;
+}
+
+std::string Document::getUniqueBulkLabel(const std::string &prefix, int digits) const
+{
+    return d->bulkLabels.getUniqueName(prefix, digits);
+}
+
 std::string Document::getStandardObjectName(const char *Name, int d) const
 {
     std::vector<App::DocumentObject*> mm = getObjects();
@@ -4695,3 +4846,25 @@ bool Document::mustExecute() const
             return true;
     return false;
 }
+
+// ---------------------------------------------------------------------------
+
+DocumentBulkInsert::DocumentBulkInsert(Document *doc, std::size_t reserve)
+    :doc(doc)
+{
+    if(doc)
+        doc->beginBulkInsert(reserve);
+}
+
+DocumentBulkInsert::~DocumentBulkInsert()
+{
+    if(!doc)
+        return;
+    try {
+        doc->endBulkInsert();
+    } catch (Base::Exception &e) {
+        e.ReportException();
+    } catch (...) {
+        FC_ERR("Unknown exception on ending bulk insertion into " << doc->getName());
+    }
+}
@@ -52,6 +52,7 @@ namespace App
     class DocumentPy; // the python document class
     class Application;
     class Transaction;
+    class RecomputeProfiler;
 }
 
 namespace App
@@ -74,6 +75,7 @@ public:
         PartialDoc = 7,
         AllowPartialRecompute = 8, // allow recomputing editing object if SkipRecompute is set
         TempDoc = 9, // Mark as temporary document without prompt for save
+        BulkInsert = 10, // Objects are being added inside beginBulkInsert()/endBulkInsert()
     };
 
     /** @name Properties */
@@ -125,6 +127,8 @@ public:
     boost::signals2::signal<void (const App::Document&, const App::Property&)> signalChanged;
     /// signal on new Object
     boost::signals2::signal<void (const App::DocumentObject&)> signalNewObject;
+    /// signal once for all objects added inside a bulk insertion, see beginBulkInsert()
+    boost::signals2::signal<void (const std::vector<App::DocumentObject*>&)> signalNewObjects;
     //boost::signals2::signal<void (const App::DocumentObject&)>     m_sig;
     /// signal on deleted Object
     boost::signals2::signal<void (const App::DocumentObject&)> signalDeletedObject;
@@ -271,6 +275,30 @@ public:
      */
     void addObject(DocumentObject*, const char* pObjectName=0);
 
+    /** Start adding a large number of objects, e.g. by an importer
+     *
+     * @param reserve: the expected number of new objects
+     *
+     * Until the matching endBulkInsert() the unique object names and labels
+     * are looked up in tables kept up to date while inserting, instead of
+     * scanning all objects for each new one. signalActivatedObject is only
+     * sent for the last active object, and listeners of signalNewObject can
+     * test the BulkInsert status to postpone work to signalNewObjects, which
+     * is sent once at the end with all the objects added in between.
+     *
+     * Calls can be nested, the insertion ends with the outermost call of
+     * endBulkInsert(). Use DocumentBulkInsert to make sure the calls match.
+     */
+    void beginBulkInsert(std::size_t reserve=0);
+    /// End the insertion started by beginBulkInsert()
+    void endBulkInsert();
+    /// Check if beginBulkInsert() is active
+    bool isBulkInserting() const;
+    /// \internal check for another object with the given label while bulk inserting
+    bool hasBulkLabel(const std::string &label, const DocumentObject *exclude) const;
+    /// \internal get a unique label with the given prefix while bulk inserting
+    std::string getUniqueBulkLabel(const std::string &prefix, int digits) const;
+
 
     /** Copy objects from another document to this document
      *
@@ -348,6 +376,8 @@ public:
     bool recomputeFeature(DocumentObject* Feat,bool recursive=false);
     /// get the text of the error of a specified object
     const char* getErrorDescription(const App::DocumentObject*) const;
+    /// records the time each object takes to recompute if enabled
+    RecomputeProfiler &getRecomputeProfiler() const;
     /// return the status bits
     bool testStatus(Status pos) const;
     /// set the status bits
@@ -574,6 +604,16 @@ private:
     std::string myName;
 };
 
+/// Helper class to bracket object insertion with Document::beginBulkInsert()/endBulkInsert()
+class AppExport DocumentBulkInsert {
+public:
+    DocumentBulkInsert(Document *doc, std::size_t reserve=0);
+    ~DocumentBulkInsert();
+
+private:
+    Document *doc;
+};
+
 template<typename T>
 inline std::vector<T*> Document::getObjectsOfType() const
 {
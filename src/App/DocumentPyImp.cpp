@@ -33,6 +33,7 @@
 #include "DocumentObjectPy.h"
 #include "MergeDocuments.h"
 #include "PropertyLinks.h"
+#include "RecomputeProfiler.h"
 
 // inclusion of the generated files (generated By DocumentPy.xml)
 #include "DocumentPy.h"
@@ -846,6 +847,78 @@ PyObject *DocumentPy::getDependentDocuments(PyObject *args) {
     } PY_CATCH;
 }
 
+PyObject *DocumentPy::startRecomputeProfile(PyObject *args)
+{
+    int capacity = static_cast<int>(RecomputeProfiler::DefaultCapacity);
+    if (!PyArg_ParseTuple(args, "|i", &capacity))
+        return 0;
+    if (capacity <= 0) {
+        PyErr_SetString(PyExc_ValueError, "capacity must be positive");
+        return 0;
+    }
+    getDocumentPtr()->getRecomputeProfiler().start(capacity);
+    Py_Return;
+}
+
+PyObject *DocumentPy::stopRecomputeProfile(PyObject *args)
+{
+    if (!PyArg_ParseTuple(args, ""))
+        return 0;
+    getDocumentPtr()->getRecomputeProfiler().stop();
+    Py_Return;
+}
+
+PyObject *DocumentPy::clearRecomputeProfile(PyObject *args)
+{
+    if (!PyArg_ParseTuple(args, ""))
+        return 0;
+    getDocumentPtr()->getRecomputeProfiler().clear();
+    Py_Return;
+}
+
+PyObject *DocumentPy::getRecomputeProfile(PyObject *args)
+{
+    if (!PyArg_ParseTuple(args, ""))
+        return 0;
+    PY_TRY {
+        Py::List ret;
+        for (const auto &rec : getDocumentPtr()->getRecomputeProfiler().getRecords()) {
+            Py::Dict dict;
+            dict.setItem("Object", Py::String(rec.object));
+            dict.setItem("Label", Py::String(rec.label));
+            dict.setItem("Type", Py::String(rec.type));
+            dict.setItem("Cause", Py::String(rec.cause));
+            dict.setItem("Start", Py::Float(rec.start / 1.0e6));
+            dict.setItem("Duration", Py::Float(rec.duration / 1.0e6));
+            dict.setItem("MemoryDelta", Py::Long(rec.memoryDelta));
+            dict.setItem("TouchCount", Py::Int(rec.touchCount));
+            dict.setItem("Depth", Py::Int(rec.depth));
+            dict.setItem("Recompute", Py::Long(rec.recompute));
+            dict.setItem("Failed", Py::Boolean(rec.failed));
+            ret.append(dict);
+        }
+        return Py::new_reference_to(ret);
+    } PY_CATCH;
+}
+
+PyObject *DocumentPy::exportRecomputeProfile(PyObject *args)
+{
+    char *fileName;
+    if (!PyArg_ParseTuple(args, "et", "utf-8", &fileName))
+        return 0;
+    std::string utf8Name = fileName;
+    PyMem_Free(fileName);
+
+    PY_TRY {
+        Base::FileInfo fi(utf8Name);
+        Base::ofstream str(fi, std::ios::out | std::ios::trunc);
+        if (!str)
+            throw Base::FileException("Cannot open file", fi);
+        getDocumentPtr()->getRecomputeProfiler().exportTrace(str, getDocumentPtr()->getName());
+        Py_Return;
+    } PY_CATCH;
+}
+
 Py::Boolean DocumentPy::getRestoring(void) const
 {
     return Py::Boolean(getDocumentPtr()->testStatus(Document::Status::Restoring));
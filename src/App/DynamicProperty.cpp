@@ -31,6 +31,7 @@
 #include "PropertyContainer.h"
 #include "Application.h"
 #include "ExtensionContainer.h"
+#include "Expression.h"
 #include <Base/Reader.h>
 #include <Base/Writer.h>
 #include <Base/Console.h>
@@ -176,6 +177,7 @@ Property* DynamicProperty::addDynamicProperty(PropertyContainer &pc, const char*
     pcProperty->syncType(attr);
     pcProperty->StatusBits.set((size_t)Property::PropDynamic);
 
+    Expression::invalidateBindings();
     GetApplication().signalAppendDynamicProperty(*pcProperty);
 
     return pcProperty;
@@ -215,6 +217,7 @@ bool DynamicProperty::removeDynamicProperty(const char* name)
             throw Base::RuntimeError("property is not dynamic");
         Property *prop = it->property;
         GetApplication().signalRemoveDynamicProperty(*prop);
+        Expression::invalidateBindings();
         Property::destroy(prop);
         index.erase(it);
         return true;
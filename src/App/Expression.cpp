@@ -49,10 +49,12 @@
 #include <string>
 #include <sstream>
 #include <math.h>
+#include <cmath>
 #include <stdio.h>
 #include <stack>
 #include <deque>
 #include <algorithm>
+#include <atomic>
 #include "ExpressionParser.h"
 #include <Base/Unit.h>
 #include <App/PropertyUnits.h>
@@ -565,6 +567,17 @@ Py::Object pyFromQuantity(const Quantity &quantity) {
     }
 }
 
+// Native counterpart of pyFromQuantity()
+static Expression::NativeValue nativeFromQuantity(const Quantity &quantity) {
+    if(!quantity.getUnit().isEmpty())
+        return Expression::NativeValue(Expression::NativeValue::TypeQuantity, quantity);
+    long l;
+    int i;
+    if(essentiallyInteger(quantity.getValue(),l,i))
+        return Expression::NativeValue(Expression::NativeValue::TypeInt, quantity);
+    return Expression::NativeValue(Expression::NativeValue::TypeFloat, quantity);
+}
+
 Quantity anyToQuantity(const App::any &value, const char *msg) {
     if (is_type(value,typeid(Quantity))) {
         return cast<Quantity>(value);
@@ -1151,6 +1164,11 @@ ExpressionPtr Expression::replaceObject(const DocumentObject *parent,
 }
 
 App::any Expression::getValueAsAny() const {
+    NativeValue value;
+    resolveBindings();
+    if(getNativeValue(value))
+        return value.toAny();
+
     Base::PyGILStateLocker lock;
     return pyObjectToAny(getPyValue());
 }
@@ -1169,6 +1187,50 @@ Py::Object Expression::getPyValue() const {
     return Py::Object();
 }
 
+// Incremented whenever an object identifier may resolve to a different
+// property. Expressions compare it to the revision their bindings were
+// resolved at.
+static std::atomic<unsigned long> _BindingRevision(1);
+
+void Expression::invalidateBindings() {
+    ++_BindingRevision;
+}
+
+bool Expression::getNativeValue(NativeValue &value) const {
+    // Components access attributes or items of Python objects
+    if(components.size())
+        return false;
+    return _getNativeValue(value);
+}
+
+void Expression::resolveBindings() const {
+    if(components.empty())
+        _resolveBindings();
+}
+
+Expression *Expression::NativeValue::toExpression(const DocumentObject *owner) const {
+    // Same as expressionFromPy()
+    if(type == TypeBool) {
+        if(isTrue())
+            return new ConstantExpression(owner,"True",Quantity(1.0));
+        else
+            return new ConstantExpression(owner,"False",Quantity(0.0));
+    }
+    return new NumberExpression(owner,quantity);
+}
+
+App::any Expression::NativeValue::toAny() const {
+    // Same as pyObjectToAny(), which also converts bool to long
+    switch(type) {
+    case TypeQuantity:
+        return App::any(quantity);
+    case TypeFloat:
+        return App::any(quantity.getValue());
+    default:
+        return App::any(static_cast<long>(quantity.getValue()));
+    }
+}
+
 void Expression::addComponent(Component *component) {
     assert(component);
     components.push_back(component);
@@ -1182,6 +1244,11 @@ void Expression::visit(ExpressionVisitor &v) {
 }
 
 Expression* Expression::eval() const {
+    NativeValue value;
+    resolveBindings();
+    if(getNativeValue(value))
+        return value.toExpression(owner);
+
     Base::PyGILStateLocker lock;
     return expressionFromPy(owner,getPyValue());
 }
@@ -1314,6 +1381,11 @@ Py::Object UnitExpression::_getPyValue() const {
     return Py::Object(cache);
 }
 
+bool UnitExpression::_getNativeValue(NativeValue &value) const {
+    value = nativeFromQuantity(quantity);
+    return true;
+}
+
 //
 // NumberExpression class
 //
@@ -1553,6 +1625,183 @@ Py::Object OperatorExpression::_getPyValue() const {
     return calc(this,op,left,right,false);
 }
 
+// 2^53, a double represents all integers of smaller magnitude exactly. An
+// integer result of this or larger magnitude may have been rounded, e.g.
+// 2^53+1, so such results are left to Python.
+static const double _MaxExactInteger = 9007199254740992.0;
+
+// Python modulo, which takes the sign of the divisor
+static inline double pyModulo(double a, double b) {
+    double res = std::fmod(a,b);
+    if(res == 0.0)
+        res = std::copysign(0.0,b);
+    else if((b < 0.0) != (res < 0.0))
+        res += b;
+    return res;
+}
+
+/**
+  * Native counterpart of calc(). Returns false for any operation whose result
+  * differs from Python or that would raise an exception in Python, so that
+  * the caller can fall back to calc() for the exact same result or error.
+  */
+
+static bool calcNative(int op, const Expression::NativeValue &l,
+        const Expression::NativeValue &r, Expression::NativeValue &res)
+{
+    typedef Expression::NativeValue NativeValue;
+
+    switch(op) {
+    case OperatorExpression::EQ:
+    case OperatorExpression::NEQ:
+    case OperatorExpression::LT:
+    case OperatorExpression::GT:
+    case OperatorExpression::LTE:
+    case OperatorExpression::GTE: {
+        double a = l.getValue();
+        double b = r.getValue();
+        if(l.type == NativeValue::TypeQuantity && r.type == NativeValue::TypeQuantity
+                && l.quantity.getUnit() != r.quantity.getUnit())
+        {
+            // Quantities of different units are never equal and cannot be ordered
+            if(op != OperatorExpression::EQ && op != OperatorExpression::NEQ)
+                return false;
+            a = 0.0;
+            b = 1.0;
+        }
+        bool v;
+        switch(op) {
+        case OperatorExpression::EQ: v = a == b; break;
+        case OperatorExpression::NEQ: v = a != b; break;
+        case OperatorExpression::LT: v = a < b; break;
+        case OperatorExpression::GT: v = a > b; break;
+        case OperatorExpression::LTE: v = a <= b; break;
+        default: v = a >= b; break;
+        }
+        res = NativeValue(NativeValue::TypeBool, Quantity(v?1.0:0.0));
+        return true;
+    }
+    default:
+        break;
+    }
+
+    if(l.type == NativeValue::TypeQuantity || r.type == NativeValue::TypeQuantity) {
+        if(l.type == NativeValue::TypeBool || r.type == NativeValue::TypeBool)
+            return false;
+        const Quantity &a = l.quantity;
+        const Quantity &b = r.quantity;
+        switch(op) {
+        case OperatorExpression::ADD:
+            if(a.getUnit() != b.getUnit())
+                return false;
+            res = NativeValue(NativeValue::TypeQuantity, a + b);
+            return true;
+        case OperatorExpression::SUB:
+            if(a.getUnit() != b.getUnit())
+                return false;
+            res = NativeValue(NativeValue::TypeQuantity, a - b);
+            return true;
+        case OperatorExpression::MUL:
+        case OperatorExpression::UNIT:
+            res = NativeValue(NativeValue::TypeQuantity, a * b);
+            return true;
+        case OperatorExpression::DIV:
+            res = NativeValue(NativeValue::TypeQuantity, a / b);
+            return true;
+        case OperatorExpression::MOD:
+            if(l.type != NativeValue::TypeQuantity || b.getValue() == 0.0)
+                return false;
+            res = NativeValue(NativeValue::TypeQuantity,
+                    Quantity(pyModulo(a.getValue(),b.getValue()),a.getUnit()));
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // Plain numbers, where bool behaves like int
+    double a = l.getValue();
+    double b = r.getValue();
+    bool isInt = l.type != NativeValue::TypeFloat && r.type != NativeValue::TypeFloat;
+    double v;
+    switch(op) {
+    case OperatorExpression::ADD:
+        v = a + b;
+        break;
+    case OperatorExpression::SUB:
+        v = a - b;
+        break;
+    case OperatorExpression::MUL:
+    case OperatorExpression::UNIT:
+        v = a * b;
+        break;
+    case OperatorExpression::DIV:
+        if(b == 0.0)
+            return false;
+        res = NativeValue(NativeValue::TypeFloat, Quantity(a / b));
+        return true;
+    case OperatorExpression::MOD:
+        if(b == 0.0)
+            return false;
+        v = pyModulo(a,b);
+        break;
+    case OperatorExpression::POW:
+        if(a == 0.0 && b < 0.0)
+            return false;
+        if(!isInt && a < 0.0 && b != std::floor(b))
+            return false;
+        v = std::pow(a,b);
+        if(!isInt || b < 0.0) {
+            if(!std::isfinite(v))
+                return false;
+            res = NativeValue(NativeValue::TypeFloat, Quantity(v));
+            return true;
+        }
+        break;
+    default:
+        return false;
+    }
+
+    if(!isInt) {
+        res = NativeValue(NativeValue::TypeFloat, Quantity(v));
+        return true;
+    }
+    if(std::fabs(v) >= _MaxExactInteger)
+        return false;
+    res = NativeValue(NativeValue::TypeInt, Quantity(v));
+    return true;
+}
+
+bool OperatorExpression::_getNativeValue(NativeValue &value) const {
+    NativeValue l;
+    if(!left->getNativeValue(l))
+        return false;
+
+    switch(op) {
+    case POS:
+    case NEG:
+        if(l.type == NativeValue::TypeBool)
+            l.type = NativeValue::TypeInt;
+        if(op == NEG)
+            l.quantity = -l.quantity;
+        value = l;
+        return true;
+    default:
+        break;
+    }
+
+    NativeValue r;
+    if(!right->getNativeValue(r))
+        return false;
+    return calcNative(op,l,r,value);
+}
+
+void OperatorExpression::_resolveBindings() const {
+    left->resolveBindings();
+    if(right)
+        right->resolveBindings();
+}
+
 /**
   * Simplify the expression. For OperatorExpressions, we return a NumberExpression if
   * both the left and right side can be simplified to NumberExpressions. In this case
@@ -1925,57 +2174,59 @@ public:
     }
 };
 
-Py::Object FunctionExpression::evalAggregate(
-        const Expression *owner, int f, const std::vector<Expression*> &args)
+static Collector *createCollector(int f)
 {
-    std::unique_ptr<Collector> c;
-
     switch (f) {
-    case SUM:
-        c.reset(new SumCollector);
-        break;
-    case AVERAGE:
-        c.reset(new AverageCollector);
-        break;
-    case STDDEV:
-        c.reset(new StdDevCollector);
-        break;
-    case COUNT:
-        c.reset(new CountCollector);
-        break;
-    case MIN:
-        c.reset(new MinCollector);
-        break;
-    case MAX:
-        c.reset(new MaxCollector);
-        break;
+    case FunctionExpression::SUM:
+        return new SumCollector;
+    case FunctionExpression::AVERAGE:
+        return new AverageCollector;
+    case FunctionExpression::STDDEV:
+        return new StdDevCollector;
+    case FunctionExpression::COUNT:
+        return new CountCollector;
+    case FunctionExpression::MIN:
+        return new MinCollector;
+    case FunctionExpression::MAX:
+        return new MaxCollector;
     default:
         assert(false);
     }
+    return 0;
+}
 
-    for (auto &arg : args) {
-        if (arg->isDerivedFrom(RangeExpression::getClassTypeId())) {
-            Range range(static_cast<const RangeExpression&>(*arg).getRange());
+static void collectRange(Collector &c, const Expression *owner, const RangeExpression &expr)
+{
+    Range range(expr.getRange());
 
-            do {
-                Property * p = owner->getOwner()->getPropertyByName(range.address().c_str());
-                PropertyQuantity * qp;
-                PropertyFloat * fp;
-                PropertyInteger * ip;
+    do {
+        Property * p = owner->getOwner()->getPropertyByName(range.address().c_str());
+        PropertyQuantity * qp;
+        PropertyFloat * fp;
+        PropertyInteger * ip;
+
+        if (!p)
+            continue;
+
+        if ((qp = freecad_dynamic_cast<PropertyQuantity>(p)) != 0)
+            c.collect(qp->getQuantityValue());
+        else if ((fp = freecad_dynamic_cast<PropertyFloat>(p)) != 0)
+            c.collect(Quantity(fp->getValue()));
+        else if ((ip = freecad_dynamic_cast<PropertyInteger>(p)) != 0)
+            c.collect(Quantity(ip->getValue()));
+        else
+            _EXPR_THROW("Invalid property type for aggregate.", owner);
+    } while (range.next());
+}
 
-                if (!p)
-                    continue;
+Py::Object FunctionExpression::evalAggregate(
+        const Expression *owner, int f, const std::vector<Expression*> &args)
+{
+    std::unique_ptr<Collector> c(createCollector(f));
 
-                if ((qp = freecad_dynamic_cast<PropertyQuantity>(p)) != 0)
-                    c->collect(qp->getQuantityValue());
-                else if ((fp = freecad_dynamic_cast<PropertyFloat>(p)) != 0)
-                    c->collect(Quantity(fp->getValue()));
-                else if ((ip = freecad_dynamic_cast<PropertyInteger>(p)) != 0)
-                    c->collect(Quantity(ip->getValue()));
-                else
-                    _EXPR_THROW("Invalid property type for aggregate.", owner);
-            } while (range.next());
-        }
+    for (auto &arg : args) {
+        if (arg->isDerivedFrom(RangeExpression::getClassTypeId()))
+            collectRange(*c, owner, static_cast<const RangeExpression&>(*arg));
         else {
             Quantity q;
             if(pyToQuantity(q,arg->getPyValue()))
@@ -2092,21 +2343,27 @@ Py::Object FunctionExpression::evaluate(const Expression *expr, int f, const std
         return res;
     }
 
-    Py::Object e1 = args[0]->getPyValue();
-    Quantity v1 = pyToQuantity(e1,expr,"Invalid first argument.");
-    Py::Object e2;
+    Quantity v1 = pyToQuantity(args[0]->getPyValue(),expr,"Invalid first argument.");
     Quantity v2;
-    if(args.size()>1) {
-        e2 = args[1]->getPyValue();
-        v2 = pyToQuantity(e2,expr,"Invalid second argument.");
-    }
-    Py::Object e3;
+    if(args.size()>1)
+        v2 = pyToQuantity(args[1]->getPyValue(),expr,"Invalid second argument.");
     Quantity v3;
-    if(args.size()>2) {
-        e3 = args[2]->getPyValue();
-        v3 = pyToQuantity(e3,expr,"Invalid third argument.");
-    }
+    if(args.size()>2)
+        v3 = pyToQuantity(args[2]->getPyValue(),expr,"Invalid third argument.");
+
+    return Py::asObject(new QuantityPy(new Quantity(evalQuantity(expr,f,args.size(),v1,v2,v3))));
+}
 
+/**
+  * Evaluate one of the mathematical functions on already evaluated arguments.
+  *
+  * @param argc Number of arguments given to the function, only the first
+  * three of them are used.
+  */
+
+Quantity FunctionExpression::evalQuantity(const Expression *expr, int f, std::size_t argc,
+        const Quantity &v1, const Quantity &v2, const Quantity &v3)
+{
     double output;
     Unit unit;
     double scaler = 1;
@@ -2176,7 +2433,7 @@ Py::Object FunctionExpression::evaluate(const Expression *expr, int f, const std
         break;
     }
     case ATAN2:
-        if (e2.isNone())
+        if (argc < 2)
             _EXPR_THROW("Invalid second argument.",expr);
 
         if (v1.getUnit() != v2.getUnit())
@@ -2185,12 +2442,12 @@ Py::Object FunctionExpression::evaluate(const Expression *expr, int f, const std
         scaler = 180.0 / M_PI;
         break;
     case MOD:
-        if (e2.isNone())
+        if (argc < 2)
             _EXPR_THROW("Invalid second argument.",expr);
         unit = v1.getUnit() / v2.getUnit();
         break;
     case POW: {
-        if (e2.isNone())
+        if (argc < 2)
             _EXPR_THROW("Invalid second argument.",expr);
 
         if (!v2.getUnit().isEmpty())
@@ -2208,14 +2465,12 @@ Py::Object FunctionExpression::evaluate(const Expression *expr, int f, const std
     }
     case HYPOT:
     case CATH:
-        if (e2.isNone())
+        if (argc < 2)
             _EXPR_THROW("Invalid second argument.",expr);
         if (v1.getUnit() != v2.getUnit())
             _EXPR_THROW("Units must be equal.",expr);
 
-        if (args.size() > 2) {
-            if (e3.isNone())
-                _EXPR_THROW("Invalid second argument.",expr);
+        if (argc > 2) {
             if (v2.getUnit() != v3.getUnit())
                 _EXPR_THROW("Units must be equal.",expr);
         }
@@ -2282,11 +2537,11 @@ Py::Object FunctionExpression::evaluate(const Expression *expr, int f, const std
         break;
     }
     case HYPOT: {
-        output = sqrt(pow(v1.getValue(), 2) + pow(v2.getValue(), 2) + (!e3.isNone() ? pow(v3.getValue(), 2) : 0));
+        output = sqrt(pow(v1.getValue(), 2) + pow(v2.getValue(), 2) + (argc > 2 ? pow(v3.getValue(), 2) : 0));
         break;
     }
     case CATH: {
-        output = sqrt(pow(v1.getValue(), 2) - pow(v2.getValue(), 2) - (!e3.isNone() ? pow(v3.getValue(), 2) : 0));
+        output = sqrt(pow(v1.getValue(), 2) - pow(v2.getValue(), 2) - (argc > 2 ? pow(v3.getValue(), 2) : 0));
         break;
     }
     case ROUND:
@@ -2305,13 +2560,53 @@ Py::Object FunctionExpression::evaluate(const Expression *expr, int f, const std
         _EXPR_THROW("Unknown function: " << f,expr);
     }
 
-    return Py::asObject(new QuantityPy(new Quantity(scaler * output, unit)));
+    return Quantity(scaler * output, unit);
 }
 
 Py::Object FunctionExpression::_getPyValue() const {
     return evaluate(this,f,args);
 }
 
+bool FunctionExpression::_getNativeValue(NativeValue &value) const {
+    if(!owner)
+        return false;
+
+    if (f > AGGREGATES) {
+        std::unique_ptr<Collector> c(createCollector(f));
+        for (auto &arg : args) {
+            if (arg->isDerivedFrom(RangeExpression::getClassTypeId()))
+                collectRange(*c, this, static_cast<const RangeExpression&>(*arg));
+            else {
+                NativeValue v;
+                if(!arg->getNativeValue(v))
+                    return false;
+                c->collect(v.quantity);
+            }
+        }
+        value = nativeFromQuantity(c->getQuantity());
+        return true;
+    }
+
+    // Only the mathematical functions are evaluated natively, the others
+    // return Python objects.
+    if (f <= NONE || f >= LIST || args.empty())
+        return false;
+
+    NativeValue v[3];
+    for (std::size_t i=0; i<args.size() && i<3; ++i) {
+        if(!args[i]->getNativeValue(v[i]))
+            return false;
+    }
+    value = NativeValue(NativeValue::TypeQuantity,
+            evalQuantity(this,f,args.size(),v[0].quantity,v[1].quantity,v[2].quantity));
+    return true;
+}
+
+void FunctionExpression::_resolveBindings() const {
+    for(auto &arg : args)
+        arg->resolveBindings();
+}
+
 /**
   * Try to simplify the expression, i.e calculate all constant expressions.
   *
@@ -2565,6 +2860,73 @@ Py::Object VariableExpression::_getPyValue() const {
     return var.getPyValue(true);
 }
 
+/**
+  * Get the property this expression refers to, if it refers to the value of a
+  * property as a whole. Only a binding resolved by resolveBindings() since the
+  * last Expression::invalidateBindings() is returned, the property is never
+  * looked up here.
+  *
+  * @returns The Property object or null if the variable requires Python to be
+  * evaluated or has not been resolved.
+  */
+
+const Property * VariableExpression::getBoundProperty() const
+{
+    if (boundRevision != _BindingRevision)
+        return 0;
+    return boundProperty;
+}
+
+void VariableExpression::_resolveBindings() const
+{
+    unsigned long revision = _BindingRevision;
+    if (boundRevision == revision)
+        return;
+    boundProperty = 0;
+    boundRevision = revision;
+
+    // Sub-objects and attributes of the property are resolved through Python
+    if (!var.getSubObjectName().empty() || var.numSubComponents() != 1)
+        return;
+    try {
+        int ptype;
+        const Property * prop = var.getProperty(&ptype);
+        if (prop && !ptype)
+            boundProperty = prop;
+    }
+    catch (Base::Exception &) {
+        // Leave reporting the error to the Python evaluation
+    }
+}
+
+bool VariableExpression::_getNativeValue(NativeValue &value) const {
+    const Property * prop = getBoundProperty();
+    if (!prop)
+        return false;
+
+    // The types must match the Python objects returned by the properties
+    if (prop->isDerivedFrom(PropertyQuantity::getClassTypeId()))
+        value = NativeValue(NativeValue::TypeQuantity,
+                static_cast<const PropertyQuantity*>(prop)->getQuantityValue());
+    else if (prop->isDerivedFrom(PropertyFloat::getClassTypeId()))
+        value = NativeValue(NativeValue::TypeFloat,
+                Quantity(static_cast<const PropertyFloat*>(prop)->getValue()));
+    else if (prop->isDerivedFrom(PropertyInteger::getClassTypeId()))
+        value = NativeValue(NativeValue::TypeInt,
+                Quantity(static_cast<const PropertyInteger*>(prop)->getValue()));
+    else if (prop->isDerivedFrom(PropertyBool::getClassTypeId()))
+        value = NativeValue(NativeValue::TypeBool,
+                Quantity(static_cast<const PropertyBool*>(prop)->getValue() ? 1.0 : 0.0));
+    else
+        return false;
+    return true;
+}
+
+void VariableExpression::_visit(ExpressionVisitor &) {
+    // Visitors may modify the path
+    boundRevision = 0;
+}
+
 void VariableExpression::_toString(std::ostream &ss, bool persistent,int) const {
     if(persistent)
         ss << var.toPersistentString();
@@ -2713,6 +3075,7 @@ void VariableExpression::_offsetCells(int rowOffset, int colOffset, ExpressionVi
 void VariableExpression::setPath(const ObjectIdentifier &path)
 {
      var = path;
+     boundRevision = 0;
 }
 
 //
@@ -2839,6 +3202,22 @@ Py::Object ConditionalExpression::_getPyValue() const {
         return falseExpr->getPyValue();
 }
 
+bool ConditionalExpression::_getNativeValue(NativeValue &value) const {
+    NativeValue cond;
+    if(!condition->getNativeValue(cond))
+        return false;
+    if(cond.isTrue())
+        return trueExpr->getNativeValue(value);
+    else
+        return falseExpr->getNativeValue(value);
+}
+
+void ConditionalExpression::_resolveBindings() const {
+    condition->resolveBindings();
+    trueExpr->resolveBindings();
+    falseExpr->resolveBindings();
+}
+
 Expression *ConditionalExpression::simplify() const
 {
     std::unique_ptr<Expression> e(condition->simplify());
@@ -2925,6 +3304,18 @@ Py::Object ConstantExpression::_getPyValue() const {
     return Py::Object(cache);
 }
 
+bool ConstantExpression::_getNativeValue(NativeValue &value) const {
+    if(strcmp(name,"None")==0)
+        return false;
+    else if(strcmp(name,"True")==0)
+        value = NativeValue(NativeValue::TypeBool, Quantity(1.0));
+    else if(strcmp(name, "False")==0)
+        value = NativeValue(NativeValue::TypeBool, Quantity(0.0));
+    else
+        return NumberExpression::_getNativeValue(value);
+    return true;
+}
+
 bool ConstantExpression::isNumber() const {
     return strcmp(name,"None")
         && strcmp(name,"True")
@@ -180,6 +180,37 @@ public:
 
     Py::Object getPyValue() const;
 
+    struct NativeValue;
+
+    /** Evaluate the expression without going through Python
+     *
+     * @param value: returns the value of the expression
+     *
+     * @return Returns false if the expression (or one of its sub-expressions)
+     * requires Python to be evaluated, in which case getPyValue() must be used
+     * instead.
+     *
+     * Only property bindings already resolved by resolveBindings() are used,
+     * so that the function never enters Python or reports errors itself and can
+     * be called from any thread.
+     */
+    bool getNativeValue(NativeValue &value) const;
+
+    /** Resolve the property bindings used by getNativeValue()
+     *
+     * Must be called from the main thread, resolving an object identifier may
+     * require Python.
+     */
+    void resolveBindings() const;
+
+    /** Invalidate the property bindings cached by all expressions
+     *
+     * Must be called whenever an object identifier may resolve to a different
+     * property, i.e. when objects or dynamic properties are added, removed or
+     * relabeled.
+     */
+    static void invalidateBindings();
+
     bool isSame(const Expression &other) const;
 
     friend ExpressionVisitor;
@@ -208,6 +239,8 @@ protected:
     virtual void _moveCells(const CellAddress &, int, int, ExpressionVisitor &) {}
     virtual void _offsetCells(int, int, ExpressionVisitor &) {}
     virtual Py::Object _getPyValue() const = 0;
+    virtual bool _getNativeValue(NativeValue &) const {return false;}
+    virtual void _resolveBindings() const {}
     virtual void _visit(ExpressionVisitor &) {}
 
 protected:
@@ -61,6 +61,34 @@ struct AppExport Expression::Component {
     void del(const Expression *owner, Py::Object &pyobj) const;
 };
 
+/**
+  * Value of an expression evaluated natively, see Expression::getNativeValue().
+  *
+  * The type mirrors the Python object the expression would evaluate to, so
+  * that both evaluation paths give the same result.
+  */
+struct AppExport Expression::NativeValue {
+    enum Type {
+        TypeInt,        /**< Python int, the quantity holds an integral value without unit */
+        TypeFloat,      /**< Python float, the quantity has no unit */
+        TypeQuantity,   /**< Base.Quantity */
+        TypeBool,       /**< Python bool, the quantity holds either 0 or 1 */
+    };
+
+    NativeValue(Type t = TypeInt, const Base::Quantity &q = Base::Quantity())
+        : type(t), quantity(q)
+    {}
+
+    double getValue() const { return quantity.getValue(); }
+    bool isTrue() const { return quantity.getValue() != 0.0; }
+
+    Expression *toExpression(const App::DocumentObject *owner) const;
+    App::any toAny() const;
+
+    Type type;
+    Base::Quantity quantity;
+};
+
 ////////////////////////////////////////////////////////////////////////////////////
 
 /**
@@ -95,6 +123,7 @@ protected:
     virtual Expression * _copy() const override;
     virtual void _toString(std::ostream &ss, bool persistent, int indent) const override;
     virtual Py::Object _getPyValue() const override;
+    virtual bool _getNativeValue(NativeValue &value) const override;
 
 protected:
     mutable PyObject *cache = 0;
@@ -137,6 +166,7 @@ public:
 
 protected:
     virtual Py::Object _getPyValue() const override;
+    virtual bool _getNativeValue(NativeValue &value) const override;
     virtual void _toString(std::ostream &ss, bool persistent, int indent) const override;
     virtual Expression* _copy() const override;
 
@@ -191,6 +221,10 @@ protected:
 
     virtual Py::Object _getPyValue() const override;
 
+    virtual bool _getNativeValue(NativeValue &value) const override;
+
+    virtual void _resolveBindings() const override;
+
     virtual void _toString(std::ostream &ss, bool persistent, int indent) const override;
 
     virtual void _visit(ExpressionVisitor & v) override;
@@ -224,6 +258,8 @@ protected:
     virtual void _visit(ExpressionVisitor & v) override;
     virtual void _toString(std::ostream &ss, bool persistent, int indent) const override;
     virtual Py::Object _getPyValue() const override;
+    virtual bool _getNativeValue(NativeValue &value) const override;
+    virtual void _resolveBindings() const override;
 
 protected:
 
@@ -300,7 +336,11 @@ public:
 
 protected:
     static Py::Object evalAggregate(const Expression *owner, int type, const std::vector<Expression*> &args);
+    static Base::Quantity evalQuantity(const Expression *owner, int type, std::size_t argc,
+            const Base::Quantity &v1, const Base::Quantity &v2, const Base::Quantity &v3);
     virtual Py::Object _getPyValue() const override;
+    virtual bool _getNativeValue(NativeValue &value) const override;
+    virtual void _resolveBindings() const override;
     virtual Expression * _copy() const override;
     virtual void _visit(ExpressionVisitor & v) override;
     virtual void _toString(std::ostream &ss, bool persistent, int indent) const override;
@@ -342,6 +382,9 @@ public:
 protected:
     virtual Expression * _copy() const override;
     virtual Py::Object _getPyValue() const override;
+    virtual bool _getNativeValue(NativeValue &value) const override;
+    virtual void _resolveBindings() const override;
+    virtual void _visit(ExpressionVisitor & v) override;
     virtual void _toString(std::ostream &ss, bool persistent, int indent) const override;
     virtual bool _isIndexable() const override;
     virtual void _getDeps(ExpressionDeps &) const override;
@@ -360,9 +403,15 @@ protected:
     virtual void _moveCells(const CellAddress &, int, int, ExpressionVisitor &) override;
     virtual void _offsetCells(int, int, ExpressionVisitor &) override;
 
+    const App::Property *getBoundProperty() const;
+
 protected:
 
     ObjectIdentifier var; /**< Variable name  */
+
+private:
+    mutable const App::Property *boundProperty = 0; /**< Cached property resolved from var */
+    mutable unsigned long boundRevision = 0; /**< Binding revision boundProperty was resolved at */
 };
 
 //////////////////////////////////////////////////////////////////////
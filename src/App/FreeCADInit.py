@@ -48,6 +48,157 @@ def removeFromPath(module_name):
 FreeCAD._importFromFreeCAD = removeFromPath
 
 
+class InitManifest(object):
+	"""Cache of the registrations done by the Init.py scripts of the modules.
+
+	With lazy module initialization an Init.py that only registers file types
+	and unit tests is executed once. Its registrations are stored in the
+	manifest and replayed on the next starts as long as the script is not
+	modified. The libraries and scripts of the module are then loaded on first
+	use of a file type or a document object type, as usual.
+	Scripts doing anything else are always executed."""
+
+	def __init__(self, fileName):
+		import json
+		self.fileName = fileName
+		self.version = '.'.join([FreeCAD.ConfigGet("BuildVersionMajor"),
+		                         FreeCAD.ConfigGet("BuildVersionMinor"),
+		                         FreeCAD.ConfigGet("BuildRevision")])
+		self.modules = {}
+		self.changed = False
+		self.current = None
+		if os.path.exists(fileName):
+			try:
+				with open(fileName) as f:
+					data = json.load(f)
+				if data.get("version") == self.version:
+					self.modules = data.get("modules", {})
+			except Exception as inst:
+				Log('Init:   Ignoring invalid manifest ' + fileName + ': ' + str(inst) + '\n')
+
+	@staticmethod
+	def fileStamp(initFile):
+		st = os.stat(initFile)
+		return [st.st_mtime, st.st_size]
+
+	@staticmethod
+	def isCacheable(initFile):
+		"""Checks if the script does nothing but registrations with constant arguments"""
+		import ast
+		def isString(node):
+			if hasattr(ast, "Constant") and isinstance(node, ast.Constant):
+				return isinstance(node.value, str)
+			return isinstance(node, ast.Str)
+		with open(initFile) as f:
+			tree = ast.parse(f.read(), initFile)
+		for node in tree.body:
+			# importing any other module may have side effects
+			if isinstance(node, ast.Import) and len(node.names) == 1 \
+					and node.names[0].name == "FreeCAD" \
+					and node.names[0].asname in (None, "App"):
+				continue
+			if isinstance(node, ast.Expr) and isString(node.value):
+				continue
+			if isinstance(node, ast.Assign) and isString(node.value) \
+					and all(isinstance(t, ast.Name) and t.id.startswith('__') for t in node.targets):
+				continue
+			if isinstance(node, ast.Expr) and isinstance(node.value, ast.Call) \
+					and isinstance(node.value.func, ast.Attribute) \
+					and node.value.func.attr in ("addImportType", "addExportType") \
+					and len(node.value.args) == 2 and not node.value.keywords \
+					and all(isString(a) for a in node.value.args):
+				continue
+			if isinstance(node, ast.AugAssign) and isinstance(node.op, ast.Add) \
+					and isinstance(node.target, ast.Attribute) \
+					and node.target.attr == "__unit_test__" \
+					and isinstance(node.value, ast.List) \
+					and all(isString(e) for e in node.value.elts):
+				continue
+			return False
+		return True
+
+	def replay(self, initFile):
+		"""Repeats the registrations of the script if it is unchanged since it has been recorded"""
+		entry = self.modules.get(initFile)
+		if not entry or not entry["cacheable"]:
+			return False
+		try:
+			if entry["stamp"] != InitManifest.fileStamp(initFile):
+				return False
+		except OSError:
+			return False
+		for filter, module in entry["import"]:
+			FreeCAD.addImportType(filter, module)
+		for filter, module in entry["export"]:
+			FreeCAD.addExportType(filter, module)
+		FreeCAD.__unit_test__ += entry["unittest"]
+		return True
+
+	def record(self, initFile):
+		"""Starts recording the registrations done by the script"""
+		entry = self.modules.get(initFile)
+		stamp = InitManifest.fileStamp(initFile)
+		if entry and entry["stamp"] == stamp and not entry["cacheable"]:
+			# known to do more than registering, no need to check again
+			self.current = None
+			return
+		try:
+			cacheable = InitManifest.isCacheable(initFile)
+		except Exception:
+			cacheable = False
+		self.current = {"stamp": stamp, "cacheable": cacheable,
+		                "import": [], "export": [], "unittest": []}
+		self.numUnitTests = len(FreeCAD.__unit_test__)
+		if not cacheable:
+			return
+		current = self.current
+		self.addImportType = FreeCAD.addImportType
+		self.addExportType = FreeCAD.addExportType
+		def addImportType(filter, module, addImportType=self.addImportType):
+			addImportType(filter, module)
+			current["import"].append([filter, module])
+		def addExportType(filter, module, addExportType=self.addExportType):
+			addExportType(filter, module)
+			current["export"].append([filter, module])
+		FreeCAD.addImportType = addImportType
+		FreeCAD.addExportType = addExportType
+
+	def commit(self, initFile, ok):
+		"""Stops recording and stores the registrations if the script succeeded"""
+		current = self.current
+		if current is None:
+			# a failed replay must not be repeated on the next start
+			if not ok and self.modules.pop(initFile, None) is not None:
+				self.changed = True
+			return
+		self.current = None
+		if current["cacheable"]:
+			FreeCAD.addImportType = self.addImportType
+			FreeCAD.addExportType = self.addExportType
+			current["unittest"] = FreeCAD.__unit_test__[self.numUnitTests:]
+		if ok:
+			self.modules[initFile] = current
+			self.changed = True
+
+	def save(self):
+		if not self.changed:
+			return
+		import json
+		tmpName = self.fileName + '.' + str(os.getpid())
+		try:
+			with open(tmpName, 'w') as f:
+				json.dump({"version": self.version, "modules": self.modules}, f, indent=1)
+			# several instances may start at the same time
+			if hasattr(os, "replace"):
+				os.replace(tmpName, self.fileName)
+			else:
+				if os.path.exists(self.fileName):
+					os.remove(self.fileName)
+				os.rename(tmpName, self.fileName)
+		except Exception as inst:
+			Wrn('Cannot write module manifest ' + self.fileName + ': ' + str(inst) + '\n')
+
+
 def InitApplications():
 	# Checking on FreeCAD module path ++++++++++++++++++++++++++++++++++++++++++
 	ModDir = FreeCAD.getHomePath()+'Mod'
@@ -130,17 +281,31 @@ def InitApplications():
 	# proper python modules this can eventuelly be removed.
 	sys.path = [ModDir] + libpaths + [ExtDir] + sys.path
 
+	# With lazy initialization the registrations of the modules are taken from
+	# a manifest instead of running their Init.py on every start
+	Manifest = None
+	if FreeCAD.ParamGet("User parameter:BaseApp/Preferences/General").GetBool("LazyModuleInit", False):
+		Manifest = InitManifest(FreeCAD.getUserAppDataDir() + "ModuleManifest.json")
+
 	for Dir in ModDict.values():
 		if ((Dir != '') & (Dir != 'CVS') & (Dir != '__init__.py')):
 			sys.path.insert(0,Dir)
 			PathExtension.append(Dir)
 			InstallFile = os.path.join(Dir,"Init.py")
 			if (os.path.exists(InstallFile)):
+				FreeCAD.beginStartupTrace("Init.py", InstallFile)
+				InitOk = False
+				Cached = False
 				try:
-					# XXX: This looks scary securitywise...
+					if Manifest and Manifest.replay(InstallFile):
+						Cached = True
+					else:
+						if Manifest:
+							Manifest.record(InstallFile)
+						# XXX: This looks scary securitywise...
 
-					with open(InstallFile) as f:
-						exec(f.read())
+						with open(InstallFile) as f:
+							exec(f.read())
 				except Exception as inst:
 					Log('Init:      Initializing ' + Dir + '... failed\n')
 					Log('-'*100+'\n')
@@ -149,10 +314,21 @@ def InitApplications():
 					Err('During initialization the error "' + str(inst) + '" occurred in ' + InstallFile + '\n')
 					Err('Please look into the log file for further information\n')
 				else:
-					Log('Init:      Initializing ' + Dir + '... done\n')
+					InitOk = True
+					if Cached:
+						Log('Init:      Initializing ' + Dir + '... done (cached)\n')
+					else:
+						Log('Init:      Initializing ' + Dir + '... done\n')
+				finally:
+					if Manifest:
+						Manifest.commit(InstallFile, InitOk)
+				FreeCAD.endStartupTrace()
 			else:
 				Log('Init:      Initializing ' + Dir + '(Init.py not found)... ignore\n')
 
+	if Manifest:
+		Manifest.save()
+
 	extension_modules = []
 
 	try:
@@ -162,6 +338,7 @@ def InitApplications():
 		for _, freecad_module_name, freecad_module_ispkg in pkgutil.iter_modules(freecad.__path__, "freecad."):
 			if freecad_module_ispkg:
 				Log('Init: Initializing ' + freecad_module_name + '\n')
+				FreeCAD.beginStartupTrace("init", freecad_module_name)
 				try:
 					freecad_module = importlib.import_module(freecad_module_name)
 					extension_modules += [freecad_module_name]
@@ -179,6 +356,8 @@ def InitApplications():
 					Log('-'*80+'\n')
 					Log(traceback.format_exc())
 					Log('-'*80+'\n')
+				finally:
+					FreeCAD.endStartupTrace()
 	except ImportError as inst:
 		Err('During initialization the error "' + str(inst) + '" occurred\n')
 
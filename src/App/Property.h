@@ -118,6 +118,15 @@ public:
         return sizeof(father) + sizeof(StatusBits);
     }
 
+    /** Get the size of the data held by this property alone
+     * Properties may share their data with copies made by Copy() until either
+     * of them is changed (copy-on-write). The shared data is not included here,
+     * so that e.g. the undo/redo stack only accounts for what it retains.
+     */
+    virtual unsigned int getExclusiveMemSize (void) const {
+        return getMemSize();
+    }
+
     /// get the name of this property in the belonging container
     const char* getName(void) const;
 
@@ -25,6 +25,7 @@
 
 #ifndef _PreComp_
 #	include <assert.h>
+#	include <algorithm>
 #endif
 
 /// Here the FreeCAD includes sorted by Base,App,Gui......
@@ -357,23 +358,21 @@ void PropertyVectorList::Restore(Base::XMLReader &reader)
     }
 }
 
+// SaveDocFile() and RestoreDocFile() access the list as an array of coordinates
+static_assert(sizeof(Base::Vector3d) == 3*sizeof(double),
+              "PropertyVectorList: Base::Vector3d must consist of three doubles without padding");
+
 void PropertyVectorList::SaveDocFile (Base::Writer &writer) const
 {
     Base::OutputStream str(writer.Stream());
     uint32_t uCt = (uint32_t)getSize();
     str << uCt;
+    const double *coords = reinterpret_cast<const double*>(_lValueList.data());
     if (!isSinglePrecision()) {
-        for (std::vector<Base::Vector3d>::const_iterator it = _lValueList.begin(); it != _lValueList.end(); ++it) {
-            str << it->x << it->y << it->z;
-        }
+        str.write(coords, 3*_lValueList.size());
     }
     else {
-        for (std::vector<Base::Vector3d>::const_iterator it = _lValueList.begin(); it != _lValueList.end(); ++it) {
-            float x = (float)it->x;
-            float y = (float)it->y;
-            float z = (float)it->z;
-            str << x << y << z;
-        }
+        str.writeAs<float>(coords, 3*_lValueList.size());
     }
 }
 
@@ -383,17 +382,12 @@ void PropertyVectorList::RestoreDocFile(Base::Reader &reader)
     uint32_t uCt=0;
     str >> uCt;
     std::vector<Base::Vector3d> values(uCt);
+    double *coords = reinterpret_cast<double*>(values.data());
     if (!isSinglePrecision()) {
-        for (std::vector<Base::Vector3d>::iterator it = values.begin(); it != values.end(); ++it) {
-            str >> it->x >> it->y >> it->z;
-        }
+        str.read(coords, 3*values.size());
     }
     else {
-        float x,y,z;
-        for (std::vector<Base::Vector3d>::iterator it = values.begin(); it != values.end(); ++it) {
-            str >> x >> y >> z;
-            it->Set(x, y, z);
-        }
+        str.readAs<float>(coords, 3*values.size());
     }
     setValues(values);
 }
@@ -841,22 +835,27 @@ void PropertyPlacementList::SaveDocFile (Base::Writer &writer) const
     Base::OutputStream str(writer.Stream());
     uint32_t uCt = (uint32_t)getSize();
     str << uCt;
-    if (!isSinglePrecision()) {
-        for (std::vector<Base::Placement>::const_iterator it = _lValueList.begin(); it != _lValueList.end(); ++it) {
-            str << it->getPosition().x << it->getPosition().y << it->getPosition().z
-                << it->getRotation()[0] << it->getRotation()[1] << it->getRotation()[2] << it->getRotation()[3] ;
-        }
-    }
-    else {
-        for (std::vector<Base::Placement>::const_iterator it = _lValueList.begin(); it != _lValueList.end(); ++it) {
-            float x = (float)it->getPosition().x;
-            float y = (float)it->getPosition().y;
-            float z = (float)it->getPosition().z;
-            float q0 = (float)it->getRotation()[0];
-            float q1 = (float)it->getRotation()[1];
-            float q2 = (float)it->getRotation()[2];
-            float q3 = (float)it->getRotation()[3];
-            str << x << y << z << q0 << q1 << q2 << q3;
+    // collect the position and rotation of a chunk of placements in one buffer
+    double buffer[7*128];
+    std::size_t num = 0;
+    for (std::vector<Base::Placement>::const_iterator it = _lValueList.begin(); it != _lValueList.end(); ++it) {
+        double *values = buffer + num;
+        const Base::Vector3d &pos = it->getPosition();
+        const Base::Rotation &rot = it->getRotation();
+        values[0] = pos.x;
+        values[1] = pos.y;
+        values[2] = pos.z;
+        values[3] = rot[0];
+        values[4] = rot[1];
+        values[5] = rot[2];
+        values[6] = rot[3];
+        num += 7;
+        if (num == 7*128 || it + 1 == _lValueList.end()) {
+            if (!isSinglePrecision())
+                str.write(buffer, num);
+            else
+                str.writeAs<float>(buffer, num);
+            num = 0;
         }
     }
 }
@@ -867,24 +866,18 @@ void PropertyPlacementList::RestoreDocFile(Base::Reader &reader)
     uint32_t uCt=0;
     str >> uCt;
     std::vector<Base::Placement> values(uCt);
-    if (!isSinglePrecision()) {
-        for (std::vector<Base::Placement>::iterator it = values.begin(); it != values.end(); ++it) {
-            Base::Vector3d pos;
-            double q0, q1, q2, q3;
-            str >> pos.x >> pos.y >> pos.z >> q0 >> q1 >> q2 >> q3;
-            Base::Rotation rot(q0,q1,q2,q3);
-            it->setPosition(pos);
-            it->setRotation(rot);
-        }
-    }
-    else {
-        float x,y,z,q0,q1,q2,q3;
-        for (std::vector<Base::Placement>::iterator it = values.begin(); it != values.end(); ++it) {
-            str >> x >> y >> z >> q0 >> q1 >> q2 >> q3;
-            Base::Vector3d pos(x, y, z);
-            Base::Rotation rot(q0,q1,q2,q3);
-            it->setPosition(pos);
-            it->setRotation(rot);
+    double buffer[7*128];
+    for (std::size_t i=0; i<values.size(); i+=128) {
+        std::size_t num = std::min<std::size_t>(128, values.size() - i);
+        if (!isSinglePrecision())
+            str.read(buffer, 7*num);
+        else
+            str.readAs<float>(buffer, 7*num);
+        for (std::size_t j=0; j<num; j++) {
+            const double *value = buffer + 7*j;
+            Base::Placement &pla = values[i+j];
+            pla.setPosition(Base::Vector3d(value[0], value[1], value[2]));
+            pla.setRotation(Base::Rotation(value[3], value[4], value[5], value[6]));
         }
     }
     setValues(values);
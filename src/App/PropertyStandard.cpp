@@ -24,6 +24,8 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
+# include <algorithm>
+# include <cstring>
 # include <sstream>
 # include <boost/version.hpp>
 # include <boost/filesystem/path.hpp>
@@ -1270,15 +1272,10 @@ void PropertyFloatList::SaveDocFile (Base::Writer &writer) const
     uint32_t uCt = (uint32_t)getSize();
     str << uCt;
     if (!isSinglePrecision()) {
-        for (std::vector<double>::const_iterator it = _lValueList.begin(); it != _lValueList.end(); ++it) {
-            str << *it;
-        }
+        str.write(_lValueList.data(), _lValueList.size());
     }
     else {
-        for (std::vector<double>::const_iterator it = _lValueList.begin(); it != _lValueList.end(); ++it) {
-            float v = (float)*it;
-            str << v;
-        }
+        str.writeAs<float>(_lValueList.data(), _lValueList.size());
     }
 }
 
@@ -1289,16 +1286,10 @@ void PropertyFloatList::RestoreDocFile(Base::Reader &reader)
     str >> uCt;
     std::vector<double> values(uCt);
     if (!isSinglePrecision()) {
-        for (std::vector<double>::iterator it = values.begin(); it != values.end(); ++it) {
-            str >> *it;
-        }
+        str.read(values.data(), values.size());
     }
     else {
-        for (std::vector<double>::iterator it = values.begin(); it != values.end(); ++it) {
-            float val;
-            str >> val;
-            (*it) = val;
-        }
+        str.readAs<float>(values.data(), values.size());
     }
     setValues(values);
 }
@@ -1366,16 +1357,24 @@ void PropertyString::setValue(const char* newLabel)
         App::Document* doc = obj->getDocument();
         if(doc && !_hPGrp->GetBool("DuplicateLabels") && !obj->allowDuplicateLabel()) {
             std::vector<std::string> objectLabels;
-            std::vector<App::DocumentObject*>::const_iterator it;
-            std::vector<App::DocumentObject*> objs = doc->getObjects();
             bool match = false;
-            for (it = objs.begin();it != objs.end();++it) {
-                if (*it == obj)
-                    continue; // don't compare object with itself
-                std::string objLabel = (*it)->Label.getValue();
-                if (!match && objLabel == newLabel)
-                    match = true;
-                objectLabels.push_back(objLabel);
+            // The document keeps a table of all labels while bulk inserting
+            bool bulk = doc->isBulkInserting();
+            if (bulk) {
+                match = doc->hasBulkLabel(newLabel, obj);
+            }
+            else {
+                std::vector<App::DocumentObject*>::const_iterator it;
+                const std::vector<App::DocumentObject*> &objs = doc->getObjects();
+                objectLabels.reserve(objs.size());
+                for (it = objs.begin();it != objs.end();++it) {
+                    if (*it == obj)
+                        continue; // don't compare object with itself
+                    std::string objLabel = (*it)->Label.getValue();
+                    if (!match && objLabel == newLabel)
+                        match = true;
+                    objectLabels.push_back(objLabel);
+                }
             }
 
             // make sure that there is a name conflict otherwise we don't have to do anything
@@ -1406,15 +1405,20 @@ void PropertyString::setValue(const char* newLabel)
                         if(*c<48 || *c>57)
                             break;
                     }
-                    if(*c == 0 && std::find(objectLabels.begin(), objectLabels.end(),
-                                            obj->getNameInDocument())==objectLabels.end()) 
+                    if(*c == 0 && (bulk ? !doc->hasBulkLabel(obj->getNameInDocument(), obj)
+                                        : std::find(objectLabels.begin(), objectLabels.end(),
+                                            obj->getNameInDocument())==objectLabels.end()))
                     {
                         label = obj->getNameInDocument();
                         changed = true;
                     }
                 }
-                if(!changed)
-                    label = Base::Tools::getUniqueName(label, objectLabels, 3);
+                if(!changed) {
+                    if (bulk)
+                        label = doc->getUniqueBulkLabel(label, 3);
+                    else
+                        label = Base::Tools::getUniqueName(label, objectLabels, 3);
+                }
             }
         }
 
@@ -2494,9 +2498,17 @@ void PropertyColorList::SaveDocFile (Base::Writer &writer) const
     Base::OutputStream str(writer.Stream());
     uint32_t uCt = (uint32_t)getSize();
     str << uCt;
+    // pack a chunk at a time and write it in one go
+    uint32_t buffer[1024];
+    std::size_t num = 0;
     for (std::vector<App::Color>::const_iterator it = _lValueList.begin(); it != _lValueList.end(); ++it) {
-        str << it->getPackedValue();
+        buffer[num++] = it->getPackedValue();
+        if (num == 1024) {
+            str.write(buffer, num);
+            num = 0;
+        }
     }
+    str.write(buffer, num);
 }
 
 void PropertyColorList::RestoreDocFile(Base::Reader &reader)
@@ -2505,10 +2517,12 @@ void PropertyColorList::RestoreDocFile(Base::Reader &reader)
     uint32_t uCt=0;
     str >> uCt;
     std::vector<Color> values(uCt);
-    uint32_t value; // must be 32 bit long
-    for (std::vector<App::Color>::iterator it = values.begin(); it != values.end(); ++it) {
-        str >> value;
-        it->setPackedValue(value);
+    uint32_t buffer[1024]; // must be 32 bit long
+    for (std::size_t i=0; i<values.size(); i+=1024) {
+        std::size_t num = std::min<std::size_t>(1024, values.size() - i);
+        str.read(buffer, num);
+        for (std::size_t j=0; j<num; j++)
+            values[i+j].setPackedValue(buffer[j]);
     }
     setValues(values);
 }
@@ -2734,14 +2748,25 @@ void PropertyMaterialList::SaveDocFile(Base::Writer &writer) const
     Base::OutputStream str(writer.Stream());
     uint32_t uCt = (uint32_t)getSize();
     str << uCt;
+    // All members are 32 bit long, so a chunk of materials is collected in
+    // one buffer and written in one go.
+    uint32_t buffer[6*256];
+    std::size_t num = 0;
     for (std::vector<App::Material>::const_iterator it = _lValueList.begin(); it != _lValueList.end(); ++it) {
-        str << it->ambientColor.getPackedValue();
-        str << it->diffuseColor.getPackedValue();
-        str << it->specularColor.getPackedValue();
-        str << it->emissiveColor.getPackedValue();
-        str << it->shininess;
-        str << it->transparency;
+        uint32_t *values = buffer + num;
+        values[0] = it->ambientColor.getPackedValue();
+        values[1] = it->diffuseColor.getPackedValue();
+        values[2] = it->specularColor.getPackedValue();
+        values[3] = it->emissiveColor.getPackedValue();
+        memcpy(&values[4], &it->shininess, sizeof(float));
+        memcpy(&values[5], &it->transparency, sizeof(float));
+        num += 6;
+        if (num == 6*256) {
+            str.write(buffer, num);
+            num = 0;
+        }
     }
+    str.write(buffer, num);
 }
 
 void PropertyMaterialList::RestoreDocFile(Base::Reader &reader)
@@ -2750,21 +2775,20 @@ void PropertyMaterialList::RestoreDocFile(Base::Reader &reader)
     uint32_t uCt = 0;
     str >> uCt;
     std::vector<Material> values(uCt);
-    uint32_t value; // must be 32 bit long
-    float valueF;
-    for (std::vector<App::Material>::iterator it = values.begin(); it != values.end(); ++it) {
-        str >> value;
-        it->ambientColor.setPackedValue(value);
-        str >> value;
-        it->diffuseColor.setPackedValue(value);
-        str >> value;
-        it->specularColor.setPackedValue(value);
-        str >> value;
-        it->emissiveColor.setPackedValue(value);
-        str >> valueF;
-        it->shininess = valueF;
-        str >> valueF;
-        it->transparency = valueF;
+    uint32_t buffer[6*256]; // must be 32 bit long
+    for (std::size_t i=0; i<values.size(); i+=256) {
+        std::size_t num = std::min<std::size_t>(256, values.size() - i);
+        str.read(buffer, 6*num);
+        for (std::size_t j=0; j<num; j++) {
+            const uint32_t *value = buffer + 6*j;
+            Material &mat = values[i+j];
+            mat.ambientColor.setPackedValue(value[0]);
+            mat.diffuseColor.setPackedValue(value[1]);
+            mat.specularColor.setPackedValue(value[2]);
+            mat.emissiveColor.setPackedValue(value[3]);
+            memcpy(&mat.shininess, &value[4], sizeof(float));
+            memcpy(&mat.transparency, &value[5], sizeof(float));
+        }
     }
     setValues(values);
 }
@@ -73,6 +73,9 @@ struct AppExport CellAddress {
 
     std::string toString(bool noAbsolute=false) const;
 
+    /// Packed (row, column) key, e.g. for hashed containers
+    inline unsigned int asInt() const { return ((_row << 16) | _col); }
+
     // Static members
 
     static const int MAX_ROWS;
@@ -81,8 +84,6 @@ struct AppExport CellAddress {
 
 protected:
 
-    inline unsigned int asInt() const { return ((_row << 16) | _col); }
-
     short _row;
     short _col;
     bool _absRow;
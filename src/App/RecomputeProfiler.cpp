@@ -0,0 +1,274 @@
+/***************************************************************************
+ *   Copyright (c) 2020 FreeCAD Developers                                 *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <algorithm>
+# include <cstdio>
+# include <ostream>
+#endif
+
+#if defined(FC_OS_WIN32)
+# include <psapi.h>
+#elif defined(FC_OS_MACOSX)
+# include <mach/mach.h>
+#elif defined(FC_OS_LINUX) || defined(FC_OS_CYGWIN)
+# include <unistd.h>
+#endif
+
+#include <Base/Tools.h>
+
+#include "RecomputeProfiler.h"
+#include "DocumentObject.h"
+
+using namespace App;
+
+namespace {
+
+long long microSeconds(RecomputeProfiler::Clock::duration d)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(d).count();
+}
+
+/// Returns the resident memory of the process in bytes, or 0 if unknown
+long long residentMemory()
+{
+#if defined(FC_OS_WIN32)
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc)))
+        return static_cast<long long>(pmc.WorkingSetSize);
+#elif defined(FC_OS_MACOSX)
+    mach_task_basic_info info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO,
+                  reinterpret_cast<task_info_t>(&info), &count) == KERN_SUCCESS)
+        return static_cast<long long>(info.resident_size);
+#elif defined(FC_OS_LINUX) || defined(FC_OS_CYGWIN)
+    long long pages = 0;
+    FILE* file = fopen("/proc/self/statm", "r");
+    if (file) {
+        if (fscanf(file, "%*s %lld", &pages) != 1)
+            pages = 0;
+        fclose(file);
+    }
+    return pages * sysconf(_SC_PAGESIZE);
+#endif
+    return 0;
+}
+
+}
+
+RecomputeProfiler::RecomputeProfiler()
+    : capacity(DefaultCapacity)
+    , next(0)
+    , origin(Clock::now())
+    , recomputeCount(0)
+    , recomputing(false)
+    , enabled(false)
+{
+}
+
+void RecomputeProfiler::start(std::size_t size)
+{
+    if (!enabled)
+        origin = Clock::now();
+    size = std::max<std::size_t>(size, 1);
+    if (size != capacity) {
+        // keep the newest records
+        std::vector<RecomputeRecord> recs = getRecords();
+        if (recs.size() > size)
+            recs.erase(recs.begin(), recs.end() - size);
+        records = std::move(recs);
+        capacity = size;
+        next = records.size() % capacity;
+    }
+    enabled = true;
+}
+
+void RecomputeProfiler::stop()
+{
+    enabled = false;
+    touches.clear();
+    depths.clear();
+}
+
+void RecomputeProfiler::clear()
+{
+    records.clear();
+    next = 0;
+    origin = Clock::now();
+}
+
+std::vector<RecomputeRecord> RecomputeProfiler::getRecords() const
+{
+    if (records.size() < capacity)
+        return records;
+    std::vector<RecomputeRecord> recs;
+    recs.reserve(records.size());
+    recs.insert(recs.end(), records.begin() + next, records.end());
+    recs.insert(recs.end(), records.begin(), records.begin() + next);
+    return recs;
+}
+
+void RecomputeProfiler::addRecord(RecomputeRecord&& record)
+{
+    if (records.size() < capacity)
+        records.push_back(std::move(record));
+    else
+        records[next] = std::move(record);
+    next = (next + 1) % capacity;
+}
+
+void RecomputeProfiler::propertyChanged(const DocumentObject* obj, const Property* prop)
+{
+    // the same test as DocumentObject::onChanged() uses to touch the object
+    if (obj->testStatus(ObjectStatus::NoTouch)
+            || (prop->getType() & Prop_Output)
+            || prop->testStatus(Property::Output))
+        return;
+
+    TouchInfo& info = touches[obj->getID()];
+    ++info.count;
+    if (info.property.empty() && prop->getName())
+        info.property = prop->getName();
+}
+
+void RecomputeProfiler::beginRecompute(const std::vector<DocumentObject*>& objs)
+{
+    ++recomputeCount;
+    recomputing = true;
+
+    // The objects come with their dependencies first, so the depth of each
+    // object follows from the ones of its dependencies.
+    depths.clear();
+    for (auto obj : objs) {
+        int depth = 1;
+        for (auto dep : obj->getOutList()) {
+            auto it = depths.find(dep->getID());
+            if (it != depths.end())
+                depth = std::max(depth, it->second + 1);
+        }
+        depths[obj->getID()] = depth;
+    }
+}
+
+void RecomputeProfiler::recomputeEnforced(const DocumentObject* obj, const DocumentObject* by)
+{
+    TouchInfo& info = touches[obj->getID()];
+    if (info.enforcedBy.empty() && by->getNameInDocument())
+        info.enforcedBy = by->getNameInDocument();
+}
+
+void RecomputeProfiler::endRecompute()
+{
+    recomputing = false;
+    depths.clear();
+}
+
+std::string RecomputeProfiler::getCause(const DocumentObject* obj) const
+{
+    auto it = touches.find(obj->getID());
+    if (it != touches.end() && !it->second.property.empty())
+        return "property:" + it->second.property;
+    if (obj->ExpressionEngine.isTouched())
+        return "expression";
+    if (it != touches.end() && !it->second.enforcedBy.empty())
+        return "dependency:" + it->second.enforcedBy;
+    if (obj->testStatus(ObjectStatus::Enforce))
+        return "touched";
+    return "mustExecute";
+}
+
+void RecomputeProfiler::exportTrace(std::ostream& str, const std::string& document) const
+{
+    str << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n"
+        << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\""
+        << Base::Tools::escapeEncodeJson(document) << "\"}}";
+    for (const auto& rec : getRecords()) {
+        str << ",\n{\"name\":\"" << Base::Tools::escapeEncodeJson(rec.label)
+            << "\",\"cat\":\"" << Base::Tools::escapeEncodeJson(rec.type)
+            << "\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":" << rec.start
+            << ",\"dur\":" << rec.duration
+            << ",\"args\":{\"object\":\"" << Base::Tools::escapeEncodeJson(rec.object)
+            << "\",\"cause\":\"" << Base::Tools::escapeEncodeJson(rec.cause)
+            << "\",\"touches\":" << rec.touchCount
+            << ",\"depth\":" << rec.depth
+            << ",\"memoryDelta\":" << rec.memoryDelta
+            << ",\"recompute\":" << rec.recompute
+            << ",\"failed\":" << (rec.failed ? "true" : "false") << "}}";
+    }
+    str << "\n]}\n";
+}
+
+// ----------------------------------------------------------------------------
+
+RecomputeProfiler::Recompute::Recompute(RecomputeProfiler& profiler,
+                                        const std::vector<DocumentObject*>& objs)
+    : profiler(profiler), active(profiler.isEnabled())
+{
+    if (active)
+        profiler.beginRecompute(objs);
+}
+
+RecomputeProfiler::Recompute::~Recompute()
+{
+    // even if the profiler has been stopped in the meantime
+    if (active)
+        profiler.endRecompute();
+}
+
+// ----------------------------------------------------------------------------
+
+RecomputeProfiler::Measure::Measure(RecomputeProfiler& profiler, DocumentObject* obj)
+    : profiler(profiler), obj(obj), memory(0), active(profiler.isEnabled())
+{
+    if (!active)
+        return;
+
+    record.object = obj->getNameInDocument() ? obj->getNameInDocument() : "";
+    record.label = obj->Label.getStrValue();
+    record.type = obj->getTypeId().getName();
+    record.cause = profiler.getCause(obj);
+    auto it = profiler.touches.find(obj->getID());
+    record.touchCount = it != profiler.touches.end() ? it->second.count : 0;
+    auto itDepth = profiler.depths.find(obj->getID());
+    record.depth = itDepth != profiler.depths.end() ? itDepth->second : 0;
+    record.recompute = profiler.recomputing ? profiler.recomputeCount : 0;
+    memory = residentMemory();
+    begin = Clock::now();
+}
+
+RecomputeProfiler::Measure::~Measure()
+{
+    if (!active || !profiler.isEnabled())
+        return;
+
+    Clock::time_point end = Clock::now();
+    record.start = microSeconds(begin - profiler.origin);
+    record.duration = microSeconds(end - begin);
+    record.memoryDelta = residentMemory() - memory;
+    record.failed = obj->isError();
+    profiler.touches.erase(obj->getID());
+    profiler.addRecord(std::move(record));
+}
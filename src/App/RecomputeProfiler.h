@@ -0,0 +1,151 @@
+/***************************************************************************
+ *   Copyright (c) 2020 FreeCAD Developers                                 *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef APP_RECOMPUTEPROFILER_H
+#define APP_RECOMPUTEPROFILER_H
+
+#include <chrono>
+#include <iosfwd>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace App
+{
+
+class DocumentObject;
+class Property;
+
+/// Measurements of one recompute of a document object
+struct AppExport RecomputeRecord
+{
+    std::string object;      ///< internal name of the object
+    std::string label;
+    std::string type;
+    std::string cause;       ///< what caused the recompute, see RecomputeProfiler
+    long long start;         ///< microseconds since the profiler has been started
+    long long duration;      ///< microseconds spent in the recompute
+    long long memoryDelta;   ///< change of the resident memory of the process in bytes
+    int touchCount;          ///< number of input property changes since the last recompute
+    int depth;               ///< position in the longest dependency chain of the recompute
+    unsigned long recompute; ///< serial number of the document recompute
+    bool failed;
+};
+
+/** Records the recompute of each object of a document
+ *
+ * The records are kept in a ring buffer so that the profiler can be left
+ * running over a long session. The cause of a recompute is one of
+ * - "property:<name>": an input property of the object has been changed
+ * - "expression": an expression bound to the object needs to be evaluated
+ * - "dependency:<name>": an object the object depends on has been recomputed
+ * - "touched": the object has been touched explicitly
+ * - "mustExecute": the object requested the recompute itself
+ *
+ * The depth is 1 for the objects without dependencies within the document
+ * recompute, and 0 for objects recomputed on their own by
+ * Document::recomputeFeature().
+ */
+class AppExport RecomputeProfiler
+{
+public:
+    typedef std::chrono::steady_clock Clock;
+    static const std::size_t DefaultCapacity = 4096;
+
+    RecomputeProfiler();
+
+    /// Starts recording, keeping at most \a capacity records
+    void start(std::size_t capacity = DefaultCapacity);
+    void stop();
+    bool isEnabled() const {
+        return enabled;
+    }
+    void clear();
+
+    /// Returns the records, oldest first
+    std::vector<RecomputeRecord> getRecords() const;
+    /// Writes the records in the trace event format of Chrome, readable by Perfetto
+    void exportTrace(std::ostream& str, const std::string& document) const;
+
+    /** @name Hooks of the document */
+    //@{
+    void propertyChanged(const DocumentObject* obj, const Property* prop);
+    /// Called with the topologically sorted objects to recompute
+    void beginRecompute(const std::vector<DocumentObject*>& objs);
+    void recomputeEnforced(const DocumentObject* obj, const DocumentObject* by);
+    void endRecompute();
+    //@}
+
+    /// Records the recompute of an object during its lifetime
+    class AppExport Measure
+    {
+    public:
+        Measure(RecomputeProfiler& profiler, DocumentObject* obj);
+        ~Measure();
+
+    private:
+        RecomputeProfiler& profiler;
+        DocumentObject* obj;
+        RecomputeRecord record;
+        Clock::time_point begin;
+        long long memory;
+        bool active;
+    };
+
+    /// Brackets a document recompute, also when it is left by an exception
+    class AppExport Recompute
+    {
+    public:
+        Recompute(RecomputeProfiler& profiler, const std::vector<DocumentObject*>& objs);
+        ~Recompute();
+
+    private:
+        RecomputeProfiler& profiler;
+        bool active;
+    };
+
+private:
+    std::string getCause(const DocumentObject* obj) const;
+    void addRecord(RecomputeRecord&& record);
+
+    struct TouchInfo {
+        std::string property;
+        std::string enforcedBy;
+        int count = 0;
+    };
+
+    std::vector<RecomputeRecord> records;
+    std::size_t capacity;
+    std::size_t next;
+    /// touches and depths keyed by the object ID
+    std::unordered_map<long, TouchInfo> touches;
+    std::unordered_map<long, int> depths;
+    Clock::time_point origin;
+    unsigned long recomputeCount;
+    bool recomputing;
+    bool enabled;
+};
+
+} // namespace App
+
+#endif // APP_RECOMPUTEPROFILER_H
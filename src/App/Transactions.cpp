@@ -112,7 +112,10 @@ int Transaction::getLastID() {
 
 unsigned int Transaction::getMemSize (void) const
 {
-    return 0;
+    unsigned int size = 0;
+    for (auto &v : _Objects)
+        size += v.second->getMemSize();
+    return size;
 }
 
 void Transaction::Save (Base::Writer &/*writer*/) const
@@ -406,7 +409,12 @@ void TransactionObject::addOrRemoveProperty(const Property* pcProp, bool add)
 
 unsigned int TransactionObject::getMemSize (void) const
 {
-    return 0;
+    unsigned int size = 0;
+    for (auto &v : _PropChangeMap) {
+        if (v.second.property)
+            size += v.second.property->getExclusiveMemSize();
+    }
+    return size;
 }
 
 void TransactionObject::Save (Base::Writer &/*writer*/) const
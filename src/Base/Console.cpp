@@ -39,7 +39,9 @@
 #include "Exception.h"
 #include "PyObjectBase.h"
 #include <QCoreApplication>
+#include <QThread>
 #include <frameobject.h>
+#include <mutex>
 
 using namespace Base;
 
@@ -68,10 +70,22 @@ class ConsoleOutput : public QObject
 {
 public:
     static ConsoleOutput* getInstance() {
-        if (!instance)
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!instance) {
             instance = new ConsoleOutput;
+            // the events must be handled by the main thread, also if the
+            // first message comes from a worker thread
+            QCoreApplication* app = QCoreApplication::instance();
+            if (app)
+                instance->moveToThread(app->thread());
+        }
         return instance;
     }
+    /// Messages of worker threads are queued, the observers are not thread-safe
+    static bool isWorkerThread() {
+        QCoreApplication* app = QCoreApplication::instance();
+        return app && QThread::currentThread() != app->thread();
+    }
     static void destruct() {
         delete instance;
         instance = 0;
@@ -106,9 +120,11 @@ private:
     }
 
     static ConsoleOutput* instance;
+    static std::mutex mutex;
 };
 
 ConsoleOutput* ConsoleOutput::instance = 0;
+std::mutex ConsoleOutput::mutex;
 
 }
 
@@ -266,7 +282,7 @@ void ConsoleSingleton::Message( const char *pMsg, ... )
     vsnprintf(format, format_len, pMsg, namelessVars);\
     format[sizeof(format)-5] = '.';\
     va_end(namelessVars);\
-    if (connectionMode == Direct)\
+    if (connectionMode == Direct && !ConsoleOutput::isWorkerThread())\
         Notify##_type(format);\
     else\
         QCoreApplication::postEvent(ConsoleOutput::getInstance(), new ConsoleEvent(MsgType_##_type2, format));
@@ -24,11 +24,12 @@
 #include "PreCompiled.h"
 
 #include "FutureWatcherProgress.h"
+#include "Exception.h"
 
 using namespace Base;
 
 FutureWatcherProgress::FutureWatcherProgress(const char* text, unsigned int steps)
-  : seq(text, 100), steps(steps), current(0)
+  : seq(text, 100), steps(steps), current(0), aborted(false)
 {
 }
 
@@ -36,14 +37,32 @@ FutureWatcherProgress::~FutureWatcherProgress()
 {
 }
 
+void FutureWatcherProgress::setTextProvider(const std::function<std::string()>& func)
+{
+    textProvider = func;
+}
+
+bool FutureWatcherProgress::wasCanceled() const
+{
+    return aborted;
+}
+
 void FutureWatcherProgress::progressValueChanged(int v)
 {
-    if (steps == 0)
+    if (steps == 0 || aborted)
         return;
-    unsigned int step = (100 * v) / steps;
+    unsigned int step = static_cast<unsigned int>((100ull * v) / steps);
     if (step > current) {
         current = step;
-        seq.next();
+        if (textProvider)
+            seq.setText(textProvider().c_str());
+        try {
+            seq.next(true);
+        }
+        catch (const Base::AbortException&) {
+            aborted = true;
+            Q_EMIT canceled();
+        }
     }
 }
 
@@ -25,6 +25,8 @@
 #define BASE_FUTUREWATCHER_H
 
 #include <QObject>
+#include <functional>
+#include <string>
 #include <Base/Sequencer.h>
 
 namespace Base
@@ -38,12 +40,25 @@ public:
     FutureWatcherProgress(const char* text, unsigned int steps);
     ~FutureWatcherProgress();
 
+    /** Sets a function whose result is shown as progress text each time the
+     * progress advances. It's invoked from the thread that owns this object.
+     */
+    void setTextProvider(const std::function<std::string()>&);
+    /// Returns true if the user has canceled the operation
+    bool wasCanceled() const;
+
+Q_SIGNALS:
+    /// Emitted when the user cancels the operation, e.g. connect it with QFutureWatcher::cancel()
+    void canceled();
+
 private Q_SLOTS:
     void progressValueChanged(int v);
 
 private:
     Base::SequencerLauncher seq;
+    std::function<std::string()> textProvider;
     unsigned int steps, current;
+    bool aborted;
 };
 }
 
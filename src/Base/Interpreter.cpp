@@ -36,6 +36,7 @@
 #include "PyTools.h"
 #include "Exception.h"
 #include "PyObjectBase.h"
+#include "StartupTrace.h"
 #include <CXX/Extensions.hxx>
 
 #include "ExceptionFactory.h"
@@ -480,6 +481,7 @@ bool InterpreterSingleton::loadModule(const char* psModName)
     //PyBuf ModName(psModName);
     PyObject *module;
 
+    StartupTrace::Scope trace("module", psModName);
     PyGILStateLocker locker;
     module = PP_Load_Module(psModName);
 
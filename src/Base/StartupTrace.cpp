@@ -0,0 +1,161 @@
+/***************************************************************************
+ *   Copyright (c) 2020 FreeCAD Developers                                 *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <algorithm>
+# include <functional>
+# include <thread>
+#endif
+
+#include "StartupTrace.h"
+#include "Console.h"
+#include "FileInfo.h"
+#include "Stream.h"
+#include "Tools.h"
+
+using namespace Base;
+
+namespace {
+
+long long microSeconds(StartupTrace::Clock::duration d)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(d).count();
+}
+
+}
+
+StartupTrace& StartupTrace::instance()
+{
+    static StartupTrace trace;
+    return trace;
+}
+
+StartupTrace::StartupTrace()
+    : origin(Clock::now()), enabled(false)
+{
+}
+
+void StartupTrace::start(const std::string& file)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    fileName = file;
+    enabled = !file.empty();
+}
+
+int StartupTrace::threadIndex()
+{
+    std::size_t id = std::hash<std::thread::id>()(std::this_thread::get_id());
+    auto it = std::find(threads.begin(), threads.end(), id);
+    if (it != threads.end())
+        return static_cast<int>(it - threads.begin()) + 1;
+    threads.push_back(id);
+    return static_cast<int>(threads.size());
+}
+
+void StartupTrace::addEvent(const std::string& category, const std::string& name,
+                            Clock::time_point begin, Clock::time_point end)
+{
+    if (!enabled)
+        return;
+    std::lock_guard<std::mutex> lock(mutex);
+    events.push_back(Event{category, name, begin, end, threadIndex()});
+}
+
+void StartupTrace::begin(const std::string& category, const std::string& name)
+{
+    if (!enabled)
+        return;
+    std::lock_guard<std::mutex> lock(mutex);
+    openEvents.push_back(Event{category, name, Clock::now(), Clock::time_point(), threadIndex()});
+}
+
+void StartupTrace::end()
+{
+    if (!enabled)
+        return;
+    std::lock_guard<std::mutex> lock(mutex);
+    if (openEvents.empty())
+        return;
+    events.push_back(openEvents.back());
+    events.back().end = Clock::now();
+    openEvents.pop_back();
+}
+
+void StartupTrace::finish()
+{
+    if (!enabled)
+        return;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    enabled = false;
+
+    Clock::time_point now = Clock::now();
+    // events still open are cut off at the end of the startup
+    for (auto& event : openEvents) {
+        event.end = now;
+        events.push_back(event);
+    }
+    openEvents.clear();
+    events.push_back(Event{"startup", "startup", origin, now, 1});
+
+    Base::FileInfo fi(fileName);
+    Base::ofstream str(fi, std::ios::out | std::ios::trunc);
+    if (!str) {
+        Console().Warning("Cannot write startup trace to '%s'\n", fileName.c_str());
+    }
+    else {
+        str << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        for (std::size_t i = 0; i < events.size(); ++i) {
+            const Event& event = events[i];
+            str << "{\"name\":\"" << Tools::escapeEncodeJson(event.name)
+                << "\",\"cat\":\"" << Tools::escapeEncodeJson(event.category)
+                << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.thread
+                << ",\"ts\":" << microSeconds(event.begin - origin)
+                << ",\"dur\":" << microSeconds(event.end - event.begin) << "}"
+                << (i + 1 < events.size() ? ",\n" : "\n");
+        }
+        str << "]}\n";
+        Console().Log("Startup took %.3f s, trace written to '%s'\n",
+                      microSeconds(now - origin) / 1.0e6, fileName.c_str());
+    }
+
+    events.clear();
+    threads.clear();
+}
+
+// ----------------------------------------------------------------------------
+
+StartupTrace::Scope::Scope(const char* category, const char* name)
+    : category(category), name(name), active(StartupTrace::instance().isEnabled())
+{
+    if (active)
+        start = Clock::now();
+}
+
+StartupTrace::Scope::~Scope()
+{
+    if (active)
+        StartupTrace::instance().addEvent(category, name ? name : "", start, Clock::now());
+}
@@ -0,0 +1,113 @@
+/***************************************************************************
+ *   Copyright (c) 2020 FreeCAD Developers                                 *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef BASE_STARTUPTRACE_H
+#define BASE_STARTUPTRACE_H
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Base
+{
+
+/** Records the duration of the startup stages
+ *
+ * The tracer is enabled by setting the environment variable
+ * FREECAD_STARTUP_TRACE to the name of the file the trace is written to.
+ * Each stage, i.e. the configuration, the loading of a module library or the
+ * execution of an Init.py or InitGui.py script, is recorded as one event.
+ * Once the application is up the events are written in the trace event
+ * format of Chrome, which can be loaded into chrome://tracing or Perfetto.
+ *
+ * @code
+ * {
+ *     Base::StartupTrace::Scope scope("module", name);
+ *     ...
+ * }
+ * @endcode
+ */
+class BaseExport StartupTrace
+{
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    static StartupTrace& instance();
+
+    /// Starts recording, the events are written to \a file by finish()
+    void start(const std::string& file);
+    bool isEnabled() const {
+        return enabled;
+    }
+    /// Adds an event of the calling thread
+    void addEvent(const std::string& category, const std::string& name,
+                  Clock::time_point begin, Clock::time_point end);
+    /** Opens a nested event that is closed by end()
+     * This is meant for the Python side that cannot use Scope.
+     */
+    void begin(const std::string& category, const std::string& name);
+    void end();
+    /// Writes the trace file and stops recording
+    void finish();
+
+    /// Records the lifetime of the object as one event
+    class BaseExport Scope
+    {
+    public:
+        Scope(const char* category, const char* name);
+        ~Scope();
+
+    private:
+        const char* category;
+        const char* name;
+        Clock::time_point start;
+        bool active;
+    };
+
+private:
+    StartupTrace();
+
+    struct Event {
+        std::string category;
+        std::string name;
+        Clock::time_point begin;
+        Clock::time_point end;
+        int thread;
+    };
+
+    int threadIndex();
+
+    std::vector<Event> events;
+    std::vector<Event> openEvents;
+    std::vector<std::size_t> threads;
+    Clock::time_point origin;
+    std::string fileName;
+    std::atomic<bool> enabled;
+    std::mutex mutex;
+};
+
+} // namespace Base
+
+#endif // BASE_STARTUPTRACE_H
@@ -28,6 +28,7 @@
 # include <QByteArray>
 # include <QDataStream>
 # include <QIODevice>
+# include <algorithm>
 # include <cstdlib>
 # include <string>
 # include <cstdio>
@@ -144,10 +145,78 @@ OutputStream& OutputStream::operator << (double d)
     return *this;
 }
 
+namespace {
+/**
+ * Reverses the byte order of \a count values of \a size bytes in place.
+ * The loops are kept simple so that the compiler can vectorize them.
+ */
+void SwapBlock(void* data, std::size_t count, std::size_t size)
+{
+    switch (size) {
+    case 2: {
+        uint16_t* v = static_cast<uint16_t*>(data);
+        for (std::size_t i=0; i<count; i++)
+            v[i] = static_cast<uint16_t>((v[i] >> 8) | (v[i] << 8));
+        break;
+    }
+    case 4: {
+        uint32_t* v = static_cast<uint32_t*>(data);
+        for (std::size_t i=0; i<count; i++) {
+            uint32_t x = v[i];
+            v[i] = (x >> 24) | ((x >> 8) & 0x0000ff00u)
+                 | ((x << 8) & 0x00ff0000u) | (x << 24);
+        }
+        break;
+    }
+    case 8: {
+        uint64_t* v = static_cast<uint64_t*>(data);
+        for (std::size_t i=0; i<count; i++) {
+            uint64_t x = v[i];
+            x = (x << 32) | (x >> 32);
+            x = ((x & 0x0000ffff0000ffffull) << 16) | ((x >> 16) & 0x0000ffff0000ffffull);
+            x = ((x & 0x00ff00ff00ff00ffull) << 8) | ((x >> 8) & 0x00ff00ff00ff00ffull);
+            v[i] = x;
+        }
+        break;
+    }
+    default:
+        break;
+    }
+}
+}
+
+void OutputStream::writeBlock(const void* data, std::size_t count, std::size_t size)
+{
+    if (!_swap || size == 1) {
+        _out.write(static_cast<const char*>(data), static_cast<std::streamsize>(count * size));
+        return;
+    }
+
+    // swap a chunk at a time in a fixed buffer to leave the data untouched
+    uint64_t buffer[512];
+    const std::size_t chunk = sizeof(buffer) / size;
+    const char* src = static_cast<const char*>(data);
+    while (count > 0) {
+        std::size_t num = std::min(count, chunk);
+        memcpy(buffer, src, num * size);
+        SwapBlock(buffer, num, size);
+        _out.write(reinterpret_cast<const char*>(buffer), static_cast<std::streamsize>(num * size));
+        src += num * size;
+        count -= num;
+    }
+}
+
 InputStream::InputStream(std::istream &rin) : _in(rin)
 {
 }
 
+void InputStream::readBlock(void* data, std::size_t count, std::size_t size)
+{
+    _in.read(static_cast<char*>(data), static_cast<std::streamsize>(count * size));
+    if (_swap && size > 1)
+        SwapBlock(data, count, size);
+}
+
 InputStream::~InputStream()
 {
 }
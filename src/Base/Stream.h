@@ -29,11 +29,13 @@
 # include <stdint.h>
 #endif
 
+#include <cstddef>
 #include <fstream>
 #include <ios>
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <type_traits>
 #include <vector>
 #include "FileInfo.h"
 
@@ -81,7 +83,40 @@ public:
     OutputStream& operator << (float f);
     OutputStream& operator << (double d);
 
+    /** Writes \a count values stored contiguously at \a data with a single
+     *  call of the underlying stream. The byte order is only swapped if the
+     *  stream is big endian.
+     */
+    template<typename T>
+    OutputStream& write(const T* data, std::size_t count)
+    {
+        static_assert(std::is_arithmetic<T>::value, "Only arithmetic types are supported");
+        writeBlock(data, count, sizeof(T));
+        return *this;
+    }
+
+    /** Writes \a count values converted to type \a T, e.g. to save double
+     *  precision values in single precision. The values are converted in
+     *  chunks to avoid a temporary copy of the whole array.
+     */
+    template<typename T, typename S>
+    OutputStream& writeAs(const S* data, std::size_t count)
+    {
+        T buffer[1024];
+        while (count > 0) {
+            std::size_t num = count < 1024 ? count : 1024;
+            for (std::size_t i=0; i<num; i++)
+                buffer[i] = static_cast<T>(data[i]);
+            write(buffer, num);
+            data += num;
+            count -= num;
+        }
+        return *this;
+    }
+
 private:
+    void writeBlock(const void* data, std::size_t count, std::size_t size);
+
     OutputStream (const OutputStream&);
     void operator = (const OutputStream&);
 
@@ -111,6 +146,36 @@ public:
     InputStream& operator >> (float& f);
     InputStream& operator >> (double& d);
 
+    /** Reads \a count values into the contiguous array \a data with a single
+     *  call of the underlying stream. The byte order is only swapped if the
+     *  stream is big endian.
+     */
+    template<typename T>
+    InputStream& read(T* data, std::size_t count)
+    {
+        static_assert(std::is_arithmetic<T>::value, "Only arithmetic types are supported");
+        readBlock(data, count, sizeof(T));
+        return *this;
+    }
+
+    /** Reads \a count values stored as type \a T and converts them to the
+     *  type of \a data, e.g. to load values saved in single precision.
+     */
+    template<typename T, typename S>
+    InputStream& readAs(S* data, std::size_t count)
+    {
+        T buffer[1024];
+        while (count > 0) {
+            std::size_t num = count < 1024 ? count : 1024;
+            read(buffer, num);
+            for (std::size_t i=0; i<num; i++)
+                data[i] = static_cast<S>(buffer[i]);
+            data += num;
+            count -= num;
+        }
+        return *this;
+    }
+
     operator bool() const
     {
         // test if _Ipfx succeeded
@@ -118,6 +183,8 @@ public:
     }
 
 private:
+    void readBlock(void* data, std::size_t count, std::size_t size);
+
     InputStream (const InputStream&);
     void operator = (const InputStream&);
 
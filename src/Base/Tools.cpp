@@ -23,6 +23,7 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+# include <cstdio>
 # include <sstream>
 # include <locale>
 # include <iostream>
@@ -95,6 +96,51 @@ std::string Base::Tools::getUniqueName(const std::string& name, const std::vecto
     return str.str();
 }
 
+// ----------------------------------------------------------------------------
+
+void Base::UniqueNameTable::clear()
+{
+    suffixes.clear();
+}
+
+void Base::UniqueNameTable::reserve(std::size_t count)
+{
+    suffixes.reserve(count);
+}
+
+void Base::UniqueNameTable::addName(const std::string& name)
+{
+    // Each run of trailing digits is a suffix of the name without them, e.g.
+    // 'Box012' counts as '2' for 'Box01', '12' for 'Box0' and '012' for 'Box'
+    std::string::size_type pos = name.size();
+    while (pos > 0 && name[pos-1] >= '0' && name[pos-1] <= '9') {
+        --pos;
+        std::string suffix = name.substr(pos);
+        std::string& num_suffix = suffixes[name.substr(0, pos)];
+        if (Base::string_comp()(num_suffix, suffix))
+            num_suffix = suffix;
+    }
+}
+
+std::string Base::UniqueNameTable::getUniqueName(const std::string& prefix, int d) const
+{
+    std::string num_suffix;
+    auto it = suffixes.find(prefix);
+    if (it != suffixes.end())
+        num_suffix = it->second;
+
+    std::stringstream str;
+    str << prefix;
+    if (d > 0) {
+        str.fill('0');
+        str.width(d);
+    }
+    str << Base::string_comp::increment(num_suffix);
+    return str.str();
+}
+
+// ----------------------------------------------------------------------------
+
 std::string Base::Tools::addNumber(const std::string& name, unsigned int num, int d)
 {
     std::stringstream str;
@@ -227,6 +273,38 @@ std::string Base::Tools::escapeEncodeString(const std::string& s)
     return result;
 }
 
+std::string Base::Tools::escapeEncodeJson(const std::string& s)
+{
+    std::string result;
+    result.reserve(s.size());
+    for (char c : s) {
+        switch (c) {
+        case '\"':
+            result += "\\\"";
+            break;
+        case '\\':
+            result += "\\\\";
+            break;
+        case '\n':
+            result += "\\n";
+            break;
+        case '\t':
+            result += "\\t";
+            break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                char buf[8];
+                snprintf(buf, sizeof(buf), "\\u%04x", c);
+                result += buf;
+            }
+            else {
+                result += c;
+            }
+        }
+    }
+    return result;
+}
+
 QString Base::Tools::escapeEncodeFilename(const QString& s)
 {
     QString result;
@@ -30,6 +30,7 @@
 #include <iostream>
 #include <vector>
 #include <string>
+#include <unordered_map>
 #include <boost/signals2.hpp>
 #include <QString>
 #include <QObject>
@@ -289,6 +290,8 @@ struct BaseExport Tools
     static std::string escapeEncodeString(const std::string& s);
     static QString escapeEncodeFilename(const QString& s);
     static std::string escapeEncodeFilename(const std::string& s);
+    /// Escapes the string to be used inside the quotes of a JSON string
+    static std::string escapeEncodeJson(const std::string& s);
 
     /**
      * @brief toStdString Convert a QString into a UTF-8 encoded std::string.
@@ -305,6 +308,26 @@ struct BaseExport Tools
     static inline QString fromStdString(const std::string & s) { return QString::fromUtf8(s.c_str(), s.size()); }
 };
 
+// ----------------------------------------------------------------------------
+
+/** Table of the highest numeric suffix used for each name prefix
+ *
+ * getUniqueName() gives the same result as Tools::getUniqueName() called with
+ * all the names added so far, but without scanning them. Names cannot be
+ * removed, so a suffix becoming free is not reused until the table is cleared.
+ */
+class BaseExport UniqueNameTable
+{
+public:
+    void clear();
+    void reserve(std::size_t count);
+    void addName(const std::string& name);
+    std::string getUniqueName(const std::string& prefix, int d=0) const;
+
+private:
+    std::unordered_map<std::string, std::string> suffixes;
+};
+
 
 } // namespace Base
 
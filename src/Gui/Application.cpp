@@ -55,6 +55,7 @@
 #include <Base/Console.h>
 #include <Base/Interpreter.h>
 #include <Base/Parameter.h>
+#include <Base/StartupTrace.h>
 #include <Base/Exception.h>
 #include <Base/Factory.h>
 #include <Base/FileInfo.h>
@@ -1835,6 +1836,7 @@ void Application::initOpenInventor(void)
 
 void Application::runInitGuiScript(void)
 {
+    Base::StartupTrace::Scope trace("script", "FreeCADGuiInit.py");
     Base::Interpreter().runString(Base::ScriptFactory().ProduceScript("FreeCADGuiInit"));
 }
 
@@ -2163,7 +2165,10 @@ void Application::runApplication(void)
     // Call this before showing the main window because otherwise:
     // 1. it shows a white window for a few seconds which doesn't look nice
     // 2. the layout of the toolbars is completely broken
-    app.activateWorkbench(start.c_str());
+    {
+        Base::StartupTrace::Scope trace("workbench", start.c_str());
+        app.activateWorkbench(start.c_str());
+    }
 
     // show the main window
     if (!hidden) {
@@ -2196,6 +2201,8 @@ void Application::runApplication(void)
     // gets called once we start the event loop
     QTimer::singleShot(0, &mw, SLOT(delayedStartup()));
 
+    Base::StartupTrace::instance().finish();
+
     // run the Application event loop
     Base::Console().Log("Init: Entering event loop\n");
 
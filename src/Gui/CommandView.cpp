@@ -2659,6 +2659,9 @@ static void selectionCallback(void * ud, SoEventCallback * cb)
     if (doc) {
         cb->setHandled();
 
+        // report the selected elements in one go
+        SelectionBatch batch;
+
         const SoEvent* ev = cb->getEvent();
         if (ev && !ev->wasCtrlDown()) {
             Gui::Selection().clearSelection(doc->getName());
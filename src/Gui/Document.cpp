@@ -113,6 +113,7 @@ struct DocumentP
 
     typedef boost::signals2::connection Connection;
     Connection connectNewObject;
+    Connection connectNewObjects;
     Connection connectDelObject;
     Connection connectCngObject;
     Connection connectRenObject;
@@ -167,6 +168,8 @@ Document::Document(App::Document* pcDocument,Application * app)
     // Setup the connections
     d->connectNewObject = pcDocument->signalNewObject.connect
         (boost::bind(&Gui::Document::slotNewObject, this, bp::_1));
+    d->connectNewObjects = pcDocument->signalNewObjects.connect
+        (boost::bind(&Gui::Document::slotNewObjects, this, bp::_1));
     d->connectDelObject = pcDocument->signalDeletedObject.connect
         (boost::bind(&Gui::Document::slotDeletedObject, this, bp::_1));
     d->connectCngObject = pcDocument->signalChangedObject.connect
@@ -234,6 +237,7 @@ Document::~Document()
     // disconnect everything to avoid to be double-deleted
     // in case an exception is raised somewhere
     d->connectNewObject.disconnect();
+    d->connectNewObjects.disconnect();
     d->connectDelObject.disconnect();
     d->connectCngObject.disconnect();
     d->connectRenObject.disconnect();
@@ -713,12 +717,19 @@ void Document::slotNewObject(const App::DocumentObject& Obj)
     }
 
     if (pcProvider) {
-        std::list<Gui::BaseView*>::iterator vIt;
-        // cycling to all views of the document
-        for (vIt = d->baseViews.begin();vIt != d->baseViews.end();++vIt) {
-            View3DInventor *activeView = dynamic_cast<View3DInventor *>(*vIt);
-            if (activeView)
-                activeView->getViewer()->addViewProvider(pcProvider);
+        // When bulk inserting, the view provider is added to the 3D views in
+        // slotNewObjects() together with all the other new objects. Otherwise
+        // most of them would be added to the scene just to be removed again
+        // once their parent claims them.
+        bool bulk = Obj.getDocument()->testStatus(App::Document::BulkInsert);
+        if (!bulk) {
+            std::list<Gui::BaseView*>::iterator vIt;
+            // cycling to all views of the document
+            for (vIt = d->baseViews.begin();vIt != d->baseViews.end();++vIt) {
+                View3DInventor *activeView = dynamic_cast<View3DInventor *>(*vIt);
+                if (activeView)
+                    activeView->getViewer()->addViewProvider(pcProvider);
+            }
         }
 
         // adding to the tree
@@ -726,13 +737,53 @@ void Document::slotNewObject(const App::DocumentObject& Obj)
         pcProvider->pcDocument = this;
 
         // it is possible that a new viewprovider already claims children
-        handleChildren3D(pcProvider);
+        if (!bulk)
+            handleChildren3D(pcProvider);
         if (d->_isTransacting) {
             d->_redoViewProviders.push_back(pcProvider);
         }
     }
 }
 
+void Document::slotNewObjects(const std::vector<App::DocumentObject*> &objs)
+{
+    std::vector<ViewProviderDocumentObject*> vps;
+    vps.reserve(objs.size());
+    for (auto obj : objs) {
+        auto it = d->_ViewProviderMap.find(obj);
+        if (it != d->_ViewProviderMap.end())
+            vps.push_back(it->second);
+    }
+    if (vps.empty())
+        return;
+
+    // let the new view providers claim their children first, none of them
+    // is in the 3D views yet
+    for (auto vp : vps)
+        handleChildren3D(vp);
+
+    // collect all claimed nodes including those claimed by existing objects
+    std::set<SoNode*> claimed;
+    for (auto &v : d->_ViewProviderMap) {
+        SoGroup *childGroup = v.second->getChildRoot();
+        if (!childGroup)
+            continue;
+        for (int i=0, count=childGroup->getNumChildren(); i<count; ++i)
+            claimed.insert(childGroup->getChild(i));
+    }
+
+    for (auto view : d->baseViews) {
+        View3DInventor *activeView = dynamic_cast<View3DInventor *>(view);
+        if (!activeView)
+            continue;
+        auto viewer = activeView->getViewer();
+        for (auto vp : vps) {
+            if (!claimed.count(vp->getRoot()) && !viewer->hasViewProvider(vp))
+                viewer->addViewProvider(vp);
+        }
+    }
+}
+
 void Document::slotDeletedObject(const App::DocumentObject& Obj)
 {
     std::list<Gui::BaseView*>::iterator vIt;
@@ -119,6 +119,7 @@ def InitApplications():
         if ((Dir != '') & (Dir != 'CVS') & (Dir != '__init__.py')):
             InstallFile = os.path.join(Dir,"InitGui.py")
             if (os.path.exists(InstallFile)):
+                FreeCAD.beginStartupTrace("InitGui.py", InstallFile)
                 try:
                     # XXX: This looks scary securitywise...
                     with open(InstallFile) as f:
@@ -132,6 +133,8 @@ def InitApplications():
                     Err('Please look into the log file for further information\n')
                 else:
                     Log('Init:      Initializing ' + Dir + '... done\n')
+                finally:
+                    FreeCAD.endStartupTrace()
             else:
                 Log('Init:      Initializing ' + Dir + '(InitGui.py not found)... ignore\n')
 
@@ -144,6 +147,7 @@ def InitApplications():
         for _, freecad_module_name, freecad_module_ispkg in pkgutil.iter_modules(freecad.__path__, "freecad."):
             if freecad_module_ispkg:
                 Log('Init: Initializing ' + freecad_module_name + '\n')
+                FreeCAD.beginStartupTrace("init_gui", freecad_module_name)
                 try:
                     freecad_module = importlib.import_module(freecad_module_name)
                     if any (module_name == 'init_gui' for _, module_name, ispkg in pkgutil.iter_modules(freecad_module.__path__)):
@@ -160,6 +164,8 @@ def InitApplications():
                     Log('-'*80+'\n')
                     Log(traceback.format_exc())
                     Log('-'*80+'\n')
+                finally:
+                    FreeCAD.endStartupTrace()
     except ImportError as inst:
         Err('During initialization the error "' + str(inst) + '" occurred\n')
 
@@ -85,14 +85,14 @@ bool SelectionGateFilterExternal::allow(App::Document *doc ,App::DocumentObject
 //////////////////////////////////////////////////////////////////////////////////////////
 
 SelectionObserver::SelectionObserver(bool attach,int resolve)
-    :resolve(resolve),blockSelection(false)
+    :resolve(resolve),blockSelection(false),batchDelivery(false)
 {
     if(attach)
         attachSelection();
 }
 
 SelectionObserver::SelectionObserver(const ViewProviderDocumentObject *vp,bool attach,int resolve)
-    :resolve(resolve),blockSelection(false)
+    :resolve(resolve),blockSelection(false),batchDelivery(false)
 {
     if(vp && vp->getObject() && vp->getObject()->getDocument()) {
         filterDocName = vp->getObject()->getDocument()->getName();
@@ -136,6 +136,8 @@ void SelectionObserver::attachSelection()
                 Selection().signalSelectionChanged);
         connectSelection = signal.connect(boost::bind
             (&SelectionObserver::_onSelectionChanged, this, bp::_1));
+        connectBatch = Selection().signalSelectionBatch.connect(boost::bind
+            (&SelectionObserver::_onSelectionBatch, this));
         if(filterDocName.size())
             Selection().addSelectionGate(
                     new SelectionGateFilterExternal(filterDocName.c_str(),filterObjName.c_str()));
@@ -146,7 +148,42 @@ void SelectionObserver::_onSelectionChanged(const SelectionChanges& msg) {
     try {
         if (blockSelection)
             return;
+        if (batchDelivery && Selection().isDispatchingBatch()) {
+            batchChanges.push_back(msg);
+            batchChanges.back().pOriginalMsg = 0;
+            return;
+        }
+        onSelectionChanged(msg);
+    } catch (Base::Exception &e) {
+        e.ReportException();
+        FC_ERR("Unhandled Base::Exception caught in selection observer: ");
+    } catch (std::exception &e) {
+        FC_ERR("Unhandled std::exception caught in selection observer: " << e.what());
+    } catch (...) {
+        FC_ERR("Unhandled unknown exception caught in selection observer");
+    }
+}
+
+void SelectionObserver::setBatchDelivery(bool enable)
+{
+    batchDelivery = enable;
+    if (!enable)
+        batchChanges.clear();
+}
+
+void SelectionObserver::onSelectionBatch(const std::vector<SelectionChanges>& msgs)
+{
+    for (auto &msg : msgs)
         onSelectionChanged(msg);
+}
+
+void SelectionObserver::_onSelectionBatch() {
+    if (batchChanges.empty())
+        return;
+    std::vector<SelectionChanges> msgs;
+    msgs.swap(batchChanges);
+    try {
+        onSelectionBatch(msgs);
     } catch (Base::Exception &e) {
         e.ReportException();
         FC_ERR("Unhandled Base::Exception caught in selection observer: ");
@@ -159,6 +196,8 @@ void SelectionObserver::_onSelectionChanged(const SelectionChanges& msg) {
 
 void SelectionObserver::detachSelection()
 {
+    batchChanges.clear();
+    connectBatch.disconnect();
     if (connectSelection.connected()) {
         connectSelection.disconnect();
         if(filterDocName.size())
@@ -568,6 +607,20 @@ void SelectionSingleton::enablePickedList(bool enable) {
 }
 
 void SelectionSingleton::notify(SelectionChanges &&Chng) {
+    if(batchDepth>0) {
+        switch(Chng.Type) {
+        case SelectionChanges::SetPreselect:
+        case SelectionChanges::RmvPreselect:
+        case SelectionChanges::SetPreselectSignal:
+        case SelectionChanges::RmvPreselectSignal:
+        case SelectionChanges::MovePreselect:
+            // pre-selection is not part of the batch
+            break;
+        default:
+            BatchQueue.push_back(std::move(Chng));
+            return;
+        }
+    }
     if(Notifying) {
         NotificationQueue.push_back(std::move(Chng));
         return;
@@ -602,6 +655,74 @@ void SelectionSingleton::notify(SelectionChanges &&Chng) {
     }
 }
 
+int SelectionSingleton::beginBatch() {
+    return ++batchDepth;
+}
+
+int SelectionSingleton::endBatch() {
+    if(batchDepth<=0)
+        return 0;
+    if(--batchDepth)
+        return batchDepth;
+
+    std::deque<SelectionChanges> queue;
+    queue.swap(BatchQueue);
+
+    // Only keep the last change of each element. Set and clear messages
+    // are kept in order, as they reset what the observers know.
+    std::vector<bool> skip(queue.size(),false);
+    std::unordered_set<std::string> changed;
+    bool pickedListChanged = false;
+    for(int i=(int)queue.size()-1;i>=0;--i) {
+        const auto &msg = queue[i];
+        switch(msg.Type) {
+        case SelectionChanges::AddSelection:
+        case SelectionChanges::RmvSelection: {
+            std::ostringstream ss;
+            ss << msg.pDocName << '#' << msg.pObjectName << '.' << msg.pSubName;
+            if(!changed.insert(ss.str()).second)
+                skip[i] = true;
+            break;
+        }
+        case SelectionChanges::SetSelection:
+        case SelectionChanges::ClrSelection:
+            changed.clear();
+            break;
+        case SelectionChanges::PickedListChanged:
+            if(pickedListChanged)
+                skip[i] = true;
+            pickedListChanged = true;
+            break;
+        default:
+            break;
+        }
+    }
+
+    FC_LOG("Selection batch with " << queue.size() << " changes");
+
+    {
+        Base::FlagToggler<bool> flag(batchDispatching);
+        for(std::size_t i=0;i<queue.size();++i) {
+            if(!skip[i])
+                notify(std::move(queue[i]));
+        }
+    }
+    signalSelectionBatch();
+
+    if(batchUpdateActions) {
+        batchUpdateActions = false;
+        getMainWindow()->updateActions();
+    }
+    return 0;
+}
+
+void SelectionSingleton::updateActions() {
+    if(batchDepth>0)
+        batchUpdateActions = true;
+    else
+        getMainWindow()->updateActions();
+}
+
 bool SelectionSingleton::hasPickedList() const {
     return _PickedList.size();
 }
@@ -1016,6 +1137,17 @@ void SelectionSingleton::_SelObj::log(bool remove, bool clearPreselect) {
     Application::Instance->macroManager()->addLine(MacroManager::Cmt, ss.str().c_str());
 }
 
+std::string SelectionSingleton::_SelObj::key() const {
+    std::string res;
+    res.reserve(DocName.size()+FeatName.size()+SubName.size()+2);
+    res += DocName;
+    res += '#';
+    res += FeatName;
+    res += '.';
+    res += SubName;
+    return res;
+}
+
 bool SelectionSingleton::addSelection(const char* pDocName, const char* pObjectName, 
         const char* pSubName, float x, float y, float z, 
         const std::vector<SelObj> *pickedList, bool clearPreselect)
@@ -1073,6 +1205,7 @@ bool SelectionSingleton::addSelection(const char* pDocName, const char* pObjectN
         temp.log(false,clearPreselect);
 
     _SelList.push_back(temp);
+    _SelIndex.insert(temp.key());
     _SelStackForward.clear();
 
     if(clearPreselect)
@@ -1086,7 +1219,7 @@ bool SelectionSingleton::addSelection(const char* pDocName, const char* pObjectN
 
     notify(std::move(Chng));
 
-    getMainWindow()->updateActions();
+    updateActions();
 
     rmvPreselect(true);
 
@@ -1122,6 +1255,7 @@ void SelectionSingleton::selStackGoBack(int count) {
         count = _SelStackBack.size();
     if(count<=0)
         return;
+    SelectionBatch batch;
     if(_SelList.size()) {
         selStackPush(false,true);
         clearCompleteSelection();
@@ -1149,7 +1283,7 @@ void SelectionSingleton::selStackGoBack(int count) {
         _SelStackBack.pop_back();
     }
     _SelStackForward = std::move(tmpStack);
-    getMainWindow()->updateActions();
+    updateActions();
 }
 
 void SelectionSingleton::selStackGoForward(int count) {
@@ -1157,6 +1291,7 @@ void SelectionSingleton::selStackGoForward(int count) {
         count = _SelStackForward.size();
     if(count<=0)
         return;
+    SelectionBatch batch;
     if(_SelList.size()) {
         selStackPush(false,true);
         clearCompleteSelection();
@@ -1183,7 +1318,7 @@ void SelectionSingleton::selStackGoForward(int count) {
         tmpStack.pop_front();
     }
     _SelStackForward = std::move(tmpStack);
-    getMainWindow()->updateActions();
+    updateActions();
 }
 
 std::vector<SelectionObject> SelectionSingleton::selStackGet(
@@ -1225,6 +1360,7 @@ bool SelectionSingleton::addSelections(const char* pDocName, const char* pObject
         notify(SelectionChanges(SelectionChanges::PickedListChanged));
     }
 
+    SelectionBatch batch;
     bool update = false;
     for(std::vector<std::string>::const_iterator it = pSubNames.begin(); it != pSubNames.end(); ++it) {
         _SelObj temp;
@@ -1237,6 +1373,7 @@ bool SelectionSingleton::addSelections(const char* pDocName, const char* pObject
         temp.z        = 0;
 
         _SelList.push_back(temp);
+        _SelIndex.insert(temp.key());
         _SelStackForward.clear();
 
         SelectionChanges Chng(SelectionChanges::AddSelection,
@@ -1249,7 +1386,7 @@ bool SelectionSingleton::addSelections(const char* pDocName, const char* pObject
     }
 
     if(update)
-        getMainWindow()->updateActions();
+        updateActions();
     return true;
 }
 
@@ -1288,6 +1425,7 @@ bool SelectionSingleton::addSelection(const SelectionObject& obj,bool clearPrese
 {
     const std::vector<std::string>& subNames = obj.getSubNames();
     const std::vector<Base::Vector3d> points = obj.getPickedPoints();
+    SelectionBatch batch;
     if (!subNames.empty() && subNames.size() == points.size()) {
         bool ok = true;
         for (std::size_t i=0; i<subNames.size(); i++) {
@@ -1361,6 +1499,7 @@ void SelectionSingleton::rmvSelection(const char* pDocName, const char* pObjectN
                 It->DocName,It->FeatName,It->SubName,It->TypeName);
 
         // destroy the _SelObj item
+        _SelIndex.erase(It->key());
         _SelList.erase(It);
     }
 
@@ -1370,11 +1509,12 @@ void SelectionSingleton::rmvSelection(const char* pDocName, const char* pObjectN
     // behaviour.
     // So, the notification is done after the loop, see also #0003469
     if(changes.size()) {
+        SelectionBatch batch;
         for(auto &Chng : changes) {
             FC_LOG("Rmv Selection "<<Chng.pDocName<<'#'<<Chng.pObjectName<<'.'<<Chng.pSubName);
             notify(std::move(Chng));
         }
-        getMainWindow()->updateActions();
+        updateActions();
     }
 }
 
@@ -1497,12 +1637,13 @@ void SelectionSingleton::setSelection(const char* pDocName, const std::vector<Ap
             continue;
         touched = true;
         _SelList.push_back(temp);
+        _SelIndex.insert(temp.key());
     }
 
     if(touched) {
         _SelStackForward.clear();
         notify(SelectionChanges(SelectionChanges::SetSelection,pDocName));
-        getMainWindow()->updateActions();
+        updateActions();
     }
 }
 
@@ -1532,6 +1673,7 @@ void SelectionSingleton::clearSelection(const char* pDocName, bool clearPreSelec
         for (auto it=_SelList.begin();it!=_SelList.end();) {
             if (it->DocName == docName) {
                 touched = true;
+                _SelIndex.erase(it->key());
                 it = _SelList.erase(it);
             }
             else {
@@ -1553,7 +1695,7 @@ void SelectionSingleton::clearSelection(const char* pDocName, bool clearPreSelec
 
         notify(SelectionChanges(SelectionChanges::ClrSelection,docName.c_str()));
 
-        getMainWindow()->updateActions();
+        updateActions();
     }
 }
 
@@ -1576,13 +1718,14 @@ void SelectionSingleton::clearCompleteSelection(bool clearPreSelect)
                               :"Gui.Selection.clearSelection(False)");
 
     _SelList.clear();
+    _SelIndex.clear();
 
     SelectionChanges Chng(SelectionChanges::ClrSelection);
 
     FC_LOG("Clear selection");
 
     notify(std::move(Chng));
-    getMainWindow()->updateActions();
+    updateActions();
 }
 
 bool SelectionSingleton::isSelected(const char* pDocName, 
@@ -1658,12 +1801,24 @@ int SelectionSingleton::checkSelection(const char *pDocName, const char *pObject
     if(!pSubName)
         pSubName = "";
 
-    for (auto &s : *selList) {
-        if (s.DocName==pDocName && s.FeatName==sel.FeatName) {
-            if(s.SubName==pSubName)
-                return 1;
-            if(resolve>1 && boost::starts_with(s.SubName,prefix))
-                return 1;
+    if(selList == &_SelList) {
+        std::string key(pDocName);
+        key += '#';
+        key += sel.FeatName;
+        key += '.';
+        key += pSubName;
+        if(_SelIndex.count(key))
+            return 1;
+    }
+
+    if(selList != &_SelList || resolve>1) {
+        for (auto &s : *selList) {
+            if (s.DocName==pDocName && s.FeatName==sel.FeatName) {
+                if(s.SubName==pSubName)
+                    return 1;
+                if(resolve>1 && boost::starts_with(s.SubName,prefix))
+                    return 1;
+            }
         }
     }
     if(resolve==1) {
@@ -1715,15 +1870,17 @@ void SelectionSingleton::slotDeletedObject(const App::DocumentObject& Obj)
         if(it->pResolvedObject == &Obj || it->pObject==&Obj) {
             changes.emplace_back(SelectionChanges::RmvSelection,
                     it->DocName,it->FeatName,it->SubName,it->TypeName);
+            _SelIndex.erase(it->key());
             _SelList.erase(it);
         }
     }
     if(changes.size()) {
+        SelectionBatch batch;
         for(auto &Chng : changes) {
             FC_LOG("Rmv Selection "<<Chng.pDocName<<'#'<<Chng.pObjectName<<'.'<<Chng.pSubName);
             notify(std::move(Chng));
         }
-        getMainWindow()->updateActions();
+        updateActions();
     }
 
     if(_PickedList.size()) {
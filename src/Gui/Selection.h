@@ -31,6 +31,7 @@
 #include <list>
 #include <map>
 #include <deque>
+#include <unordered_set>
 #include <boost/signals2.hpp>
 #include <CXX/Objects.hxx>
 
@@ -240,17 +241,36 @@ public:
     /** Detaches from the selection. */
     void detachSelection();
 
+    /** Enables batch delivery
+     *
+     * If enabled, the changes of a selection batch (see SelectionBatch) are
+     * collected and passed in one call to onSelectionBatch() once the batch
+     * has been dispatched, instead of one call of onSelectionChanged() for
+     * each change.
+     */
+    void setBatchDelivery(bool enable);
+    bool hasBatchDelivery() const {return batchDelivery;}
+
 private:
     virtual void onSelectionChanged(const SelectionChanges& msg) = 0;
+    /** Called with all the changes of a selection batch if batch delivery is
+     * enabled. The default implementation calls onSelectionChanged() for each
+     * change. Note that SelectionChanges::pOriginalMsg is not kept.
+     */
+    virtual void onSelectionBatch(const std::vector<SelectionChanges>& msgs);
     void _onSelectionChanged(const SelectionChanges& msg);
+    void _onSelectionBatch();
 
 private:
     typedef boost::signals2::connection Connection;
     Connection connectSelection;
+    Connection connectBatch;
     std::string filterDocName;
     std::string filterObjName;
     int resolve;
     bool blockSelection;
+    bool batchDelivery;
+    std::vector<SelectionChanges> batchChanges;
 };
 
 /**
@@ -474,6 +494,30 @@ public:
     boost::signals2::signal<void (const SelectionChanges& msg)> signalSelectionChanged2;
     /// signal on selection change with resolved object and sub element map
     boost::signals2::signal<void (const SelectionChanges& msg)> signalSelectionChanged3;
+    /// signal after all the changes of a selection batch have been dispatched
+    boost::signals2::signal<void ()> signalSelectionBatch;
+
+    /** Starts a selection batch
+     *
+     * Until the matching endBatch(), selection changes are only recorded.
+     * The changes are then coalesced, e.g. an element that is added and
+     * removed again only reports its last change, and dispatched in one go.
+     * Observers may opt in to receive them as a single batch, see
+     * SelectionObserver::setBatchDelivery(). Batches can be nested.
+     *
+     * @return the current nesting level
+     */
+    int beginBatch();
+    /** Ends a selection batch
+     *
+     * @return the remaining nesting level, the changes are dispatched when
+     * reaching zero.
+     */
+    int endBatch();
+    /// Checks whether a selection batch is open
+    bool isBatching() const {return batchDepth>0;}
+    /// Checks whether the changes of a selection batch are being dispatched
+    bool isDispatchingBatch() const {return batchDispatching;}
 
     /** Returns a vector of selection objects
      *
@@ -699,8 +743,11 @@ protected:
         App::DocumentObject* pResolvedObject = 0;
 
         void log(bool remove=false, bool clearPreselect=true);
+        std::string key() const;
     };
     mutable std::list<_SelObj> _SelList;
+    /// Keys of all the items in _SelList for fast lookup, see _SelObj::key()
+    std::unordered_set<std::string> _SelIndex;
 
     mutable std::list<_SelObj> _PickedList;
     bool _needPickedList;
@@ -729,6 +776,12 @@ protected:
 
     int logDisabled = 0;
     bool logHasSelection = false;
+
+    int batchDepth = 0;
+    bool batchDispatching = false;
+    bool batchUpdateActions = false;
+    std::deque<SelectionChanges> BatchQueue;
+    void updateActions();
 };
 
 /**
@@ -765,6 +818,22 @@ private:
     bool silent;
 };
 
+/** Helper class to group selection changes into a batch
+ *
+ * The changes made to the selection during the lifetime of this object are
+ * dispatched together when it is destroyed.
+ * @see SelectionSingleton::beginBatch()
+ */
+class GuiExport SelectionBatch {
+public:
+    SelectionBatch() {
+        Selection().beginBatch();
+    }
+    ~SelectionBatch() {
+        Selection().endBatch();
+    }
+};
+
 } //namespace Gui
 
 #endif // GUI_SELECTION_H
@@ -113,6 +113,7 @@ SelectionView::SelectionView(Gui::Document* pcDocument, QWidget *parent)
     connect(selectionView, SIGNAL(customContextMenuRequested(QPoint)), this, SLOT(onItemContextMenu(QPoint)));
     connect(enablePickList, SIGNAL(stateChanged(int)), this, SLOT(onEnablePickList()));
 
+    setBatchDelivery(true);
 }
 
 SelectionView::~SelectionView()
@@ -258,6 +259,35 @@ void SelectionView::onSelectionChanged(const SelectionChanges &Reason)
     countLabel->setText(QString::number(selectionView->count()));
 }
 
+void SelectionView::onSelectionBatch(const std::vector<SelectionChanges> &msgs)
+{
+    // Looking up the list item of each change gets slow for big batches,
+    // rebuilding the list from the current selection is cheaper then.
+    bool rebuild = false;
+    for (const auto &msg : msgs) {
+        switch (msg.Type) {
+        case SelectionChanges::AddSelection:
+        case SelectionChanges::RmvSelection:
+        case SelectionChanges::SetSelection:
+        case SelectionChanges::ClrSelection:
+            if (msgs.size() > 10) {
+                rebuild = true;
+                break;
+            }
+            // fall through
+        default:
+            onSelectionChanged(msg);
+            break;
+        }
+    }
+
+    if (rebuild) {
+        selectionView->setUpdatesEnabled(false);
+        onSelectionChanged(SelectionChanges(SelectionChanges::SetSelection, "*"));
+        selectionView->setUpdatesEnabled(true);
+    }
+}
+
 void SelectionView::search(const QString& text)
 {
     if (!text.isEmpty()) {
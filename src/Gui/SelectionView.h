@@ -63,6 +63,8 @@ public:
 
     /// Observer message from the Selection
     virtual void onSelectionChanged(const SelectionChanges& msg) override;
+    /// Observer messages of a selection batch
+    virtual void onSelectionBatch(const std::vector<SelectionChanges>& msgs) override;
 
     virtual void leaveEvent(QEvent*) override;
 
@@ -56,6 +56,7 @@
 #include "Inventor/MarkerBitmaps.h"
 #include "Inventor/SmSwitchboard.h"
 #include "SoFCCSysDragger.h"
+#include "SoFCInstanceArray.h"
 
 #include "propertyeditor/PropertyItem.h"
 #include "NavigationStyle.h"
@@ -125,6 +126,8 @@ void Gui::SoFCDB::init()
     SoFCSeparator                   ::initClass();
     SoFCSelectionRoot               ::initClass();
     SoFCPathAnnotation              ::initClass();
+    SoFCInstanceArray               ::initClass();
+    SoFCInstanceDetail              ::initClass();
 
     PropertyItem                    ::init();
     PropertySeparatorItem           ::init();
@@ -210,6 +213,7 @@ void Gui::SoFCDB::finish()
     SoFCSeparator                   ::finish();
     SoFCSelectionRoot               ::finish();
     SoFCPathAnnotation              ::finish();
+    SoFCInstanceArray               ::finish();
     
     storage->unref();
     storage = nullptr;
@@ -0,0 +1,259 @@
+/***************************************************************************
+ *   Copyright (c) 2020 FreeCAD Developers                                 *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <Inventor/SbBox3f.h>
+# include <Inventor/SoPath.h>
+# include <Inventor/SoPickedPoint.h>
+# include <Inventor/actions/SoCallbackAction.h>
+# include <Inventor/actions/SoGLRenderAction.h>
+# include <Inventor/actions/SoGetBoundingBoxAction.h>
+# include <Inventor/actions/SoGetPrimitiveCountAction.h>
+# include <Inventor/actions/SoRayPickAction.h>
+# include <Inventor/elements/SoLocalBBoxMatrixElement.h>
+# include <Inventor/elements/SoModelMatrixElement.h>
+# include <Inventor/misc/SoChildList.h>
+# include <Inventor/misc/SoState.h>
+#endif
+
+#include "SoFCInstanceArray.h"
+
+using namespace Gui;
+
+SO_DETAIL_SOURCE(SoFCInstanceDetail)
+
+SoFCInstanceDetail::SoFCInstanceDetail(int index)
+    :index(index)
+{
+}
+
+SoFCInstanceDetail::~SoFCInstanceDetail()
+{
+}
+
+void SoFCInstanceDetail::initClass(void)
+{
+    SO_DETAIL_INIT_CLASS(SoFCInstanceDetail, SoDetail);
+}
+
+SoDetail *SoFCInstanceDetail::copy(void) const
+{
+    return new SoFCInstanceDetail(index);
+}
+
+// ---------------------------------------------------------------
+
+SO_NODE_SOURCE(SoFCInstanceArray)
+
+SoFCInstanceArray::SoFCInstanceArray()
+{
+    SO_NODE_CONSTRUCTOR(SoFCInstanceArray);
+
+    SO_NODE_ADD_FIELD(matrices, (SbMatrix::identity()));
+    matrices.setNum(0);
+    matrices.setDefault(TRUE);
+}
+
+SoFCInstanceArray::~SoFCInstanceArray()
+{
+}
+
+void SoFCInstanceArray::initClass(void)
+{
+    SO_NODE_INIT_CLASS(SoFCInstanceArray,SoGroup,"Group");
+}
+
+void SoFCInstanceArray::finish()
+{
+    atexit_cleanup();
+}
+
+void SoFCInstanceArray::setExcluded(int index, bool exclude)
+{
+    bool changed;
+    if(exclude)
+        changed = excluded.insert(index).second;
+    else
+        changed = excluded.erase(index)>0;
+    if(changed)
+        touch();
+}
+
+bool SoFCInstanceArray::isExcluded(int index) const
+{
+    return excluded.count(index)>0;
+}
+
+void SoFCInstanceArray::clearExcluded(int from)
+{
+    auto it = excluded.lower_bound(from);
+    if(it == excluded.end())
+        return;
+    excluded.erase(it,excluded.end());
+    touch();
+}
+
+bool SoFCInstanceArray::isInstancedPath(const SoPath *path)
+{
+    if(!path)
+        return false;
+    for(int i=0,count=path->getLength();i<count;++i) {
+        SoNode *node = path->getNode(i);
+        if(node && node->isOfType(SoFCInstanceArray::getClassTypeId()))
+            return true;
+    }
+    return false;
+}
+
+void SoFCInstanceArray::traverseInstances(SoAction *action, SoRayPickAction *pickAction)
+{
+    int numindices;
+    const int *indices;
+    SoAction::PathCode pathcode = action->getPathCode(numindices, indices);
+    // The children are expected to be separators, so there is nothing to do
+    // for traversal off the path.
+    if(pathcode == SoAction::OFF_PATH)
+        return;
+
+    SoState *state = action->getState();
+    const SbMatrix *mats = matrices.getValues(0);
+    auto itExcluded = excluded.begin();
+    for(int i=0,count=matrices.getNum();i<count;++i) {
+        if(itExcluded!=excluded.end() && *itExcluded==i) {
+            ++itExcluded;
+            continue;
+        }
+        state->push();
+        SoModelMatrixElement::mult(state, this, mats[i]);
+        if(pathcode == SoAction::IN_PATH)
+            children->traverseInPath(action, numindices, indices);
+        else
+            children->traverse(action);
+        state->pop();
+
+        if(pickAction) {
+            // Tag the newly picked points with the instance index, because
+            // their paths are the same for all instances.
+            const SoPickedPointList &pps = pickAction->getPickedPointList();
+            for(int j=0,c=pps.getLength();j<c;++j) {
+                SoPickedPoint *pp = pps[j];
+                if(!pp->getPath()->containsNode(this) || pp->getDetail(this))
+                    continue;
+                pp->setDetail(new SoFCInstanceDetail(i), this);
+            }
+        }
+
+        if(action->hasTerminated())
+            break;
+    }
+}
+
+void SoFCInstanceArray::GLRender(SoGLRenderAction *action)
+{
+    if(!action->isRenderingDelayedPaths())
+        delayedPaths.truncate(0);
+    else if(action->getWhatAppliedTo() == SoAction::PATH) {
+        // A transparent shape below delays its path once for each instance,
+        // and all these paths are identical. Render all instances for the
+        // first one, and skip the copies.
+        SoPath *path = const_cast<SoPath*>(action->getPathAppliedTo());
+        if(delayedPaths.findPath(*path) >= 0)
+            return;
+        delayedPaths.append(path);
+    }
+    traverseInstances(action);
+}
+
+void SoFCInstanceArray::callback(SoCallbackAction *action)
+{
+    traverseInstances(action);
+}
+
+void SoFCInstanceArray::rayPick(SoRayPickAction *action)
+{
+    traverseInstances(action, action);
+}
+
+void SoFCInstanceArray::getPrimitiveCount(SoGetPrimitiveCountAction *action)
+{
+    traverseInstances(action);
+}
+
+void SoFCInstanceArray::getBoundingBox(SoGetBoundingBoxAction *action)
+{
+    int numindices;
+    const int *indices;
+    SoAction::PathCode pathcode = action->getPathCode(numindices, indices);
+    if(pathcode == SoAction::IN_PATH || pathcode == SoAction::OFF_PATH
+            || action->isInCameraSpace()) {
+        traverseInstances(action);
+        return;
+    }
+
+    // Obtain the bounding box of the shared children once, and transform it
+    // with each instance matrix instead of traversing the children for every
+    // instance. The children are traversed by the incoming action to see the
+    // inherited state, but with an identity transformation and an empty box,
+    // so that the action collects their box in the local space of this node.
+    SbXfBox3f &xfbox = action->getXfBoundingBox();
+    SbXfBox3f savedBox = xfbox;
+    bool centerSet = action->isCenterSet();
+    SbVec3f savedCenter;
+    if(centerSet)
+        savedCenter = action->getCenter();
+    xfbox = SbXfBox3f();
+    action->resetCenter();
+
+    SoState *state = action->getState();
+    state->push();
+    SoModelMatrixElement::makeIdentity(state, this);
+    SoLocalBBoxMatrixElement::makeIdentity(state);
+    children->traverse(action);
+    state->pop();
+
+    SbBox3f childBox = xfbox.project();
+    xfbox = savedBox;
+    action->resetCenter();
+    if(centerSet)
+        action->setCenter(savedCenter, FALSE);
+    if(childBox.isEmpty())
+        return;
+
+    SbBox3f bbox;
+    const SbMatrix *mats = matrices.getValues(0);
+    auto itExcluded = excluded.begin();
+    for(int i=0,count=matrices.getNum();i<count;++i) {
+        if(itExcluded!=excluded.end() && *itExcluded==i) {
+            ++itExcluded;
+            continue;
+        }
+        SbBox3f box = childBox;
+        box.transform(mats[i]);
+        bbox.extendBy(box);
+    }
+    if(bbox.isEmpty())
+        return;
+    action->extendBy(bbox);
+    action->setCenter(bbox.getCenter(), TRUE);
+}
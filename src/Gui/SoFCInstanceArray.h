@@ -0,0 +1,108 @@
+/***************************************************************************
+ *   Copyright (c) 2020 FreeCAD Developers                                 *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef GUI_SOFCINSTANCEARRAY_H
+#define GUI_SOFCINSTANCEARRAY_H
+
+#include <set>
+#include <Inventor/details/SoSubDetail.h>
+#include <Inventor/fields/SoMFMatrix.h>
+#include <Inventor/lists/SoPathList.h>
+#include <Inventor/nodes/SoGroup.h>
+
+class SoPath;
+
+namespace Gui {
+
+/** Detail telling which instance of a SoFCInstanceArray has been picked
+ *
+ * The detail is attached to the SoFCInstanceArray node of the picked path,
+ * use SoPickedPoint::getDetail(node) to obtain it.
+ */
+class GuiExport SoFCInstanceDetail : public SoDetail {
+    SO_DETAIL_HEADER(SoFCInstanceDetail);
+
+public:
+    static void initClass(void);
+    SoFCInstanceDetail(int index=-1);
+    virtual ~SoFCInstanceDetail();
+
+    virtual SoDetail *copy(void) const;
+
+    int getIndex() const {return index;}
+    void setIndex(int idx) {index = idx;}
+
+private:
+    int index;
+};
+
+/** Group node that traverses its children once per instance matrix
+ *
+ * All instance placements are kept in one contiguous matrix array, and the
+ * shared children are traversed in a loop instead of going through separate
+ * transform and switch nodes for each instance. Instances can be excluded,
+ * e.g. because they are hidden, or because they are rendered by a node of
+ * their own to carry individual overrides. Excluded instances are stored in
+ * a sparse set.
+ */
+class GuiExport SoFCInstanceArray : public SoGroup {
+    typedef SoGroup inherited;
+
+    SO_NODE_HEADER(Gui::SoFCInstanceArray);
+
+public:
+    static void initClass(void);
+    static void finish(void);
+    SoFCInstanceArray(void);
+
+    /// Placement of each instance
+    SoMFMatrix matrices;
+
+    void setExcluded(int index, bool excluded);
+    bool isExcluded(int index) const;
+    /// Removes all exclusions starting at the given index
+    void clearExcluded(int from=0);
+
+    /// Checks if the path goes through any SoFCInstanceArray node
+    static bool isInstancedPath(const SoPath *path);
+
+    virtual void GLRender(SoGLRenderAction *action);
+    virtual void callback(SoCallbackAction *action);
+    virtual void getBoundingBox(SoGetBoundingBoxAction *action);
+    virtual void rayPick(SoRayPickAction *action);
+    virtual void getPrimitiveCount(SoGetPrimitiveCountAction *action);
+
+protected:
+    virtual ~SoFCInstanceArray();
+
+private:
+    void traverseInstances(SoAction *action, SoRayPickAction *pickAction=0);
+
+private:
+    std::set<int> excluded;
+    /// Delayed paths through this node already rendered in the current frame
+    SoPathList delayedPaths;
+};
+
+} // namespace Gui
+
+#endif // GUI_SOFCINSTANCEARRAY_H
@@ -0,0 +1,410 @@
+/***************************************************************************
+ *   Copyright (c) 2020 FreeCAD Developers                                 *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <algorithm>
+# include <float.h>
+# include <unordered_map>
+# include <Inventor/SbViewVolume.h>
+# include <Inventor/actions/SoGLRenderAction.h>
+# include <Inventor/actions/SoGetBoundingBoxAction.h>
+# include <Inventor/elements/SoModelMatrixElement.h>
+# include <Inventor/elements/SoProjectionMatrixElement.h>
+# include <Inventor/elements/SoViewingMatrixElement.h>
+# include <Inventor/elements/SoViewportRegionElement.h>
+# include <Inventor/elements/SoViewVolumeElement.h>
+# include <Inventor/misc/SoState.h>
+# include <Inventor/nodes/SoGroup.h>
+# include <Inventor/nodes/SoSeparator.h>
+#endif
+
+#include <Inventor/SbVec4f.h>
+
+#ifdef FC_OS_MACOSX
+# include <OpenGL/gl.h>
+#else
+# ifdef FC_OS_WIN32
+#  include <windows.h>
+# endif
+# include <GL/gl.h>
+#endif
+
+#include "SoFCRenderCuller.h"
+
+using namespace Gui;
+
+namespace {
+// number of children stored in a leaf
+const int LeafSize = 4;
+// size in pixels of the tiles of the coarse depth buffer
+const int TileSize = 16;
+}
+
+SoFCRenderCuller::SoFCRenderCuller()
+    : dirty(true), refitCount(0), mvp(SbMatrix::identity()), groupId(0), boxChanged(false)
+    , stillCamera(false), tilesX(0), tilesY(0), depthNear(0.f), depthFar(1.f)
+    , depthMVP(SbMatrix::identity()), depthGroupId(0), depthValid(false)
+{
+}
+
+void SoFCRenderCuller::clear()
+{
+    entries.clear();
+    nodes.clear();
+    order.clear();
+    leaves.clear();
+    visible.clear();
+    depthTiles.clear();
+    dirty = true;
+    depthValid = false;
+}
+
+void SoFCRenderCuller::sync(SoGroup *group, const SbViewportRegion &vp)
+{
+    SoGetBoundingBoxAction bboxAction(vp);
+    auto measure = [&](Entry &entry) {
+        entry.nodeId = entry.node->getNodeId();
+        bboxAction.apply(entry.node);
+        SbBox3f box = bboxAction.getBoundingBox();
+        // Only separators can be skipped without affecting the following
+        // children. Children without a box, e.g. those containing nothing but
+        // annotations excluded from the bounding box, are always rendered.
+        bool cullable = !box.isEmpty()
+            && entry.node->isOfType(SoSeparator::getClassTypeId());
+        if (cullable == entry.cullable && (!cullable || box == entry.box))
+            return false;
+        if (cullable != entry.cullable)
+            dirty = true;
+        entry.box = box;
+        entry.cullable = cullable;
+        boxChanged = true;
+        return true;
+    };
+
+    int count = group->getNumChildren();
+    bool changed = count != static_cast<int>(entries.size());
+    for (int i=0; !changed && i<count; ++i)
+        changed = entries[i].node != group->getChild(i);
+
+    if (changed) {
+        // children have been added or removed, keep the boxes of the others
+        std::unordered_map<SoNode*, Entry> cached;
+        for (const auto &entry : entries)
+            cached.emplace(entry.node, entry);
+        entries.resize(count);
+        for (int i=0; i<count; ++i) {
+            Entry &entry = entries[i];
+            entry.node = group->getChild(i);
+            auto it = cached.find(entry.node);
+            if (it != cached.end()) {
+                entry = it->second;
+                continue;
+            }
+            entry.cullable = false;
+            entry.box.makeEmpty();
+            measure(entry);
+        }
+        dirty = true;
+        boxChanged = true;
+    }
+
+    for (int i=0; i<count; ++i) {
+        Entry &entry = entries[i];
+        if (entry.node->getNodeId() == entry.nodeId)
+            continue;
+        if (measure(entry) && !dirty)
+            refit(i);
+    }
+}
+
+void SoFCRenderCuller::refit(int entry)
+{
+    int index = leaves[entry];
+    if (index < 0)
+        return;
+
+    Node &leaf = nodes[index];
+    leaf.box.makeEmpty();
+    for (int i=leaf.first; i<leaf.first+leaf.count; ++i)
+        leaf.box.extendBy(entries[order[i]].box);
+
+    for (int parent=leaf.parent; parent>=0; parent=nodes[parent].parent) {
+        Node &node = nodes[parent];
+        node.box = nodes[parent+1].box;
+        node.box.extendBy(nodes[node.first].box);
+    }
+
+    // Refitting keeps the tree correct, but the boxes of moved children may
+    // grow to overlap a lot. Rebuild the tree after too many changes.
+    if (++refitCount > static_cast<int>(entries.size()) / 4 + 16)
+        dirty = true;
+}
+
+void SoFCRenderCuller::build()
+{
+    dirty = false;
+    refitCount = 0;
+    nodes.clear();
+    order.clear();
+    leaves.assign(entries.size(), -1);
+
+    std::vector<SbVec3f> centers(entries.size());
+    for (std::size_t i=0; i<entries.size(); ++i) {
+        if (!entries[i].cullable)
+            continue;
+        order.push_back(static_cast<int32_t>(i));
+        centers[i] = entries[i].box.getCenter();
+    }
+    if (order.empty())
+        return;
+
+    nodes.reserve(2 * order.size() / LeafSize + 1);
+    buildNode(centers, 0, static_cast<int>(order.size()), -1);
+}
+
+int SoFCRenderCuller::buildNode(const std::vector<SbVec3f> &centers,
+                                int first, int count, int parent)
+{
+    int index = static_cast<int>(nodes.size());
+    nodes.emplace_back();
+    nodes[index].parent = parent;
+
+    SbBox3f box, centerBox;
+    for (int i=first; i<first+count; ++i) {
+        box.extendBy(entries[order[i]].box);
+        centerBox.extendBy(centers[order[i]]);
+    }
+    nodes[index].box = box;
+
+    if (count <= LeafSize) {
+        nodes[index].first = first;
+        nodes[index].count = count;
+        for (int i=first; i<first+count; ++i)
+            leaves[order[i]] = index;
+        return index;
+    }
+
+    // split at the median of the longest axis of the box centers
+    SbVec3f size = centerBox.getMax() - centerBox.getMin();
+    int axis = 0;
+    if (size[1] > size[axis])
+        axis = 1;
+    if (size[2] > size[axis])
+        axis = 2;
+
+    int half = count / 2;
+    std::nth_element(order.begin() + first, order.begin() + first + half,
+            order.begin() + first + count,
+            [&centers, axis](int32_t a, int32_t b) {
+                return centers[a][axis] < centers[b][axis];
+            });
+
+    buildNode(centers, first, half, index);
+    int second = buildNode(centers, first + half, count - half, index);
+    nodes[index].first = second;
+    nodes[index].count = 0;
+    return index;
+}
+
+const std::vector<char> &SoFCRenderCuller::cull(SoGLRenderAction *action, SoGroup *group,
+                                                float pixelSize, bool occlusion)
+{
+    SoState *state = action->getState();
+    viewport = SoViewportRegionElement::get(state);
+    groupId = group->getNodeId();
+    boxChanged = false;
+    sync(group, viewport);
+    if (dirty)
+        build();
+
+    visible.resize(entries.size());
+    for (std::size_t i=0; i<entries.size(); ++i)
+        visible[i] = entries[i].cullable ? 0 : 1;
+
+    const SbMatrix &model = SoModelMatrixElement::get(state);
+    SbMatrix lastMVP = mvp;
+    mvp = model;
+    mvp.multRight(SoViewingMatrixElement::get(state));
+    mvp.multRight(SoProjectionMatrixElement::get(state));
+
+    // The depth of the previous frame is only usable when nothing has changed.
+    // Besides moved boxes, this includes changes that keep the boxes, e.g. of
+    // the display mode, the visibility or the transparency of an occluder,
+    // which all change the node id of the group. The depth is captured once
+    // the camera stands still, to avoid reading back the depth buffer on every
+    // frame while navigating.
+    bool useDepth = false;
+    if (occlusion) {
+        if (depthValid && !boxChanged && depthGroupId == groupId
+                && depthViewport == viewport && depthMVP == mvp)
+            useDepth = true;
+        else
+            depthValid = false;
+        stillCamera = lastMVP == mvp;
+    }
+
+    if (nodes.empty())
+        return visible;
+
+    const SbViewVolume &vv = SoViewVolumeElement::get(state);
+    const SbVec2s &vpSize = viewport.getViewportSizePixels();
+    bool transform = model != SbMatrix::identity();
+    bool perspective = vv.getProjectionType() == SbViewVolume::PERSPECTIVE;
+
+    auto isTooSmall = [&](SbBox3f box) {
+        if (transform)
+            box.transform(model);
+        // Keep points, whose markers are drawn regardless of their size
+        SbVec3f extent = box.getMax() - box.getMin();
+        if (extent[0] <= 0.f && extent[1] <= 0.f && extent[2] <= 0.f)
+            return false;
+        if (perspective) {
+            // the projection is meaningless for boxes reaching behind the near plane
+            float dist = (box.getCenter() - vv.getProjectionPoint()).dot(vv.getProjectionDirection());
+            if (dist - extent.length() * 0.5f <= vv.getNearDist())
+                return false;
+        }
+        SbVec2f size = vv.projectBox(box);
+        return size[0] * vpSize[0] < pixelSize && size[1] * vpSize[1] < pixelSize;
+    };
+
+    struct Item {
+        int32_t node;
+        // planes still to be tested, see SbBox3f::outside()
+        int cullBits;
+    };
+    Item stack[64];
+    int top = 0;
+    stack[top++] = {0, 7};
+    while (top > 0) {
+        Item item = stack[--top];
+        const Node &node = nodes[item.node];
+        if (item.cullBits && node.box.outside(mvp, item.cullBits))
+            continue;
+        if (node.count == 0) {
+            stack[top++] = {node.first, item.cullBits};
+            stack[top++] = {item.node + 1, item.cullBits};
+            continue;
+        }
+        for (int i=node.first; i<node.first+node.count; ++i) {
+            int32_t index = order[i];
+            const SbBox3f &box = entries[index].box;
+            int cullBits = item.cullBits;
+            if (cullBits && box.outside(mvp, cullBits))
+                continue;
+            if (pixelSize > 0.f && isTooSmall(box))
+                continue;
+            if (useDepth && isOccluded(box))
+                continue;
+            visible[index] = 1;
+        }
+    }
+    return visible;
+}
+
+bool SoFCRenderCuller::isOccluded(const SbBox3f &box) const
+{
+    const SbVec3f &bmin = box.getMin();
+    const SbVec3f &bmax = box.getMax();
+    float xmin = FLT_MAX, ymin = FLT_MAX, zmin = FLT_MAX;
+    float xmax = -FLT_MAX, ymax = -FLT_MAX;
+    for (int i=0; i<8; ++i) {
+        SbVec4f clip;
+        mvp.multVecMatrix(SbVec4f(i&1 ? bmax[0] : bmin[0],
+                                  i&2 ? bmax[1] : bmin[1],
+                                  i&4 ? bmax[2] : bmin[2], 1.f), clip);
+        // reaches behind the camera
+        if (clip[3] <= FLT_EPSILON)
+            return false;
+        float x = clip[0] / clip[3];
+        float y = clip[1] / clip[3];
+        xmin = std::min(xmin, x);
+        xmax = std::max(xmax, x);
+        ymin = std::min(ymin, y);
+        ymax = std::max(ymax, y);
+        zmin = std::min(zmin, clip[2] / clip[3]);
+    }
+    if (zmin <= -1.f)
+        return false;
+
+    const SbVec2s &size = depthViewport.getViewportSizePixels();
+    auto tile = [](float v, int pixels, int tiles) {
+        int t = static_cast<int>((v * 0.5f + 0.5f) * pixels) / TileSize;
+        return std::max(0, std::min(tiles - 1, t));
+    };
+    int x0 = tile(xmin, size[0], tilesX);
+    int x1 = tile(xmax, size[0], tilesX);
+    int y0 = tile(ymin, size[1], tilesY);
+    int y1 = tile(ymax, size[1], tilesY);
+    float depth = depthNear + (depthFar - depthNear) * (zmin * 0.5f + 0.5f);
+    for (int y=y0; y<=y1; ++y) {
+        for (int x=x0; x<=x1; ++x) {
+            if (depthTiles[y * tilesX + x] >= depth)
+                return false;
+        }
+    }
+    return true;
+}
+
+bool SoFCRenderCuller::needDepth() const
+{
+    return !depthValid && stillCamera;
+}
+
+void SoFCRenderCuller::captureDepth()
+{
+    const SbVec2s &origin = viewport.getViewportOriginPixels();
+    const SbVec2s &size = viewport.getViewportSizePixels();
+    if (size[0] <= 0 || size[1] <= 0)
+        return;
+
+    // This is called before the delayed paths are rendered, so the depth
+    // buffer contains opaque geometry only.
+    std::vector<float> depth(static_cast<std::size_t>(size[0]) * size[1]);
+    glReadPixels(origin[0], origin[1], size[0], size[1], GL_DEPTH_COMPONENT, GL_FLOAT, &depth[0]);
+    if (glGetError() != GL_NO_ERROR)
+        return;
+    GLfloat range[2];
+    glGetFloatv(GL_DEPTH_RANGE, range);
+
+    tilesX = (size[0] + TileSize - 1) / TileSize;
+    tilesY = (size[1] + TileSize - 1) / TileSize;
+    depthTiles.assign(tilesX * tilesY, 0.f);
+    const float *pixel = &depth[0];
+    for (int y=0; y<size[1]; ++y) {
+        float *row = &depthTiles[(y / TileSize) * tilesX];
+        for (int x=0; x<size[0]; ++x, ++pixel) {
+            float &farthest = row[x / TileSize];
+            if (*pixel > farthest)
+                farthest = *pixel;
+        }
+    }
+
+    depthNear = range[0];
+    depthFar = range[1];
+    depthMVP = mvp;
+    depthViewport = viewport;
+    depthGroupId = groupId;
+    depthValid = true;
+}
@@ -0,0 +1,136 @@
+/***************************************************************************
+ *   Copyright (c) 2020 FreeCAD Developers                                 *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef GUI_SOFCRENDERCULLER_H
+#define GUI_SOFCRENDERCULLER_H
+
+#include <vector>
+#include <Inventor/SbBox3f.h>
+#include <Inventor/SbMatrix.h>
+#include <Inventor/SbViewportRegion.h>
+
+class SoGLRenderAction;
+class SoGroup;
+class SoNode;
+
+namespace Gui {
+
+/**
+ * Culls the children of the scene root before they are rendered.
+ *
+ * The bounding box of each child, i.e. of each view provider root, is cached
+ * together with the node id it was computed for, so that only the children
+ * touched since the last frame are measured again. The boxes are organized
+ * in a bounding volume hierarchy that is refitted when a few boxes change and
+ * rebuilt when children are added or removed.
+ *
+ * Each frame the hierarchy is tested against the view volume, and children
+ * whose projection is smaller than a given number of pixels are skipped.
+ * Optionally, the depth buffer of the previous frame is reduced to a coarse
+ * grid of tiles holding the farthest depth, and children lying completely
+ * behind it are skipped, too, as long as the camera and the scene stay the
+ * same.
+ */
+class GuiExport SoFCRenderCuller
+{
+public:
+    SoFCRenderCuller();
+
+    /// Discards all cached boxes
+    void clear();
+
+    /** Determines the children of \a group to be rendered
+     *
+     * @param action: the current render action
+     * @param group: the group whose children are to be culled
+     * @param pixelSize: children with a smaller projection are culled,
+     *                   use 0 to disable
+     * @param occlusion: whether to use the depth of the previous frame
+     *
+     * @return one flag per child, zero for culled children
+     */
+    const std::vector<char> &cull(SoGLRenderAction *action, SoGroup *group,
+                                  float pixelSize, bool occlusion);
+
+    /// Checks whether captureDepth() should be called after rendering
+    bool needDepth() const;
+    /** Reads back the depth buffer after rendering the culled children
+     *  for the occlusion test of the next frame
+     */
+    void captureDepth();
+
+private:
+    struct Entry {
+        SoNode *node;
+        uint32_t nodeId;
+        SbBox3f box;
+        bool cullable;
+    };
+
+    struct Node {
+        SbBox3f box;
+        /// index of the first entry for leaves, of the second child otherwise
+        int32_t first;
+        /// number of entries, 0 for inner nodes whose first child follows directly
+        int32_t count;
+        int32_t parent;
+    };
+
+    void sync(SoGroup *group, const SbViewportRegion &vp);
+    void build();
+    int buildNode(const std::vector<SbVec3f> &centers, int first, int count, int parent);
+    void refit(int entry);
+    bool isOccluded(const SbBox3f &box) const;
+
+    std::vector<Entry> entries;
+    std::vector<Node> nodes;
+    /// entry indices referenced by the leaves
+    std::vector<int32_t> order;
+    /// leaf of each entry, -1 if not cullable
+    std::vector<int32_t> leaves;
+    std::vector<char> visible;
+    bool dirty;
+    int refitCount;
+
+    // state of the current frame
+    SbMatrix mvp;
+    SbViewportRegion viewport;
+    uint32_t groupId;
+    bool boxChanged;
+    bool stillCamera;
+
+    // coarse depth of the previous frame
+    std::vector<float> depthTiles;
+    int tilesX;
+    int tilesY;
+    float depthNear;
+    float depthFar;
+    SbMatrix depthMVP;
+    SbViewportRegion depthViewport;
+    /// node id of the group when the depth was captured
+    uint32_t depthGroupId;
+    bool depthValid;
+};
+
+} // namespace Gui
+
+#endif // GUI_SOFCRENDERCULLER_H
@@ -37,6 +37,8 @@
 #include <Inventor/SoFullPath.h>
 #include <Inventor/actions/SoGLRenderAction.h>
 #include <Inventor/actions/SoHandleEventAction.h>
+#include <Inventor/actions/SoRayPickAction.h>
+#include <Inventor/sensors/SoOneShotSensor.h>
 #include <Inventor/events/SoKeyboardEvent.h>
 #include <Inventor/elements/SoComplexityElement.h>
 #include <Inventor/elements/SoComplexityTypeElement.h>
@@ -92,6 +94,8 @@
 #include "ViewProvider.h"
 #include "SoFCInteractiveElement.h"
 #include "SoFCSelectionAction.h"
+#include "SoFCInstanceArray.h"
+#include "SoFCRenderCuller.h"
 #include "ViewProviderDocumentObject.h"
 #include "ViewProviderGeometryObject.h"
 #include "ViewParams.h"
@@ -113,7 +117,8 @@ SO_NODE_SOURCE(SoFCUnifiedSelection)
 /*!
   Constructor.
 */
-SoFCUnifiedSelection::SoFCUnifiedSelection() : pcDocument(0)
+SoFCUnifiedSelection::SoFCUnifiedSelection()
+    : pcDocument(0), pcViewer(0), preselPath(0), culler(0)
 {
     SO_NODE_CONSTRUCTOR(SoFCUnifiedSelection);
 
@@ -139,6 +144,8 @@ SoFCUnifiedSelection::SoFCUnifiedSelection() : pcDocument(0)
     setPreSelection = false;
     preSelection = -1;
     useNewSelection = ViewParams::instance()->getUseNewSelection();
+
+    preselSensor = new SoOneShotSensor(preselectionSensorCB, this);
 }
 
 /*!
@@ -156,6 +163,10 @@ SoFCUnifiedSelection::~SoFCUnifiedSelection()
         detailPath->unref();
         detailPath = NULL;
     }
+    delete preselSensor;
+    if (preselPath)
+        preselPath->unref();
+    delete culler;
 }
 
 // doc from parent
@@ -224,6 +235,23 @@ void SoFCUnifiedSelection::write(SoWriteAction * action)
     }
 }
 
+// The elements of an instanced link array share their scene graph nodes, so
+// the path of a picked point cannot hold the selection context of a single
+// element. Ask the view provider for a path to the picked element instead.
+static bool getInstanceDetailPath(SoFullPath *path, ViewProviderDocumentObject *vpd,
+        const char *element, SoFullPath *detailPath, SoDetail *&det)
+{
+    if(!path || !vpd || !SoFCInstanceArray::isInstancedPath(path))
+        return false;
+    detailPath->truncate(0);
+    det = 0;
+    if(vpd->getDetailPath(element,detailPath,true,det) && detailPath->getLength())
+        return true;
+    delete det;
+    det = 0;
+    return false;
+}
+
 int SoFCUnifiedSelection::getPriority(const SoPickedPoint* p)
 {
     const SoDetail* detail = p->getDetail();
@@ -236,17 +264,23 @@ int SoFCUnifiedSelection::getPriority(const SoPickedPoint* p)
 
 std::vector<SoFCUnifiedSelection::PickedInfo> 
 SoFCUnifiedSelection::getPickedList(SoHandleEventAction* action, bool singlePick) const
+{
+    return getPickedList(action->getPickedPointList(), action->getCurPath(), singlePick);
+}
+
+std::vector<SoFCUnifiedSelection::PickedInfo> 
+SoFCUnifiedSelection::getPickedList(const SoPickedPointList &points,
+                                    const SoPath *curPath, bool singlePick) const
 {
     ViewProvider *last_vp = 0;
     std::vector<PickedInfo> ret;
-    const SoPickedPointList & points = action->getPickedPointList();
     for(int i=0,count=points.getLength();i<count;++i) {
         PickedInfo info;
         info.pp = points[i];
         info.vpd = 0;
         ViewProvider *vp = 0;
         SoFullPath *path = static_cast<SoFullPath *>(info.pp->getPath());
-        if (this->pcDocument && path && path->containsPath(action->getCurPath())) {
+        if (this->pcDocument && path && path->containsPath(curPath)) {
             vp = this->pcDocument->getViewProviderByPathFromHead(path);
             if(singlePick && last_vp && last_vp!=vp)
                 return ret;
@@ -481,12 +515,20 @@ bool SoFCUnifiedSelection::setHighlight(SoFullPath *path, const SoDetail *det,
 {
     Base::FlagToggler<SbBool> flag(setPreSelection);
 
+    std::unique_ptr<SoDetail> detInstance;
     bool highlighted = false;
     if(path && path->getLength() && 
        vpd && vpd->getObject() && vpd->getObject()->getNameInDocument()) 
     {
         const char *docname = vpd->getObject()->getDocument()->getName();
         const char *objname = vpd->getObject()->getNameInDocument();
+
+        SoDetail *instanceDetail = 0;
+        if(getInstanceDetailPath(path,vpd,element,detailPath,instanceDetail)) {
+            path = detailPath;
+            det = instanceDetail;
+        }
+        detInstance.reset(instanceDetail);
     
         this->preSelection = 1;
         static char buf[513];
@@ -592,6 +634,12 @@ bool SoFCUnifiedSelection::setSelection(const std::vector<PickedInfo> &infos, bo
         return true;
     }
 
+    SoDetail *detInstance = 0;
+    if(getInstanceDetailPath(pPath,vpd,info.element.c_str(),detailPath,detInstance)) {
+        pPath = detailPath;
+        det = detInstance;
+    }
+
     // Hierarchy ascending
     //
     // If the clicked subelement is already selected, check if there is an
@@ -703,6 +751,7 @@ bool SoFCUnifiedSelection::setSelection(const std::vector<PickedInfo> &infos, bo
     }
 
     if(detNext) delete detNext;
+    if(detInstance) delete detInstance;
     return true;
 }
 
@@ -737,18 +786,21 @@ SoFCUnifiedSelection::handleEvent(SoHandleEventAction * action)
         // down extremely the system on really big data sets. In this case we just check for a picked point if the data
         // set has been selected.
         if (mymode == AUTO || mymode == ON) {
-            // check to see if the mouse is over our geometry...
-            auto infos = this->getPickedList(action,true);
-            if(infos.size()) 
-                setHighlight(infos[0]);
+            if (this->pcViewer && ViewParams::instance()->getDeferPreselection()) {
+                // Motion events arrive much faster than a frame can be drawn. Only
+                // remember the latest position and pick once the event queue has
+                // been drained, so that a burst of events costs a single ray pick.
+                if (this->preselPath)
+                    this->preselPath->unref();
+                this->preselPath = action->getCurPath()->copy();
+                this->preselPath->ref();
+                this->preselPos = event->getPosition();
+                if (!this->preselSensor->isScheduled())
+                    this->preselSensor->schedule();
+            }
             else {
-                setHighlight(PickedInfo());
-                if (this->preSelection > 0) {
-                    this->preSelection = 0;
-                    // touch() makes sure to call GLRenderBelowPath so that the cursor can be updated
-                    // because only from there the SoGLWidgetElement delivers the OpenGL window
-                    this->touch();
-                }
+                // check to see if the mouse is over our geometry...
+                setPreselection(this->getPickedList(action,true));
             }
         }
     }
@@ -767,9 +819,78 @@ SoFCUnifiedSelection::handleEvent(SoHandleEventAction * action)
     inherited::handleEvent(action);
 }
 
+void SoFCUnifiedSelection::setPreselection(const std::vector<PickedInfo> &infos)
+{
+    if(infos.size()) 
+        setHighlight(infos[0]);
+    else {
+        setHighlight(PickedInfo());
+        if (this->preSelection > 0) {
+            this->preSelection = 0;
+            // touch() makes sure to call GLRenderBelowPath so that the cursor can be updated
+            // because only from there the SoGLWidgetElement delivers the OpenGL window
+            this->touch();
+        }
+    }
+}
+
+void SoFCUnifiedSelection::preselectionSensorCB(void *data, SoSensor *)
+{
+    SoFCUnifiedSelection *self = static_cast<SoFCUnifiedSelection*>(data);
+    SoPath *path = self->preselPath;
+    if (!path)
+        return;
+    self->preselPath = 0;
+
+    HighlightModes mymode = (HighlightModes) self->highlightMode.getValue();
+    if (self->pcViewer && (mymode == AUTO || mymode == ON)) {
+        SoRenderManager *mgr = self->pcViewer->getSoRenderManager();
+        SoRayPickAction rp(mgr->getViewportRegion());
+        rp.setPoint(self->preselPos);
+        rp.setRadius(self->pcViewer->getPickRadius());
+        rp.setPickAll(TRUE);
+        rp.apply(mgr->getSceneGraph());
+        self->setPreselection(self->getPickedList(rp.getPickedPointList(), path, true));
+    }
+    path->unref();
+}
+
+void SoFCUnifiedSelection::renderCulled(SoGLRenderAction * action)
+{
+    if (!culler)
+        culler = new SoFCRenderCuller;
+
+    ViewParams *params = ViewParams::instance();
+    bool occlusion = params->getRenderOcclusionCulling();
+    const std::vector<char> &visible = culler->cull(action, this,
+            static_cast<float>(params->getRenderCullingPixelSize()), occlusion);
+
+    // Same as SoSeparator::GLRenderBelowPath() without render caching
+    SoState *state = action->getState();
+    state->push();
+    for (int i=0, count=static_cast<int>(visible.size()); i<count; ++i) {
+        if (!visible[i])
+            continue;
+        this->children->traverse(action, i);
+        if (action->hasTerminated())
+            break;
+    }
+    if (occlusion && action->getCurPass() == 0 && culler->needDepth())
+        culler->captureDepth();
+    state->pop();
+}
+
 void SoFCUnifiedSelection::GLRenderBelowPath(SoGLRenderAction * action)
 {
-    inherited::GLRenderBelowPath(action);
+    // A render cache of the whole scene explicitly requested by the user takes
+    // precedence, because it would record the result of culling.
+    if (ViewParams::instance()->getRenderCulling() && renderCaching.getValue() != ON)
+        renderCulled(action);
+    else {
+        if (culler)
+            culler->clear();
+        inherited::GLRenderBelowPath(action);
+    }
 
     // nothing picked, so restore the arrow cursor if needed
     if (this->preSelection == 0) {
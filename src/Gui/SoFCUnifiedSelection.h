@@ -38,13 +38,17 @@
 
 class SoFullPath;
 class SoPickedPoint;
+class SoPickedPointList;
 class SoDetail;
+class SoOneShotSensor;
+class SoSensor;
 
 
 namespace Gui {
 
 class Document;
 class ViewProviderDocumentObject;
+class SoFCRenderCuller;
 
 /**  Unified Selection node
  *  This is the new selection node for the 3D Viewer which will 
@@ -114,10 +118,26 @@ private:
     bool setHighlight(SoFullPath *path, const SoDetail *det, 
             ViewProviderDocumentObject *vpd, const char *element, float x, float y, float z);
     bool setSelection(const std::vector<PickedInfo> &, bool ctrlDown=false);
+    void setPreselection(const std::vector<PickedInfo> &);
 
     std::vector<PickedInfo> getPickedList(SoHandleEventAction* action, bool singlePick) const;
+    std::vector<PickedInfo> getPickedList(const SoPickedPointList &points,
+            const SoPath *curPath, bool singlePick) const;
+
+    static void preselectionSensorCB(void *data, SoSensor *);
+
+    void renderCulled(SoGLRenderAction *action);
 
     Gui::Document       *pcDocument;
+    View3DInventorViewer *pcViewer;
+
+    /// Deferred pre-selection pick, only the latest mouse position is kept
+    SoOneShotSensor *preselSensor;
+    SoPath *preselPath;
+    SbVec2s preselPos;
+
+    /// Culls the view provider roots while rendering
+    SoFCRenderCuller *culler;
 
     static SoFullPath * currenthighlight;
     SoFullPath * detailPath;
@@ -2333,6 +2333,8 @@ void TreeWidget::onUpdateStatus(void)
         auto docItem = getDocumentItem(gdoc);
         if(!docItem) 
             continue;
+        std::vector<ViewProviderDocumentObject*> vps;
+        vps.reserve(v.second.size());
         for(auto id : v.second) {
             auto obj = doc->getObjectByID(id);
             if(!obj)
@@ -2343,6 +2345,25 @@ void TreeWidget::onUpdateStatus(void)
                 continue;
             auto vpd = Base::freecad_dynamic_cast<ViewProviderDocumentObject>(gdoc->getViewProvider(obj));
             if(vpd)
+                vps.push_back(vpd);
+        }
+        if(!TreeParams::Instance()->LazyLoading()) {
+            for(auto vpd : vps)
+                docItem->createNewItem(*vpd);
+            continue;
+        }
+        // Create the object data of all new objects first to complete the
+        // parent map, so that we only need to create root items for objects
+        // that are not claimed by any parent. Items of the claimed children
+        // are created on demand once the parent item gets expanded. This
+        // avoids creating (and then moving) a root item for each and every
+        // object of a freshly loaded document.
+        for(auto vpd : vps) {
+            if(!vpd->getObject()->testStatus(App::PartialObject))
+                docItem->createNewData(*vpd);
+        }
+        for(auto vpd : vps) {
+            if(!docItem->isObjectClaimed(vpd->getObject()))
                 docItem->createNewItem(*vpd);
         }
     }
@@ -2543,6 +2564,8 @@ void TreeWidget::onItemExpanded(QTreeWidgetItem * item)
         DocumentObjectItem* objItem = static_cast<DocumentObjectItem*>(item);
         objItem->setExpandedStatus(true);
         objItem->getOwnerDocument()->populateItem(objItem,false,false);
+        if(TreeParams::Instance()->LazyLoading())
+            objItem->getOwnerDocument()->testItemStatus(objItem);
     }
 }
 
@@ -3103,21 +3126,12 @@ bool DocumentItem::createNewItem(const Gui::ViewProviderDocumentObject& obj,
         return false;
 
     if(!data) {
-        auto &pdata = ObjectMap[obj.getObject()];
-        if(!pdata) {
-            pdata = std::make_shared<DocumentObjectData>(
-                    this, const_cast<ViewProviderDocumentObject*>(&obj));
-            auto &entry = getTree()->ObjectTable[obj.getObject()];
-            if(entry.size())
-                pdata->updateChildren(*entry.begin());
-            else
-                pdata->updateChildren(true);
-            entry.insert(pdata);
-        }else if(pdata->rootItem && parent==NULL) {
+        auto it = ObjectMap.find(obj.getObject());
+        if(it!=ObjectMap.end() && it->second && it->second->rootItem && parent==NULL) {
             Base::Console().Warning("DocumentItem::slotNewObject: Cannot add view provider twice.\n");
             return false;
         }
-        data = pdata;
+        data = createNewData(obj);
     }
 
     DocumentObjectItem* item = new DocumentObjectItem(this,data);
@@ -3143,6 +3157,49 @@ bool DocumentItem::createNewItem(const Gui::ViewProviderDocumentObject& obj,
     return true;
 }
 
+DocumentObjectDataPtr DocumentItem::createNewData(const Gui::ViewProviderDocumentObject& obj)
+{
+    auto &pdata = ObjectMap[obj.getObject()];
+    if(!pdata) {
+        pdata = std::make_shared<DocumentObjectData>(
+                this, const_cast<ViewProviderDocumentObject*>(&obj));
+        auto &entry = getTree()->ObjectTable[obj.getObject()];
+        if(entry.size())
+            pdata->updateChildren(*entry.begin());
+        else
+            pdata->updateChildren(true);
+        entry.insert(pdata);
+    }
+    return pdata;
+}
+
+bool DocumentItem::isObjectClaimed(App::DocumentObject *obj,
+                                   std::set<App::DocumentObject*> *visited)
+{
+    auto it = _ParentMap.find(obj);
+    if(it == _ParentMap.end() || it->second.empty())
+        return false;
+
+    std::set<App::DocumentObject*> _visited;
+    if(!visited)
+        visited = &_visited;
+    // break cyclic dependency by leaving the object at root
+    if(!visited->insert(obj).second)
+        return false;
+
+    for(auto parent : it->second) {
+        auto itData = ObjectMap.find(parent);
+        if(itData == ObjectMap.end() || !itData->second
+                || !itData->second->removeChildrenFromRoot)
+            continue;
+        // The parent is reachable if it either has an item already, or will
+        // get one at root.
+        if(itData->second->items.size() || !isObjectClaimed(parent,visited))
+            return true;
+    }
+    return false;
+}
+
 ViewProviderDocumentObject *DocumentItem::getViewProvider(App::DocumentObject *obj) {
     // Note: It is possible that we receive an invalid pointer from
     // claimChildren(), e.g. if multiple properties were changed in
@@ -3286,6 +3343,41 @@ bool DocumentItem::populateObject(App::DocumentObject *obj) {
     return true;
 }
 
+bool DocumentItem::populateObjectItem(App::DocumentObject *obj) {
+    // make sure there is at least one item corresponding to obj, which may
+    // not be the case with lazy loading, by populating its parent items
+    std::vector<App::DocumentObject*> path;
+    std::set<App::DocumentObject*> visited;
+    for(;;) {
+        auto it = ObjectMap.find(obj);
+        if(it != ObjectMap.end() && it->second && it->second->items.size())
+            break;
+        if(!visited.insert(obj).second)
+            return false;
+        path.push_back(obj);
+        auto itParents = _ParentMap.find(obj);
+        if(itParents == _ParentMap.end() || itParents->second.empty())
+            return false;
+        obj = *itParents->second.begin();
+        for(auto parent : itParents->second) {
+            auto itParent = ObjectMap.find(parent);
+            if(itParent != ObjectMap.end() && itParent->second 
+                    && itParent->second->items.size())
+            {
+                obj = parent;
+                break;
+            }
+        }
+    }
+    for(auto rit=path.rbegin();rit!=path.rend();++rit) {
+        if(!populateObject(obj))
+            return false;
+        obj = *rit;
+    }
+    auto it = ObjectMap.find(obj);
+    return it != ObjectMap.end() && it->second && it->second->items.size();
+}
+
 void DocumentItem::populateItem(DocumentObjectItem *item, bool refresh, bool delay)
 {
     (void)delay;
@@ -3296,6 +3388,10 @@ void DocumentItem::populateItem(DocumentObjectItem *item, bool refresh, bool del
     // Lazy loading policy: We will create an item for each children object if
     // a) the item is expanded, or b) there is at least one free child, i.e.
     // child originally located at root.
+    //
+    // With TreeParams::LazyLoading, a child object without any item is not
+    // considered free if this item removes its children from the root,
+    // because the child is reachable by expanding this item.
 
     item->setChildIndicatorPolicy(item->myData->children.empty()?
             QTreeWidgetItem::DontShowIndicator:QTreeWidgetItem::ShowIndicator);
@@ -3310,9 +3406,13 @@ void DocumentItem::populateItem(DocumentObjectItem *item, bool refresh, bool del
         auto linked = obj->getLinkedObject(true);
         if (linked && linked->getDocument()!=obj->getDocument())
             return;
+        bool lazy = item->myData->removeChildrenFromRoot
+                        && TreeParams::Instance()->LazyLoading();
         for(auto child : item->myData->children) {
             auto it = ObjectMap.find(child);
             if(it == ObjectMap.end() || it->second->items.empty()) {
+                if(lazy)
+                    continue;
                 auto vp = getViewProvider(child);
                 if(!vp) continue;
                 doPopulate = true;
@@ -3728,6 +3828,7 @@ void DocumentItem::Restore(Base::XMLReader &reader) {
 
 void DocumentItem::restoreItemExpansion(const ExpandInfoPtr &info, DocumentObjectItem *item) {
     item->setExpanded(true);
+    populateItem(item);
     if(!info)
         return;
     for(int i=0,count=item->childCount();i<count;++i) {
@@ -3764,6 +3865,9 @@ void DocumentItem::slotExpandObject (const Gui::ViewProviderDocumentObject& obj,
         return;
     }
 
+    if (mode == TreeItemMode::ExpandItem || mode == TreeItemMode::ExpandPath)
+        populateObjectItem(obj.getObject());
+
     FOREACH_ITEM(item,obj)
         // All document object items must always have a parent, either another
         // object item or document item. If not, then there is a bug somewhere
@@ -3823,6 +3927,7 @@ void DocumentItem::slotScrollToObject(const Gui::ViewProviderDocumentObject& obj
 {
     if(!obj.getObject() || !obj.getObject()->getNameInDocument())
         return;
+    populateObjectItem(obj.getObject());
     auto it = ObjectMap.find(obj.getObject());
     if(it == ObjectMap.end() || it->second->items.empty()) 
         return;
@@ -3869,10 +3974,48 @@ Gui::Document* DocumentItem::document() const
 //    }
 //}
 
+static bool isItemCollapsed(const QTreeWidgetItem *item) {
+    for(auto parent=item->parent();parent;parent=parent->parent()) {
+        if(parent->type()!=TreeWidget::ObjectType)
+            break;
+        if(!parent->isExpanded())
+            return true;
+    }
+    return false;
+}
+
 void DocumentItem::testStatus(void)
 {
-    for(const auto &v : ObjectMap)
-        v.second->testStatus();
+    if(!TreeParams::Instance()->LazyLoading()) {
+        for(const auto &v : ObjectMap)
+            v.second->testStatus();
+        return;
+    }
+
+    // Only update the items that can be seen. Items inside a collapsed
+    // branch are updated by testItemStatus() once the branch is expanded.
+    for(const auto &v : ObjectMap) {
+        // the icons are shared by the items of the same object only
+        QIcon icon,icon2;
+        for(auto item : v.second->items) {
+            if(!isItemCollapsed(item))
+                item->testStatus(false,icon,icon2);
+        }
+    }
+}
+
+void DocumentItem::testItemStatus(DocumentObjectItem *item)
+{
+    for(int i=0,count=item->childCount();i<count;++i) {
+        auto citem = item->child(i);
+        if(citem->type() != TreeWidget::ObjectType)
+            continue;
+        auto child = static_cast<DocumentObjectItem*>(citem);
+        QIcon icon,icon2;
+        child->testStatus(false,icon,icon2);
+        if(child->isExpanded())
+            testItemStatus(child);
+    }
 }
 
 void DocumentItem::setData (int column, int role, const QVariant & value)
@@ -4010,6 +4153,8 @@ void DocumentItem::updateItemSelection(DocumentObjectItem *item) {
 }
 
 App::DocumentObject *DocumentItem::getTopParent(App::DocumentObject *obj, std::string &subname) {
+    populateObjectItem(obj);
+
     auto it = ObjectMap.find(obj);
     if(it == ObjectMap.end() || it->second->items.empty())
         return 0;
@@ -4059,6 +4204,9 @@ DocumentObjectItem *DocumentItem::findItemByObject(
     if(!subname)
         subname = "";
 
+    if(sync)
+        populateObjectItem(obj);
+
     auto it = ObjectMap.find(obj);
     if(it == ObjectMap.end() || it->second->items.empty())
         return 0;
@@ -4734,6 +4882,13 @@ bool DocumentObjectItem::requiredAtRoot(bool excludeSelf) const{
             // items, because the item will be auto created once the user
             // expand its parent item. It only causes minor problems, such as,
             // tree scroll to object command won't work properly.
+            //
+            // With TreeParams::LazyLoading, we do exactly that, and rely on
+            // DocumentItem::populateObjectItem() to create the item when it is
+            // actually needed.
+            if(TreeParams::Instance()->LazyLoading()
+                    && myOwner->isObjectClaimed(object()->getObject()))
+                return false;
 
             for(auto parent : it->second) {
                 if(getOwnerDocument()->populateObject(parent))
@@ -285,9 +285,11 @@ public:
     void selectItems(SelectionReason reason=SR_SELECT);
 
     void testStatus(void);
+    void testItemStatus(DocumentObjectItem *item);
     void setData(int column, int role, const QVariant & value) override;
     void populateItem(DocumentObjectItem *item, bool refresh=false, bool delayUpdate=true);
     bool populateObject(App::DocumentObject *obj);
+    bool populateObjectItem(App::DocumentObject *obj);
     void selectAllInstances(const ViewProviderDocumentObject &vpd);
     bool showItem(DocumentObjectItem *item, bool select, bool force=false);
     void updateItemsVisibility(QTreeWidgetItem *item, bool show);
@@ -333,6 +335,15 @@ protected:
                     QTreeWidgetItem *parent=0, int index=-1, 
                     DocumentObjectDataPtr ptrs = DocumentObjectDataPtr());
 
+    DocumentObjectDataPtr createNewData(const Gui::ViewProviderDocumentObject&);
+
+    /** Checks if the object is reachable through an item of a parent that
+     * removes its children from the root, i.e. if it does not need an item
+     * until the parent is expanded.
+     */
+    bool isObjectClaimed(App::DocumentObject *obj,
+            std::set<App::DocumentObject*> *visited=0);
+
     int findRootIndex(App::DocumentObject *childObj);
 
     DocumentObjectItem *findItemByObject(bool sync, 
@@ -537,6 +548,7 @@ public:
     FC_TREEPARAM_DEF(KeepRootOrder,bool,Bool,true) \
     FC_TREEPARAM_DEF(TreeActiveAutoExpand,bool,Bool,true) \
     FC_TREEPARAM_DEF(Indentation,int,Int,0) \
+    FC_TREEPARAM_DEF(LazyLoading,bool,Bool,true) \
 
 #undef FC_TREEPARAM_DEF
 #define FC_TREEPARAM_DEF(_name,_type,_Type,_default) \
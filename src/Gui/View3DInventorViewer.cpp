@@ -460,6 +460,7 @@ void View3DInventorViewer::init()
     // point which causes a certain slow-down because for all objects the primitives
     // must be created. Using an SoSeparator avoids this drawback.
     selectionRoot = new Gui::SoFCUnifiedSelection();
+    selectionRoot->pcViewer = this;
     selectionRoot->applySettings();
 #endif
     // set the ViewProvider root node
@@ -637,6 +638,7 @@ View3DInventorViewer::~View3DInventorViewer()
     // that it prevents all children from being deleted. To reduce this
     // likelihood we explicitly remove all child nodes now.
     coinRemoveAllChildren(this->pcViewProviderRoot);
+    selectionRoot->pcViewer = 0;
     this->pcViewProviderRoot->unref();
     this->pcViewProviderRoot = 0;
     this->backlight->unref();
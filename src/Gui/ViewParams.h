@@ -60,6 +60,11 @@ public:
     FC_VIEW_PARAM(CoinCycleCheck,bool,Bool,true) \
     FC_VIEW_PARAM(EnablePropertyViewForInactiveDocument,bool,Bool,true) \
     FC_VIEW_PARAM(ShowSelectionBoundingBox,bool,Bool,false) \
+    FC_VIEW_PARAM(DeferPreselection,bool,Bool,true) \
+    FC_VIEW_PARAM(LinkArrayInstancing,int,Int,100) \
+    FC_VIEW_PARAM(RenderCulling,bool,Bool,true) \
+    FC_VIEW_PARAM(RenderCullingPixelSize,double,Float,1.0) \
+    FC_VIEW_PARAM(RenderOcclusionCulling,bool,Bool,false) \
 
 #undef FC_VIEW_PARAM
 #define FC_VIEW_PARAM(_name,_ctype,_type,_def) \
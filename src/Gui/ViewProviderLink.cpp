@@ -67,6 +67,7 @@
 #include "ViewProviderGroupExtension.h"
 #include "View3DInventor.h"
 #include "SoFCUnifiedSelection.h"
+#include "SoFCInstanceArray.h"
 #include "SoFCCSysDragger.h"
 #include "Control.h"
 #include "TaskCSysDragger.h"
@@ -993,11 +994,16 @@ void LinkView::setMaterial(int index, const App::Material *material) {
     }else if(index >= (int)nodeArray.size())
         LINK_THROW(Base::ValueError,"LinkView: material index out of range");
     else {
-        auto &info = *nodeArray[index];
         if(!material) {
-            info.pcRoot->removeColorOverride();
+            if(nodeArray[index]) {
+                nodeArray[index]->pcRoot->removeColorOverride();
+                // Let the element go back into the instance array
+                if(pcInstanceArray)
+                    detailElements.insert(index);
+            }
             return;
         }
+        auto &info = getElement(index);
         App::Color c = material->diffuseColor;
         c.a = material->transparency;
         info.pcRoot->setColorOverride(c);
@@ -1108,6 +1114,7 @@ void LinkView::setSize(int _size) {
     if(!size || childType>=0) {
         nodeArray.clear();
         nodeMap.clear();
+        pcInstanceArray.reset();
         if(!size && childType<0) {
             if(pcLinkedRoot)
                 pcLinkRoot->addChild(pcLinkedRoot);
@@ -1116,21 +1123,169 @@ void LinkView::setSize(int _size) {
         childType = SnapshotContainer;
     }
     if(size<nodeArray.size()) {
-        for(size_t i=size;i<nodeArray.size();++i)
-            nodeMap.erase(nodeArray[i]->pcSwitch);
+        for(size_t i=size;i<nodeArray.size();++i) {
+            if(nodeArray[i])
+                nodeMap.erase(nodeArray[i]->pcSwitch);
+        }
         nodeArray.resize(size);
     }
+
+    int threshold = ViewParams::instance()->getLinkArrayInstancing();
+    if(threshold>0 && (int)size>=threshold) {
+        nodeArray.resize(size);
+        setupInstanceArray();
+        return;
+    }
+
+    if(pcInstanceArray) {
+        // Switch back to one node per element. Create the missing elements
+        // while the instance array still holds their placement.
+        for(size_t i=0;i<nodeArray.size();++i)
+            getElement((int)i);
+        pcInstanceArray.reset();
+        resetRoot();
+    }
+
     for(auto &info : nodeArray)
         pcLinkRoot->addChild(info->pcSwitch);
 
     while(nodeArray.size()<size) {
-        nodeArray.push_back(std::unique_ptr<Element>(new Element(*this)));
-        auto &info = *nodeArray.back();
-        info.pcRoot->addChild(info.pcTransform);
-        if(pcLinkedRoot)
-            info.pcRoot->addChild(pcLinkedRoot);
+        nodeArray.emplace_back();
+        auto &info = getElement((int)nodeArray.size()-1);
         pcLinkRoot->addChild(info.pcSwitch);
-        nodeMap.emplace(info.pcSwitch,(int)nodeArray.size()-1);
+    }
+}
+
+LinkView::Element &LinkView::getElement(int index) {
+    auto &info = nodeArray[index];
+    if(info)
+        return *info;
+
+    info.reset(new Element(*this));
+    info->pcRoot->addChild(info->pcTransform);
+    if(pcLinkedRoot)
+        info->pcRoot->addChild(pcLinkedRoot);
+    nodeMap.emplace(info->pcSwitch,index);
+
+    if(pcInstanceArray && index<pcInstanceArray->matrices.getNum()) {
+        // Take the element out of the instance array, so that it can have
+        // its own selection context and color override.
+        info->pcTransform->setMatrix(pcInstanceArray->matrices[index]);
+        if(pcInstanceArray->isExcluded(index))
+            info->pcSwitch->whichChild = -1;
+        pcInstanceArray->setExcluded(index,true);
+        pcLinkRoot->addChild(info->pcSwitch);
+    }
+    return *info;
+}
+
+// Collect the array indices of the owner object that appear in the given
+// selection path
+static void getElementIndices(App::DocumentObject *owner,
+        App::DocumentObject *top, const char *subname, std::set<int> &indices)
+{
+    if(!top || !subname)
+        return;
+    auto obj = top;
+    std::string prefix;
+    for(const char *sub=subname;;) {
+        if(obj == owner) {
+            int idx = App::LinkBaseExtension::getArrayIndex(sub);
+            if(idx>=0)
+                indices.insert(idx);
+        }
+        const char *dot = strchr(sub,'.');
+        if(!dot)
+            break;
+        sub = dot+1;
+        prefix.assign(subname,sub);
+        obj = top->getSubObject(prefix.c_str());
+        if(!obj)
+            break;
+    }
+}
+
+void LinkView::mergeDetailElements() {
+    if(!pcInstanceArray) {
+        detailElements.clear();
+        return;
+    }
+    // Without an owner there is no way to tell whether an element is still
+    // selected, so it keeps its nodes.
+    if(detailElements.empty() || !linkOwner || !linkOwner->isLinked())
+        return;
+
+    // Elements still referenced by the selection or pre-selection hold a
+    // context in their selection root, which would be orphaned if the
+    // nodes are released now.
+    auto owner = linkOwner->pcLinked->getObject();
+    std::set<int> held;
+    for(auto &sel : Selection().getCompleteSelection(0))
+        getElementIndices(owner,sel.pObject,sel.SubName,held);
+    const auto &presel = Selection().getPreselection();
+    if(presel.Type == SelectionChanges::SetPreselect)
+        getElementIndices(owner,presel.Object.getObject(),presel.pSubName,held);
+
+    for(auto it=detailElements.begin();it!=detailElements.end();) {
+        int idx = *it;
+        if(held.count(idx)) {
+            ++it;
+            continue;
+        }
+        it = detailElements.erase(it);
+        if(idx>=(int)nodeArray.size() || !nodeArray[idx])
+            continue;
+        auto &info = nodeArray[idx];
+        if(info->pcRoot->hasColorOverride())
+            continue;
+        pcInstanceArray->setExcluded(idx,info->pcSwitch->whichChild.getValue()<0);
+        int childIdx = pcLinkRoot->findChild(info->pcSwitch);
+        if(childIdx>=0)
+            pcLinkRoot->removeChild(childIdx);
+        nodeMap.erase(info->pcSwitch);
+        info.reset();
+    }
+}
+
+void LinkView::setupInstanceArray() {
+    int size = (int)nodeArray.size();
+    int oldSize = 0;
+    if(!pcInstanceArray) {
+        pcInstanceArray = new SoFCInstanceArray;
+        if(pcLinkedRoot)
+            pcInstanceArray->addChild(pcLinkedRoot);
+    } else {
+        oldSize = std::min(size,pcInstanceArray->matrices.getNum());
+        pcInstanceArray->clearExcluded(size);
+    }
+
+    pcInstanceArray->matrices.setNum(size);
+    SbMatrix *mats = pcInstanceArray->matrices.startEditing();
+    for(int i=oldSize;i<size;++i) {
+        mats[i] = SbMatrix::identity();
+        auto &info = nodeArray[i];
+        if(!info)
+            continue;
+        // Take over the element created before switching to instancing.
+        // Only keep its nodes if it has a color override.
+        const auto &trans = *info->pcTransform;
+        mats[i].setTransform(trans.translation.getValue(), trans.rotation.getValue(),
+                trans.scaleFactor.getValue(), trans.scaleOrientation.getValue(),
+                trans.center.getValue());
+        if(info->pcRoot->hasColorOverride()
+                || info->pcSwitch->whichChild.getValue()<0)
+            pcInstanceArray->setExcluded(i,true);
+        if(!info->pcRoot->hasColorOverride()) {
+            nodeMap.erase(info->pcSwitch);
+            info.reset();
+        }
+    }
+    pcInstanceArray->matrices.finishEditing();
+
+    pcLinkRoot->addChild(pcInstanceArray);
+    for(auto &info : nodeArray) {
+        if(info)
+            pcLinkRoot->addChild(info->pcSwitch);
     }
 }
 
@@ -1151,6 +1306,7 @@ void LinkView::setChildren(const std::vector<App::DocumentObject*> &children,
         if(nodeArray.size()) {
             nodeArray.clear();
             nodeMap.clear();
+            pcInstanceArray.reset();
             childType = SnapshotContainer;
             resetRoot();
             if(pcLinkedRoot)
@@ -1164,8 +1320,10 @@ void LinkView::setChildren(const std::vector<App::DocumentObject*> &children,
 
     resetRoot();
 
-    if(childType<0)
+    if(childType<0) {
         nodeArray.clear();
+        pcInstanceArray.reset();
+    }
     childType = type;
 
     if(nodeArray.size() > children.size())
@@ -1210,7 +1368,7 @@ void LinkView::setChildren(const std::vector<App::DocumentObject*> &children,
 std::vector<ViewProviderDocumentObject*> LinkView::getChildren() const {
     std::vector<ViewProviderDocumentObject*> ret;
     for(auto &info : nodeArray) {
-        if(info->isLinked())
+        if(info && info->isLinked())
             ret.push_back(info->linkInfo->pcLinked);
     }
     return ret;
@@ -1227,18 +1385,29 @@ void LinkView::setTransform(int index, const Base::Matrix4D &mat) {
     }
     if(index<0 || index>=(int)nodeArray.size())
         LINK_THROW(Base::ValueError,"LinkView: index out of range");
+    if(pcInstanceArray) {
+        pcInstanceArray->matrices.set1Value(index,ViewProvider::convert(mat));
+        if(!nodeArray[index])
+            return;
+    }
     setTransform(nodeArray[index]->pcTransform,mat);
 }
 
 void LinkView::setElementVisible(int idx, bool visible) {
-    if(idx>=0 && idx<(int)nodeArray.size())
+    if(idx<0 || idx>=(int)nodeArray.size())
+        return;
+    if(nodeArray[idx])
         nodeArray[idx]->pcSwitch->whichChild = visible?0:-1;
+    else if(pcInstanceArray)
+        pcInstanceArray->setExcluded(idx,!visible);
 }
 
 bool LinkView::isElementVisible(int idx) const {
-    if(idx>=0 && idx<(int)nodeArray.size())
+    if(idx<0 || idx>=(int)nodeArray.size())
+        return false;
+    if(nodeArray[idx])
         return nodeArray[idx]->pcSwitch->whichChild.getValue()>=0;
-    return false;
+    return pcInstanceArray && !pcInstanceArray->isExcluded(idx);
 }
 
 ViewProviderDocumentObject *LinkView::getLinkedView() const {
@@ -1295,15 +1464,23 @@ void LinkView::replaceLinkedRoot(SoSeparator *root) {
         else 
             resetRoot();
     }else if(childType<0) {
+        std::vector<SoGroup*> groups;
+        groups.reserve(nodeArray.size()+1);
+        if(pcInstanceArray)
+            groups.push_back(pcInstanceArray);
+        for(auto &info : nodeArray) {
+            if(info)
+                groups.push_back(info->pcRoot);
+        }
         if(pcLinkedRoot && root) {
-            for(auto &info : nodeArray)
-                info->pcRoot->replaceChild(pcLinkedRoot,root);
+            for(auto group : groups)
+                group->replaceChild(pcLinkedRoot,root);
         }else if(root) {
-            for(auto &info : nodeArray)
-                info->pcRoot->addChild(root);
+            for(auto group : groups)
+                group->addChild(root);
         }else{
-            for(auto &info : nodeArray)
-                info->pcRoot->removeChild(pcLinkedRoot);
+            for(auto group : groups)
+                group->removeChild(pcLinkedRoot);
         }
     }
     pcLinkedRoot = root;
@@ -1407,34 +1584,44 @@ bool LinkView::linkGetElementPicked(const SoPickedPoint *pp, std::string &subnam
         if(idx<0 || idx+2>=path->getLength()) 
             return false;
         auto node = path->getNode(idx+1);
-        auto it = nodeMap.find(node);
-        if(it == nodeMap.end() || !isElementVisible(it->second))
-            return false;
-        int nodeIdx = it->second;
-        ++idx;
-        while(nodeArray[nodeIdx]->isGroup) {
-            auto &info = *nodeArray[nodeIdx];
-            if(!info.isLinked())
-                return false;
-            ss << info.linkInfo->getLinkedName() << '.';
-            idx += 2;
-            if(idx>=path->getLength())
+        if(pcInstanceArray && node == pcInstanceArray) {
+            auto det = pp->getDetail(pcInstanceArray);
+            if(!det || !det->isOfType(SoFCInstanceDetail::getClassTypeId()))
                 return false;
-            auto iter = nodeMap.find(path->getNode(idx));
-            if(iter == nodeMap.end() || !isElementVisible(iter->second))
+            int index = static_cast<const SoFCInstanceDetail*>(det)->getIndex();
+            if(!isElementVisible(index))
                 return false;
-            nodeIdx = iter->second;
-        }
-        auto &info = *nodeArray[nodeIdx];
-        if(nodeIdx == it->second)
-            ss << it->second << '.';
-        else
-            ss << info.linkInfo->getLinkedName() << '.';
-        if(info.isLinked()) {
-            if(!info.linkInfo->getElementPicked(false,childType,pp,ss))
+            ss << index << '.';
+        } else {
+            auto it = nodeMap.find(node);
+            if(it == nodeMap.end() || !isElementVisible(it->second))
                 return false;
-            subname = ss.str();
-            return true;
+            int nodeIdx = it->second;
+            ++idx;
+            while(nodeArray[nodeIdx]->isGroup) {
+                auto &info = *nodeArray[nodeIdx];
+                if(!info.isLinked())
+                    return false;
+                ss << info.linkInfo->getLinkedName() << '.';
+                idx += 2;
+                if(idx>=path->getLength())
+                    return false;
+                auto iter = nodeMap.find(path->getNode(idx));
+                if(iter == nodeMap.end() || !isElementVisible(iter->second))
+                    return false;
+                nodeIdx = iter->second;
+            }
+            auto &info = *nodeArray[nodeIdx];
+            if(nodeIdx == it->second)
+                ss << it->second << '.';
+            else
+                ss << info.linkInfo->getLinkedName() << '.';
+            if(info.isLinked()) {
+                if(!info.linkInfo->getElementPicked(false,childType,pp,ss))
+                    return false;
+                subname = ss.str();
+                return true;
+            }
         }
     }
 
@@ -1496,7 +1683,16 @@ bool LinkView::linkGetDetailPath(const char *subname, SoFullPath *path, SoDetail
         if(idx<0 || idx>=(int)nodeArray.size()) 
             return false;
 
-        auto &info = *nodeArray[idx];
+        Element *pinfo = nodeArray[idx].get();
+        if(!pinfo) {
+            // An instanced element gets its own nodes on demand, because the
+            // path is used to hold its selection or highlight context.
+            auto self = const_cast<LinkView*>(this);
+            self->mergeDetailElements();
+            pinfo = &self->getElement(idx);
+            self->detailElements.insert(idx);
+        }
+        auto &info = *pinfo;
         appendPath(path,pcLinkRoot);
         if(info.groupIndex>=0 && !getGroupHierarchy(info.groupIndex,path))
             return false;
@@ -1566,10 +1762,13 @@ void LinkView::unlink(LinkInfoPtr info) {
         else {
             for(auto &info : nodeArray) {
                 int idx;
-                if(!info->isLinked() && 
+                if(info && !info->isLinked() && 
                    (idx=info->pcRoot->findChild(pcLinkedRoot))>=0)
                     info->pcRoot->removeChild(idx);
             }
+            int idx;
+            if(pcInstanceArray && (idx=pcInstanceArray->findChild(pcLinkedRoot))>=0)
+                pcInstanceArray->removeChild(idx);
         }
         pcLinkedRoot.reset();
     }
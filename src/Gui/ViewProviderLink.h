@@ -40,6 +40,7 @@ namespace Gui {
 
 class LinkInfo;
 typedef boost::intrusive_ptr<LinkInfo> LinkInfoPtr;
+class SoFCInstanceArray;
 
 class GuiExport ViewProviderLinkObserver: public ViewProviderExtension {
     EXTENSION_TYPESYSTEM_HEADER_WITH_OVERRIDE();
@@ -155,6 +156,7 @@ protected:
     void replaceLinkedRoot(SoSeparator *);
     void resetRoot();
     bool getGroupHierarchy(int index, SoFullPath *path) const;
+    void setupInstanceArray();
 
 protected:
     LinkInfoPtr linkOwner;
@@ -176,6 +178,17 @@ protected:
     std::vector<std::unique_ptr<Element> > nodeArray;
     std::unordered_map<SoNode*,int> nodeMap;
 
+    // For large arrays created by setSize(), all elements are rendered by
+    // this node, and nodeArray only contains the elements that need their
+    // own nodes, e.g. for selection or color override.
+    CoinPtr<SoFCInstanceArray> pcInstanceArray;
+    Element &getElement(int index);
+
+    // Elements that got their own nodes for a detail path. They are merged
+    // back into the instance array once they are no longer (pre)selected.
+    std::set<int> detailElements;
+    void mergeDetailElements();
+
     Py::Object PythonObject;
 };
 
@@ -48,6 +48,7 @@
 // FreeCAD Base header
 #include <Base/Exception.h>
 #include <Base/Sequencer.h>
+#include <Base/StartupTrace.h>
 #include <App/Application.h>
 
 
@@ -227,6 +228,8 @@ PyMOD_INIT_FUNC(FreeCAD)
         printf("Initialization of %s failed:\n%s", appName.c_str(), msg.str().c_str());
     }
 
+    Base::StartupTrace::instance().finish();
+
     free(argv[0]);
     free(argv);
 
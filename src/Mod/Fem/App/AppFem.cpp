@@ -28,6 +28,7 @@
 
 #include <Base/Console.h>
 #include <Base/Interpreter.h>
+#include <App/Application.h>
 #include <CXX/Extensions.hxx>
 
 #include <SMESH_Version.h>
@@ -68,6 +69,7 @@
 #include "FemPostFilter.h"
 #include "FemPostFunction.h"
 #include "PropertyPostDataObject.h"
+#include <vtkSMPTools.h>
 #endif
 
 namespace Fem {
@@ -193,6 +195,10 @@ PyMOD_INIT_FUNC(Fem)
     Fem::FemPostSphereFunction                ::init();
 
     Fem::PropertyPostDataObject               ::init();
+
+    // number of threads used by the multi-threaded vtk filters, 0 lets the SMP backend decide
+    ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath("User parameter:BaseApp/Preferences/Mod/Fem/General");
+    vtkSMPTools::Initialize(static_cast<int>(hGrp->GetInt("VTKThreads", 0)));
 #endif
 
     PyMOD_Return(femModule);
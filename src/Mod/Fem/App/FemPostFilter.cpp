@@ -42,6 +42,8 @@ PROPERTY_SOURCE(Fem::FemPostFilter, Fem::FemPostObject)
 
 
 FemPostFilter::FemPostFilter()
+  : m_outputObject(NULL)
+  , m_outputTime(0)
 {
     ADD_PROPERTY(Input,(0));
 }
@@ -70,25 +72,40 @@ DocumentObjectExecReturn* FemPostFilter::execute(void) {
 
     if(!m_pipelines.empty() && !m_activePipeline.empty()) {
         FemPostFilter::FilterPipeline& pipe = m_pipelines[m_activePipeline];
+        vtkAlgorithm* target = NULL;
         if (m_activePipeline.length() >= 11) {
             std::string LineClip = m_activePipeline.substr(0,13);
             std::string PointClip = m_activePipeline.substr(0,11);
             if ((LineClip == "DataAlongLine") || (PointClip == "DataAtPoint")) {
                 pipe.filterSource->SetSourceData(getInputData());
-                pipe.filterTarget->Update();
-
-                Data.setValue(pipe.filterTarget->GetOutputDataObject(0));
+                target = pipe.filterTarget;
             }
         } else {
             pipe.source->SetInputDataObject(getInputData());
-            pipe.target->Update();
-            Data.setValue(pipe.target->GetOutputDataObject(0));
+            target = pipe.target;
         }
 
+        if (target) {
+            target->Update();
+            setOutputData(target->GetOutputDataObject(0));
+        }
     }
     return StdReturn;
 }
 
+void FemPostFilter::setOutputData(vtkDataObject* output) {
+
+    // vtk only re-executes an algorithm when its input or one of its parameters got modified.
+    // If neither did the output is still the one copied last time, so we neither need to copy
+    // it again nor touch the filters further down the pipeline.
+    if (output && Data.getValue() && output == m_outputObject && output->GetMTime() == m_outputTime)
+        return;
+
+    m_outputObject = output;
+    m_outputTime = output ? output->GetMTime() : 0;
+    Data.setValue(output);
+}
+
 vtkDataObject* FemPostFilter::getInputData() {
 
     if(Input.getValue()) {
@@ -39,6 +39,11 @@
 #include <vtkPointSource.h>
 #include <vtkProbeFilter.h>
 #include <vtkThreshold.h>
+#include <vtkVersion.h>
+
+#if (VTK_MAJOR_VERSION < 7) || ((VTK_MAJOR_VERSION == 7) && (VTK_MINOR_VERSION < 1))
+typedef unsigned long vtkMTimeType;
+#endif
 
 namespace Fem
 {
@@ -58,6 +63,8 @@ public:
 
 protected:
     vtkDataObject* getInputData();
+    /// sets the filter result to Data unless it is unchanged since the last execution
+    void setOutputData(vtkDataObject* output);
 
     //pipeline handling for derived filter
     struct FilterPipeline {
@@ -73,6 +80,9 @@ private:
     //handling of multiple pipelines which can be the filter
     std::map<std::string, FilterPipeline> m_pipelines;
     std::string m_activePipeline;
+    //the last output copied to Data, only used for identification
+    vtkDataObject* m_outputObject;
+    vtkMTimeType m_outputTime;
 };
 
 class AppFemExport FemPostClipFilter : public FemPostFilter {
@@ -92,7 +92,7 @@ DocumentObjectExecReturn* FemPostPipeline::execute(void) {
     if(Mode.getValue() == 0) {
 
         //serial
-        Data.setValue(getLastPostObject()->Data.getValue());
+        setOutputData(getLastPostObject()->Data.getValue());
     }
     else {
 
@@ -107,7 +107,7 @@ DocumentObjectExecReturn* FemPostPipeline::execute(void) {
         }
 
         append->Update();
-        Data.setValue(append->GetOutputDataObject(0));
+        setOutputData(append->GetOutputDataObject(0));
     }
 
 
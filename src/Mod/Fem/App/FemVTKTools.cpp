@@ -25,6 +25,7 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
+# include <algorithm>
 # include <cstdlib>
 # include <memory>
 # include <cmath>
@@ -76,6 +77,8 @@
 # include <vtkQuadraticHexahedron.h>
 #endif
 
+#include <QtConcurrentMap>
+
 #include <Base/FileInfo.h>
 #include <Base/TimeInfo.h>
 #include <Base/Console.h>
@@ -718,6 +721,83 @@ std::map<std::string, std::string> _getFreeCADMechResultScalarProperties() {
 }
 
 
+namespace {
+
+// one result field to be transferred from a vtk data array into a property
+struct ImportField
+{
+    ImportField() : array(nullptr), vectorList(nullptr), floatList(nullptr) {}
+
+    std::string name;
+    vtkDataArray* array;
+    App::PropertyVectorList* vectorList;
+    App::PropertyFloatList* floatList;
+    std::vector<Base::Vector3d> vectors;
+    std::vector<double> scalars;
+};
+
+// one result property to be transferred into a vtk data array
+struct ExportField
+{
+    ExportField() : vectorList(nullptr), floatList(nullptr) {}
+
+    std::string name;
+    const App::PropertyVectorList* vectorList;
+    const App::PropertyFloatList* floatList;
+    vtkSmartPointer<vtkDoubleArray> array;
+};
+
+template<typename T>
+void copyTuples(const T* src, vtkIdType nTuples, std::vector<double>& values)
+{
+    std::copy(src, src + nTuples, values.begin());
+}
+
+template<typename T>
+void copyTuples(const T* src, vtkIdType nTuples, std::vector<Base::Vector3d>& values)
+{
+    for (vtkIdType i = 0; i < nTuples; ++i, src += 3)
+        values[i].Set(src[0], src[1], src[2]);
+}
+
+void copyTuple(const double* tuple, double& value)
+{
+    value = tuple[0];
+}
+
+void copyTuple(const double* tuple, Base::Vector3d& value)
+{
+    value.Set(tuple[0], tuple[1], tuple[2]);
+}
+
+// Copies the tuples of a vtk array into 'values' which must already have its final size.
+// Float and double arrays are read from their contiguous storage, all other types go
+// through the generic (but thread-safe) tuple access of vtkDataArray.
+template<typename TList>
+void copyDataArray(vtkDataArray* array, TList& values)
+{
+    const vtkIdType nTuples = std::min<vtkIdType>(array->GetNumberOfTuples(), static_cast<vtkIdType>(values.size()));
+    switch (array->GetDataType()) {
+    case VTK_DOUBLE:
+        copyTuples(static_cast<const double*>(array->GetVoidPointer(0)), nTuples, values);
+        break;
+    case VTK_FLOAT:
+        copyTuples(static_cast<const float*>(array->GetVoidPointer(0)), nTuples, values);
+        break;
+    default:
+        {
+            double tuple[3];
+            for (vtkIdType i = 0; i < nTuples; ++i) {
+                array->GetTuple(i, tuple);
+                copyTuple(tuple, values[i]);
+            }
+        }
+        break;
+    }
+}
+
+}
+
 void FemVTKTools::importFreeCADResult(vtkSmartPointer<vtkDataSet> dataset, App::DocumentObject* result) {
     Base::Console().Log("Start: import vtk result file data into a FreeCAD result object.\n");
 
@@ -743,21 +823,19 @@ void FemVTKTools::importFreeCADResult(vtkSmartPointer<vtkDataSet> dataset, App::
     static_cast<App::PropertyIntegerList*>(result->getPropertyByName("NodeNumbers"))->setValues(nodeIds);
     Base::Console().Log("    NodeNumbers have been filled with values.\n");
 
-    // vectors
+    // vectors, collect the fields first, the conversion itself runs concurrently
+    std::vector<ImportField> fields;
     for (std::map<std::string, std::string>::iterator it = vectors.begin(); it != vectors.end(); ++it) {
         int dim = 3;  // Fixme: currently 3D only, here we could run into trouble, FreeCAD only supports dim 3D, I do not know about VTK
         vtkDataArray* vector_field = vtkDataArray::SafeDownCast(pd->GetArray(it->second.c_str()));
         if(vector_field && vector_field->GetNumberOfComponents() == dim) {
             App::PropertyVectorList* vector_list = static_cast<App::PropertyVectorList*>(result->getPropertyByName(it->first.c_str()));
             if(vector_list) {
-                std::vector<Base::Vector3d> vec(nPoints);
-                for(vtkIdType i=0; i<nPoints; ++i) {
-                    double *p = vector_field->GetTuple(i); // both vtkFloatArray and vtkDoubleArray return double* for GetTuple(i)
-                    vec[i] = (Base::Vector3d(p[0], p[1], p[2]));
-                }
-                // PropertyVectorList will not show up in PropertyEditor
-                vector_list->setValues(vec);
-                Base::Console().Log("    A PropertyVectorList has been filled with values: %s\n", it->first.c_str());
+                ImportField field;
+                field.name = it->first;
+                field.array = vector_field;
+                field.vectorList = vector_list;
+                fields.push_back(field);
             }
             else {
                 Base::Console().Error("static_cast<App::PropertyVectorList*>((result->getPropertyByName(\"%s\")) failed.\n", it->first.c_str());
@@ -772,28 +850,47 @@ void FemVTKTools::importFreeCADResult(vtkSmartPointer<vtkDataSet> dataset, App::
     for (std::map<std::string, std::string>::iterator it = scalars.begin(); it != scalars.end(); ++it) {
         vtkDataArray* vec = vtkDataArray::SafeDownCast(pd->GetArray(it->second.c_str()));
         if(nPoints && vec && vec->GetNumberOfComponents() == 1) {
-            App::PropertyFloatList* field = static_cast<App::PropertyFloatList*>(result->getPropertyByName(it->first.c_str()));
-            if (!field) {
+            App::PropertyFloatList* float_list = static_cast<App::PropertyFloatList*>(result->getPropertyByName(it->first.c_str()));
+            if (!float_list) {
                 Base::Console().Error("static_cast<App::PropertyFloatList*>((result->getPropertyByName(\"%s\")) failed.\n", it->first.c_str());
                 continue;
             }
 
-            double vmin=1.0e100, vmean=0.0, vmax=-1.0e100;
-            std::vector<double> values(nPoints, 0.0);
-            for(vtkIdType i = 0; i < vec->GetNumberOfTuples(); i++) {
-                double v = *(vec->GetTuple(i));
-                values[i] = v;
-                vmean += v;
-                if(v > vmax) vmax = v;
-                if(v < vmin) vmin = v;
-            }
-            field->setValues(values);
-            Base::Console().Log("    A PropertyFloatList has been filled with vales: %s\n", it->first.c_str());
+            ImportField field;
+            field.name = it->first;
+            field.array = vec;
+            field.floatList = float_list;
+            fields.push_back(field);
         }
         else
             Base::Console().Message("    PropertyFloatList NOT found in vkt file data %s\n", it->first.c_str());
     }
 
+    // the arrays are only read, so every field can be decoded in its own thread
+    QtConcurrent::blockingMap(fields, [nPoints](ImportField& field) {
+        if (field.vectorList) {
+            field.vectors.resize(nPoints);
+            copyDataArray(field.array, field.vectors);
+        }
+        else {
+            field.scalars.resize(nPoints, 0.0);
+            copyDataArray(field.array, field.scalars);
+        }
+    });
+
+    // properties send notifications and therefore must be set from this thread
+    for (std::vector<ImportField>::iterator it = fields.begin(); it != fields.end(); ++it) {
+        if (it->vectorList) {
+            // PropertyVectorList will not show up in PropertyEditor
+            it->vectorList->setValues(it->vectors);
+            Base::Console().Log("    A PropertyVectorList has been filled with values: %s\n", it->name.c_str());
+        }
+        else {
+            it->floatList->setValues(it->scalars);
+            Base::Console().Log("    A PropertyFloatList has been filled with vales: %s\n", it->name.c_str());
+        }
+    }
+
     // stats
     // stats are added by importVTKResults
 
@@ -820,6 +917,16 @@ void FemVTKTools::exportFreeCADResult(const App::DocumentObject* result, vtkSmar
     SMESH_Mesh* smesh = const_cast<SMESH_Mesh*>(static_cast<FemMeshObject*>(meshObj)->FemMesh.getValue().getSMesh());
     SMESHDS_Mesh* meshDS = smesh->GetMeshDS();
 
+    // the smesh node ids might have gaps, vtk fills them with points. Map the n-th result value
+    // to the vtk point it belongs to once, instead of walking the nodes again for every field
+    std::vector<vtkIdType> pointIds;
+    pointIds.reserve(meshDS->NbNodes());
+    SMDS_NodeIteratorPtr aNodeIter = meshDS->nodesIterator();
+    while (aNodeIter->more())
+        pointIds.push_back(aNodeIter->next()->GetID()-1);
+
+    std::vector<ExportField> fields;
+
     // vectors
     for (std::map<std::string, std::string>::iterator it = vectors.begin(); it != vectors.end(); ++it) {
         const int dim=3;  //Fixme, detect dim, but FreeCAD PropertyVectorList ATM only has DIM of 3
@@ -831,31 +938,16 @@ void FemVTKTools::exportFreeCADResult(const App::DocumentObject* result, vtkSmar
         if (field && field->getSize() > 0) {
             //if (nPoints != field->getSize())
             //    Base::Console().Error("Size of PropertyVectorList = %d, not equal to vtk mesh node count %d \n", field->getSize(), nPoints);
-            const std::vector<Base::Vector3d>& vel = field->getValues();
-            vtkSmartPointer<vtkDoubleArray> data = vtkSmartPointer<vtkDoubleArray>::New();
-            data->SetNumberOfComponents(dim);
-            data->SetNumberOfTuples(nPoints);
-            data->SetName(it->second.c_str());
-
-            //we need to set values for the unused points.
-            //TODO: ensure that the result bar does not include the used 0 if it is not part of the result (e.g. does the result bar show 0 as smallest value?)
-            if (nPoints != field->getSize()) {
-                double tuple[] = {0,0,0};
-                for (vtkIdType i=0; i<nPoints; ++i) {
-                    data->SetTuple(i, tuple);
-                }
-            }
-
-            SMDS_NodeIteratorPtr aNodeIter = meshDS->nodesIterator();
-            for (std::vector<Base::Vector3d>::const_iterator jt=vel.begin(); jt!=vel.end(); ++jt) {
-                const SMDS_MeshNode* node = aNodeIter->next();
-                double tuple[] = {jt->x, jt->y, jt->z};
-                data->SetTuple(node->GetID()-1, tuple);
-            }
-            grid->GetPointData()->AddArray(data);
-            Base::Console().Log("    The PropertyVectorList %s was exported to VTK vector list: %s\n", it->first.c_str(), it->second.c_str());
+            ExportField data;
+            data.name = it->first;
+            data.vectorList = field;
+            data.array = vtkSmartPointer<vtkDoubleArray>::New();
+            data.array->SetNumberOfComponents(dim);
+            data.array->SetNumberOfTuples(nPoints);
+            data.array->SetName(it->second.c_str());
+            fields.push_back(data);
         }
-        else
+        else if (field)
             Base::Console().Log("    PropertyVectorList NOT exported to vtk: %s size is: %i\n", it->first.c_str(), field->getSize());
     }
 
@@ -869,30 +961,51 @@ void FemVTKTools::exportFreeCADResult(const App::DocumentObject* result, vtkSmar
         if (field && field->getSize() > 0) {
             //if (nPoints != field->getSize())
             //    Base::Console().Error("Size of PropertyFloatList = %d, not equal to vtk mesh node count %d \n", field->getSize(), nPoints);
-            const std::vector<double>& vec = field->getValues();
-            vtkSmartPointer<vtkDoubleArray> data = vtkSmartPointer<vtkDoubleArray>::New();
-            data->SetNumberOfValues(nPoints);
-            data->SetName(it->second.c_str());
-
-            //we need to set values for the unused points.
-            //TODO: ensure that the result bar does not include the used 0 if it is not part of the result (e.g. does the result bar show 0 as smallest value?)
-            if (nPoints != field->getSize()) {
-                for (vtkIdType i=0; i<nPoints; ++i) {
-                    data->SetValue(i, 0);
-                }
-             }
-
-            SMDS_NodeIteratorPtr aNodeIter = meshDS->nodesIterator();
-            for (size_t i=0; i<vec.size(); ++i) {
-                const SMDS_MeshNode* node = aNodeIter->next();
-                data->SetValue(node->GetID()-1, vec[i]);
+            ExportField data;
+            data.name = it->first;
+            data.floatList = field;
+            data.array = vtkSmartPointer<vtkDoubleArray>::New();
+            data.array->SetNumberOfValues(nPoints);
+            data.array->SetName(it->second.c_str());
+            fields.push_back(data);
+        }
+        else if (field)
+            Base::Console().Log("    PropertyFloatList NOT exported to vtk: %s size is: %i\n", it->first.c_str(), field->getSize());
+    }
+
+    // every field writes into its own array, so they can be filled concurrently
+    QtConcurrent::blockingMap(fields, [nPoints, &pointIds](ExportField& field) {
+        double* dest = field.array->GetPointer(0);
+        const int dim = field.array->GetNumberOfComponents();
+        const std::size_t count = std::min<std::size_t>(field.vectorList ? field.vectorList->getSize()
+                                                                         : field.floatList->getSize(),
+                                                        pointIds.size());
+
+        //we need to set values for the unused points.
+        //TODO: ensure that the result bar does not include the used 0 if it is not part of the result (e.g. does the result bar show 0 as smallest value?)
+        if (static_cast<vtkIdType>(count) != nPoints)
+            std::fill(dest, dest + nPoints * dim, 0.0);
+
+        if (field.vectorList) {
+            const std::vector<Base::Vector3d>& vel = field.vectorList->getValues();
+            for (std::size_t i=0; i<count; ++i) {
+                double* tuple = dest + pointIds[i] * dim;
+                tuple[0] = vel[i].x;
+                tuple[1] = vel[i].y;
+                tuple[2] = vel[i].z;
             }
+        }
+        else {
+            const std::vector<double>& vec = field.floatList->getValues();
+            for (std::size_t i=0; i<count; ++i)
+                dest[pointIds[i]] = vec[i];
+        }
+    });
 
-            grid->GetPointData()->AddArray(data);
-            Base::Console().Log("    The PropertyFloatList %s was exported to VTK scalar list: %s\n", it->first.c_str(), it->second.c_str());
-       }
-        else
-            Base::Console().Log("    PropertyFloatList NOT exported to vtk: %s size is: %i\n", it->first.c_str(), field->getSize());
+    for (std::vector<ExportField>::iterator it = fields.begin(); it != fields.end(); ++it) {
+        grid->GetPointData()->AddArray(it->array);
+        Base::Console().Log("    The %s %s was exported to VTK list: %s\n",
+            it->vectorList ? "PropertyVectorList" : "PropertyFloatList", it->name.c_str(), it->array->GetName());
     }
 
     Base::Console().Log("End: Create VTK result data from FreeCAD result data.\n");
@@ -427,7 +427,11 @@ private:
             ImpExpDxfRead dxf_file(EncodedName,pcDoc);
             dxf_file.setOptionSource(defaultOptions);
             dxf_file.setOptions();
-            dxf_file.DoRead(IgnoreErrors);
+            {
+                // the reader may add an object per entity
+                App::DocumentBulkInsert bulk(pcDoc);
+                dxf_file.DoRead(IgnoreErrors);
+            }
             pcDoc->recompute();
         }
         catch (const Standard_Failure& e) {
@@ -50,6 +50,8 @@
 
 #include <XCAFDoc_ShapeMapTool.hxx>
 
+#include <QtConcurrentMap>
+
 #include <boost/regex.hpp>
 #include <boost/algorithm/string.hpp>
 #include <Base/Parameter.h>
@@ -339,71 +341,41 @@ bool ImportOCAF2::createObject(App::Document *doc, TDF_Label label,
     std::vector<App::Color> faceColors;
     std::vector<App::Color> edgeColors;
 
-    TDF_LabelSequence seq;
-    if(!label.IsNull() && aShapeTool->GetSubShapes(label,seq)) {
-
-        TopTools_IndexedMapOfShape faceMap,edgeMap;
-        TopExp::MapShapes(tshape.getShape(), TopAbs_FACE, faceMap);
-        TopExp::MapShapes(tshape.getShape(), TopAbs_EDGE, edgeMap);
-
-        faceColors.assign(faceMap.Extent(),info.faceColor);
-        edgeColors.assign(edgeMap.Extent(),info.edgeColor);
-        // Two passes to get sub shape colors. First pass, look for solid, and
-        // second pass look for face and edges. This allows lower level
-        // subshape to override color of higher level ones.
-        for(int j=0;j<2;++j) {
-            for(int i=1;i<=seq.Length();++i) {
-                TDF_Label l = seq.Value(i);
-                TopoDS_Shape subShape = aShapeTool->GetShape(l);
-                if(subShape.IsNull())
-                    continue;
-                if(subShape.ShapeType()==TopAbs_FACE || subShape.ShapeType()==TopAbs_EDGE) {
-                    if(j==0)
-                        continue;
-                }else if(j!=0)
-                    continue;
-
-                bool foundFaceColor=false,foundEdgeColor=false;
-                App::Color faceColor,edgeColor;
-                Quantity_Color aColor;
-                if(aColorTool->GetColor(l, XCAFDoc_ColorSurf, aColor) ||
-                   aColorTool->GetColor(l, XCAFDoc_ColorGen, aColor))
-                {
-                    faceColor = App::Color(aColor.Red(),aColor.Green(),aColor.Blue());
-                    foundFaceColor = true;
-                }
-                if(aColorTool->GetColor(l, XCAFDoc_ColorCurv, aColor)) {
-                    edgeColor = App::Color(aColor.Red(),aColor.Green(),aColor.Blue());
-                    foundEdgeColor = true;
-                    if(j==0 && foundFaceColor && faceColors.size() && edgeColor==faceColor) {
-                        // Do not set edge the same color as face
-                        foundEdgeColor = false;
-                    }
-                }
+    // Use the sub shape colors prepared in loadShapes() if possible
+    SubShapeColors subColors;
+    const SubShapeColors *colors = 0;
+    auto itColors = label.IsNull()?mySubShapeColors.end():mySubShapeColors.find(label);
+    if(itColors!=mySubShapeColors.end() && itColors->second.shape.IsEqual(shape))
+        colors = &itColors->second;
+    else {
+        TDF_LabelSequence seq;
+        if(!label.IsNull() && aShapeTool->GetSubShapes(label,seq)) {
+            std::vector<TDF_Label> subLabels;
+            for(int i=1;i<=seq.Length();++i)
+                subLabels.push_back(seq.Value(i));
+            subColors.shape = shape;
+            getSubShapeColors(subLabels,subColors);
+            colors = &subColors;
+        }
+    }
 
-                if(foundFaceColor) {
-                    for(TopExp_Explorer exp(subShape,TopAbs_FACE);exp.More();exp.Next()) {
-                        int idx = faceMap.FindIndex(exp.Current())-1;
-                        if(idx>=0 && idx<(int)faceColors.size()) {
-                            faceColors[idx] = faceColor;
-                            hasFaceColors = true;
-                            info.hasFaceColor = true;
-                        }else
-                            assert(0);
-                    }
-                }
-                if(foundEdgeColor) {
-                    for(TopExp_Explorer exp(subShape,TopAbs_EDGE);exp.More();exp.Next()) {
-                        int idx = edgeMap.FindIndex(exp.Current())-1;
-                        if(idx>=0 && idx<(int)edgeColors.size()) {
-                            edgeColors[idx] = edgeColor;
-                            hasEdgeColors = true;
-                            info.hasEdgeColor = true;
-                        }
-                    }
-                }
-            }
+    if(colors && colors->hasFaceColors.any()) {
+        faceColors = colors->faceColors;
+        for(size_t i=0;i<faceColors.size();++i) {
+            if(!colors->hasFaceColors[i])
+                faceColors[i] = info.faceColor;
+        }
+        hasFaceColors = true;
+        info.hasFaceColor = true;
+    }
+    if(colors && colors->hasEdgeColors.any()) {
+        edgeColors = colors->edgeColors;
+        for(size_t i=0;i<edgeColors.size();++i) {
+            if(!colors->hasEdgeColors[i])
+                edgeColors[i] = info.edgeColor;
         }
+        hasEdgeColors = true;
+        info.hasEdgeColor = true;
     }
 
     Part::Feature *feature;
@@ -434,6 +406,125 @@ bool ImportOCAF2::createObject(App::Document *doc, TDF_Label label,
     return true;
 }
 
+void ImportOCAF2::getSubShapeColors(const std::vector<TDF_Label> &subLabels,
+                                    SubShapeColors &colors) const
+{
+    // Only label based queries are used here, because this function is
+    // called from worker threads by prepareSubShapeColors().
+    TopTools_IndexedMapOfShape faceMap,edgeMap;
+    TopExp::MapShapes(colors.shape, TopAbs_FACE, faceMap);
+    TopExp::MapShapes(colors.shape, TopAbs_EDGE, edgeMap);
+
+    colors.faceColors.assign(faceMap.Extent(),App::Color());
+    colors.edgeColors.assign(edgeMap.Extent(),App::Color());
+    colors.hasFaceColors.resize(faceMap.Extent());
+    colors.hasEdgeColors.resize(edgeMap.Extent());
+
+    // Two passes to get sub shape colors. First pass, look for solid, and
+    // second pass look for face and edges. This allows lower level
+    // subshape to override color of higher level ones.
+    for(int j=0;j<2;++j) {
+        for(const auto &l : subLabels) {
+            TopoDS_Shape subShape = XCAFDoc_ShapeTool::GetShape(l);
+            if(subShape.IsNull())
+                continue;
+            if(subShape.ShapeType()==TopAbs_FACE || subShape.ShapeType()==TopAbs_EDGE) {
+                if(j==0)
+                    continue;
+            }else if(j!=0)
+                continue;
+
+            bool foundFaceColor=false,foundEdgeColor=false;
+            App::Color faceColor,edgeColor;
+            Quantity_Color aColor;
+            if(aColorTool->GetColor(l, XCAFDoc_ColorSurf, aColor) ||
+               aColorTool->GetColor(l, XCAFDoc_ColorGen, aColor))
+            {
+                faceColor = App::Color(aColor.Red(),aColor.Green(),aColor.Blue());
+                foundFaceColor = true;
+            }
+            if(aColorTool->GetColor(l, XCAFDoc_ColorCurv, aColor)) {
+                edgeColor = App::Color(aColor.Red(),aColor.Green(),aColor.Blue());
+                foundEdgeColor = true;
+                if(j==0 && foundFaceColor && colors.faceColors.size() && edgeColor==faceColor) {
+                    // Do not set edge the same color as face
+                    foundEdgeColor = false;
+                }
+            }
+
+            if(foundFaceColor) {
+                for(TopExp_Explorer exp(subShape,TopAbs_FACE);exp.More();exp.Next()) {
+                    int idx = faceMap.FindIndex(exp.Current())-1;
+                    if(idx>=0 && idx<(int)colors.faceColors.size()) {
+                        colors.faceColors[idx] = faceColor;
+                        colors.hasFaceColors[idx] = true;
+                    }else
+                        assert(0);
+                }
+            }
+            if(foundEdgeColor) {
+                for(TopExp_Explorer exp(subShape,TopAbs_EDGE);exp.More();exp.Next()) {
+                    int idx = edgeMap.FindIndex(exp.Current())-1;
+                    if(idx>=0 && idx<(int)colors.edgeColors.size()) {
+                        colors.edgeColors[idx] = edgeColor;
+                        colors.hasEdgeColors[idx] = true;
+                    }
+                }
+            }
+        }
+    }
+}
+
+void ImportOCAF2::prepareSubShapeColors()
+{
+    mySubShapeColors.clear();
+
+    struct Job {
+        TDF_Label label;
+        std::vector<TDF_Label> subLabels;
+        SubShapeColors colors;
+        bool done = false;
+    };
+
+    // The shapes with sub shape labels are collected here, and only the
+    // mapping of their sub shapes and the color lookup run concurrently.
+    std::vector<Job> jobs;
+    TDF_LabelSequence labels;
+    aShapeTool->GetShapes(labels);
+    for(int i=1;i<=labels.Length();++i) {
+        TDF_Label label = labels.Value(i);
+        if(aShapeTool->IsAssembly(label))
+            continue;
+        TDF_LabelSequence seq;
+        if(!aShapeTool->GetSubShapes(label,seq))
+            continue;
+        TopoDS_Shape shape = aShapeTool->GetShape(label);
+        if(shape.IsNull())
+            continue;
+        jobs.emplace_back();
+        Job &job = jobs.back();
+        job.label = label;
+        job.colors.shape = shape.Located(TopLoc_Location());
+        for(int j=1;j<=seq.Length();++j)
+            job.subLabels.push_back(seq.Value(j));
+    }
+
+    QtConcurrent::blockingMap(jobs, [this](Job &job) {
+        try {
+            getSubShapeColors(job.subLabels,job.colors);
+            job.done = true;
+        } catch (Standard_Failure &) {
+            // leave it to createObject()
+        }
+    });
+
+    for(auto &job : jobs) {
+        if(job.done)
+            mySubShapeColors.emplace(job.label,std::move(job.colors));
+    }
+    FC_LOG("prepared colors of " << mySubShapeColors.size() << " shapes");
+}
+
 App::Document *ImportOCAF2::getDocument(App::Document *doc, TDF_Label label) {
     if(filePath.empty() || mode==SingleDoc || merge)
         return doc;
@@ -537,7 +628,8 @@ App::DocumentObject* ImportOCAF2::loadShapes()
 
     TDF_LabelSequence labels;
     aShapeTool->GetShapes(labels);
-    Base::SequencerLauncher seq("Importing...",labels.Length());
+    int shapeCount = labels.Length();
+    Base::SequencerLauncher seq("Importing...",shapeCount);
     FC_MSG("free shape count " << labels.Length());
     sequencer = showProgress?&seq:0;
 
@@ -546,6 +638,11 @@ App::DocumentObject* ImportOCAF2::loadShapes()
     myNames.clear();
     myCollapsedObjects.clear();
 
+    FC_TIME_INIT(t);
+    prepareSubShapeColors();
+    FC_TIME_LOG(t,"prepare colors");
+    FC_TIME_INIT(t1);
+
     std::vector<App::DocumentObject*> objs;
     aShapeTool->GetFreeShapes (labels);
     boost::dynamic_bitset<> vis;
@@ -556,28 +653,38 @@ App::DocumentObject* ImportOCAF2::loadShapes()
             continue;
         ++count;
     }
-    for (Standard_Integer i=1; i <= labels.Length(); i++ ) {
-        auto label = labels.Value(i);
-        if(!importHidden && !aColorTool->IsVisible(label))
-            continue;
-        auto obj = loadShape(pDocument, label, 
-                aShapeTool->GetShape(label), false, count>1);
-        if(obj) {
-            objs.push_back(obj);
-            vis.push_back(aColorTool->IsVisible(label));
-        }
-    }
     App::DocumentObject *ret = 0;
-    if(objs.size()==1) {
-        ret = objs.front();
-    }else {
-        Info info;
-        if(createGroup(pDocument,info,TopoDS_Shape(),objs,vis))
-            ret = info.obj;
+    {
+        // Create the objects in one bulk insertion to avoid scanning all
+        // existing names and labels for each new object, and to let the views
+        // insert the objects at once.
+        App::DocumentBulkInsert bulk(pDocument, shapeCount);
+        for (Standard_Integer i=1; i <= labels.Length(); i++ ) {
+            auto label = labels.Value(i);
+            if(!importHidden && !aColorTool->IsVisible(label))
+                continue;
+            auto obj = loadShape(pDocument, label, 
+                    aShapeTool->GetShape(label), false, count>1);
+            if(obj) {
+                objs.push_back(obj);
+                vis.push_back(aColorTool->IsVisible(label));
+            }
+        }
+        if(objs.size()==1) {
+            ret = objs.front();
+        }else {
+            Info info;
+            if(createGroup(pDocument,info,TopoDS_Shape(),objs,vis))
+                ret = info.obj;
+        }
     }
+    mySubShapeColors.clear();
+    FC_TIME_LOG(t1,"create objects");
     if(ret) {
+        FC_TIME_INIT(t2);
         // ret->Visibility.setValue(true);
         ret->recomputeFeature(true);
+        FC_TIME_LOG(t2,"recompute");
     }
     if(merge && ret && !ret->isDerivedFrom(Part::Feature::getClassTypeId())) {
         auto shape = Part::Feature::getTopoShape(ret);
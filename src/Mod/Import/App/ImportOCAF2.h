@@ -104,6 +104,15 @@ private:
         int free = true;
     };
 
+    /// Colors assigned to the faces and edges of a shape through its sub shape labels
+    struct SubShapeColors {
+        TopoDS_Shape shape;
+        std::vector<App::Color> faceColors;
+        std::vector<App::Color> edgeColors;
+        boost::dynamic_bitset<> hasFaceColors;
+        boost::dynamic_bitset<> hasEdgeColors;
+    };
+
     App::DocumentObject *loadShape(App::Document *doc, TDF_Label label, 
             const TopoDS_Shape &shape, bool baseOnly=false, bool newDoc=true);
     App::Document *getDocument(App::Document *doc, TDF_Label label);
@@ -116,6 +125,8 @@ private:
             const boost::dynamic_bitset<> &visibilities, bool canReduce=false);
     bool getColor(const TopoDS_Shape &shape, Info &info, bool check=false, bool noDefault=false);
     void getSHUOColors(TDF_Label label, std::map<std::string,App::Color> &colors, bool appendFirst);
+    void getSubShapeColors(const std::vector<TDF_Label> &subLabels, SubShapeColors &colors) const;
+    void prepareSubShapeColors();
     void setObjectName(Info &info, TDF_Label label);
     std::string getLabelName(TDF_Label label);
     App::DocumentObject *expandShape(App::Document *doc, TDF_Label label, const TopoDS_Shape &shape);
@@ -160,6 +171,7 @@ private:
     std::unordered_map<TopoDS_Shape, Info, ShapeHasher> myShapes;
     std::unordered_map<TDF_Label, std::string, LabelHasher> myNames;
     std::unordered_map<App::DocumentObject*, App::PropertyPlacement*> myCollapsedObjects;
+    std::unordered_map<TDF_Label, SubShapeColors, LabelHasher> mySubShapeColors;
 
     App::Color defaultFaceColor;
     App::Color defaultEdgeColor;
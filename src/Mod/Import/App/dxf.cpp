@@ -1752,14 +1752,19 @@ CDxfRead::CDxfRead(const char* filepath)
     memset( m_section_name, '\0', sizeof(m_section_name) );
     memset( m_block_name, '\0', sizeof(m_block_name) );
     m_ignore_errors = true;
+    m_buffer_pos = 0;
+    m_buffer_end = 0;
+    m_eof = false;
 
-    m_ifs = new ifstream(filepath);
+    m_ifs = new ifstream(filepath, ios::in | ios::binary);
     if(!(*m_ifs)){
         m_fail = true;
+        m_eof = true;
         printf("DXF file didn't load\n");
         return;
     }
     m_ifs->imbue(std::locale("C"));
+    m_buffer.resize(1024 * 1024);
 
 }
 
@@ -1809,19 +1814,17 @@ bool CDxfRead::ReadLine()
     double e[3] = {0, 0, 0};
     bool hidden = false;
 
-    while(!((*m_ifs).eof()))
+    while(!m_eof)
     {
         get_line();
         int n;
 
-        if(sscanf(m_str, "%d", &n) != 1)
+        if(!get_value(n))
         {
             printf("CDxfRead::ReadLine() Failed to read integer from '%s'\n", m_str );
             return false;
         }
 
-        std::istringstream ss;
-        ss.imbue(std::locale("C"));
         switch(n){
             case 0:
                 // next item found, so finish with line
@@ -1843,37 +1846,43 @@ bool CDxfRead::ReadLine()
             case 10:
                 // start x
                 get_line();
-                ss.str(m_str); ss >> s[0]; s[0] = mm(s[0]); if(ss.fail()) return false;
+                if(!get_value(s[0])) return false;
+                s[0] = mm(s[0]);
                 break;
             case 20:
                 // start y
                 get_line();
-                ss.str(m_str); ss >> s[1]; s[1] = mm(s[1]); if(ss.fail()) return false;
+                if(!get_value(s[1])) return false;
+                s[1] = mm(s[1]);
                 break;
             case 30:
                 // start z
                 get_line();
-                ss.str(m_str); ss >> s[2]; s[2] = mm(s[2]); if(ss.fail()) return false;
+                if(!get_value(s[2])) return false;
+                s[2] = mm(s[2]);
                 break;
             case 11:
                 // end x
                 get_line();
-                ss.str(m_str); ss >> e[0]; e[0] = mm(e[0]); if(ss.fail()) return false;
+                if(!get_value(e[0])) return false;
+                e[0] = mm(e[0]);
                 break;
             case 21:
                 // end y
                 get_line();
-                ss.str(m_str); ss >> e[1]; e[1] = mm(e[1]); if(ss.fail()) return false;
+                if(!get_value(e[1])) return false;
+                e[1] = mm(e[1]);
                 break;
             case 31:
                 // end z
                 get_line();
-                ss.str(m_str); ss >> e[2]; e[2] = mm(e[2]); if(ss.fail()) return false;
+                if(!get_value(e[2])) return false;
+                e[2] = mm(e[2]);
                 break;
                 case 62:
                 // color index
                 get_line();
-                ss.str(m_str); ss >> m_aci; if(ss.fail()) return false;
+                if(!get_value(m_aci)) return false;
                 break;
 
             case 100:
@@ -1907,19 +1916,17 @@ bool CDxfRead::ReadPoint()
 {
     double s[3] = {0, 0, 0};
 
-    while(!((*m_ifs).eof()))
+    while(!m_eof)
     {
         get_line();
         int n;
 
-        if(sscanf(m_str, "%d", &n) != 1)
+        if(!get_value(n))
         {
             printf("CDxfRead::ReadPoint() Failed to read integer from '%s'\n", m_str );
             return false;
         }
 
-        std::istringstream ss;
-        ss.imbue(std::locale("C"));
         switch(n){
             case 0:
                 // next item found, so finish with line
@@ -1935,23 +1942,26 @@ bool CDxfRead::ReadPoint()
             case 10:
                 // start x
                 get_line();
-                ss.str(m_str); ss >> s[0]; s[0] = mm(s[0]); if(ss.fail()) return false;
+                if(!get_value(s[0])) return false;
+                s[0] = mm(s[0]);
                 break;
             case 20:
                 // start y
                 get_line();
-                ss.str(m_str); ss >> s[1]; s[1] = mm(s[1]); if(ss.fail()) return false;
+                if(!get_value(s[1])) return false;
+                s[1] = mm(s[1]);
                 break;
             case 30:
                 // start z
                 get_line();
-                ss.str(m_str); ss >> s[2]; s[2] = mm(s[2]); if(ss.fail()) return false;
+                if(!get_value(s[2])) return false;
+                s[2] = mm(s[2]);
                 break;
 
                 case 62:
                 // color index
                 get_line();
-                ss.str(m_str); ss >> m_aci; if(ss.fail()) return false;
+                if(!get_value(m_aci)) return false;
                 break;
 
             case 100:
@@ -1991,18 +2001,16 @@ bool CDxfRead::ReadArc()
     double z_extrusion_dir = 1.0;
     bool hidden = false;
     
-    while(!((*m_ifs).eof()))
+    while(!m_eof)
     {
         get_line();
         int n;
-        if(sscanf(m_str, "%d", &n) != 1)
+        if(!get_value(n))
         {
             printf("CDxfRead::ReadArc() Failed to read integer from '%s'\n", m_str);
             return false;
         }
 
-        std::istringstream ss;
-        ss.imbue(std::locale("C"));
         switch(n){
             case 0:
                 // next item found, so finish with arc
@@ -2024,37 +2032,41 @@ bool CDxfRead::ReadArc()
             case 10:
                 // centre x
                 get_line();
-                ss.str(m_str); ss >> c[0]; c[0] = mm(c[0]); if(ss.fail()) return false;
+                if(!get_value(c[0])) return false;
+                c[0] = mm(c[0]);
                 break;
             case 20:
                 // centre y
                 get_line();
-                ss.str(m_str); ss >> c[1]; c[1] = mm(c[1]); if(ss.fail()) return false;
+                if(!get_value(c[1])) return false;
+                c[1] = mm(c[1]);
                 break;
             case 30:
                 // centre z
                 get_line();
-                ss.str(m_str); ss >> c[2]; c[2] = mm(c[2]); if(ss.fail()) return false;
+                if(!get_value(c[2])) return false;
+                c[2] = mm(c[2]);
                 break;
             case 40:
                 // radius
                 get_line();
-                ss.str(m_str); ss >> radius; radius = mm(radius); if(ss.fail()) return false;
+                if(!get_value(radius)) return false;
+                radius = mm(radius);
                 break;
             case 50:
                 // start angle
                 get_line();
-                ss.str(m_str); ss >> start_angle; if(ss.fail()) return false;
+                if(!get_value(start_angle)) return false;
                 break;
             case 51:
                 // end angle
                 get_line();
-                ss.str(m_str); ss >> end_angle; if(ss.fail()) return false;
+                if(!get_value(end_angle)) return false;
                 break;
                 case 62:
                 // color index
                 get_line();
-                ss.str(m_str); ss >> m_aci; if(ss.fail()) return false;
+                if(!get_value(m_aci)) return false;
                 break;
 
 
@@ -2069,7 +2081,7 @@ bool CDxfRead::ReadArc()
             case 230:
                 //Z extrusion direction for arc 
                 get_line();
-                ss.str(m_str); ss >> z_extrusion_dir; if(ss.fail()) return false;                                
+                if(!get_value(z_extrusion_dir)) return false;
                 break;
 
             default:
@@ -2097,17 +2109,15 @@ bool CDxfRead::ReadSpline()
 
     double temp_double;
 
-    while(!((*m_ifs).eof()))
+    while(!m_eof)
     {
         get_line();
         int n;
-        if(sscanf(m_str, "%d", &n) != 1)
+        if(!get_value(n))
         {
             printf("CDxfRead::ReadSpline() Failed to read integer from '%s'\n", m_str);
             return false;
         }
-        std::istringstream ss;
-        ss.imbue(std::locale("C"));
         switch(n){
             case 0:
                 // next item found, so finish with Spline
@@ -2121,130 +2131,144 @@ bool CDxfRead::ReadSpline()
                 case 62:
                 // color index
                 get_line();
-                ss.str(m_str); ss >> m_aci; if(ss.fail()) return false;
+                if(!get_value(m_aci)) return false;
                 break;
             case 210:
                 // normal x
                 get_line();
-                ss.str(m_str); ss >> sd.norm[0]; if(ss.fail()) return false;
+                if(!get_value(sd.norm[0])) return false;
                 break;
             case 220:
                 // normal y
                 get_line();
-                ss.str(m_str); ss >> sd.norm[1]; if(ss.fail()) return false;
+                if(!get_value(sd.norm[1])) return false;
                 break;
             case 230:
                 // normal z
                 get_line();
-                ss.str(m_str); ss >> sd.norm[2]; if(ss.fail()) return false;
+                if(!get_value(sd.norm[2])) return false;
                 break;
             case 70:
                 // flag
                 get_line();
-                ss.str(m_str); ss >> sd.flag; if(ss.fail()) return false;
+                if(!get_value(sd.flag)) return false;
                 break;
             case 71:
                 // degree
                 get_line();
-                ss.str(m_str); ss >> sd.degree; if(ss.fail()) return false;
+                if(!get_value(sd.degree)) return false;
                 break;
             case 72:
                 // knots
                 get_line();
-                ss.str(m_str); ss >> sd.knots; if(ss.fail()) return false;
+                if(!get_value(sd.knots)) return false;
                 break;
             case 73:
                 // control points
                 get_line();
-                ss.str(m_str); ss >> sd.control_points; if(ss.fail()) return false;
+                if(!get_value(sd.control_points)) return false;
                 break;
             case 74:
                 // fit points
                 get_line();
-                ss.str(m_str); ss >> sd.fit_points; if(ss.fail()) return false;
+                if(!get_value(sd.fit_points)) return false;
                 break;
             case 12:
                 // starttan x
                 get_line();
-                ss.str(m_str); ss >> temp_double; temp_double = mm(temp_double); if(ss.fail()) return false;
+                if(!get_value(temp_double)) return false;
+                temp_double = mm(temp_double);
                 sd.starttanx.push_back(temp_double);
                 break;
             case 22:
                 // starttan y
                 get_line();
-                ss.str(m_str); ss >> temp_double; temp_double = mm(temp_double); if(ss.fail()) return false;
+                if(!get_value(temp_double)) return false;
+                temp_double = mm(temp_double);
                 sd.starttany.push_back(temp_double);
                 break;
             case 32:
                 // starttan z
                 get_line();
-                ss.str(m_str); ss >> temp_double; temp_double = mm(temp_double); if(ss.fail()) return false;
+                if(!get_value(temp_double)) return false;
+                temp_double = mm(temp_double);
                 sd.starttanz.push_back(temp_double);
                 break;
             case 13:
                 // endtan x
                 get_line();
-                ss.str(m_str); ss >> temp_double; temp_double = mm(temp_double); if(ss.fail()) return false;
+                if(!get_value(temp_double)) return false;
+                temp_double = mm(temp_double);
                 sd.endtanx.push_back(temp_double);
                 break;
             case 23:
                 // endtan y
                 get_line();
-                ss.str(m_str); ss >> temp_double; temp_double = mm(temp_double); if(ss.fail()) return false;
+                if(!get_value(temp_double)) return false;
+                temp_double = mm(temp_double);
                 sd.endtany.push_back(temp_double);
                 break;
             case 33:
                 // endtan z
                 get_line();
-                ss.str(m_str); ss >> temp_double; temp_double = mm(temp_double); if(ss.fail()) return false;
+                if(!get_value(temp_double)) return false;
+                temp_double = mm(temp_double);
                 sd.endtanz.push_back(temp_double);
                 break;
             case 40:
                 // knot
                 get_line();
-                ss.str(m_str); ss >> temp_double; temp_double = mm(temp_double); if(ss.fail()) return false;
+                if(!get_value(temp_double)) return false;
+                temp_double = mm(temp_double);
                 sd.knot.push_back(temp_double);
                 break;
             case 41:
                 // weight
                 get_line();
-                ss.str(m_str); ss >> temp_double; temp_double = mm(temp_double); if(ss.fail()) return false;
+                if(!get_value(temp_double)) return false;
+                temp_double = mm(temp_double);
                 sd.weight.push_back(temp_double);
                 break;
             case 10:
                 // control x
                 get_line();
-                ss.str(m_str); ss >> temp_double; temp_double = mm(temp_double); if(ss.fail()) return false;
+                if(!get_value(temp_double)) return false;
+                temp_double = mm(temp_double);
                 sd.controlx.push_back(temp_double);
                 break;
             case 20:
                 // control y
                 get_line();
-                ss.str(m_str); ss >> temp_double; temp_double = mm(temp_double); if(ss.fail()) return false;
+                if(!get_value(temp_double)) return false;
+                temp_double = mm(temp_double);
                 sd.controly.push_back(temp_double);
                 break;
             case 30:
                 // control z
                 get_line();
-                ss.str(m_str); ss >> temp_double; temp_double = mm(temp_double); if(ss.fail()) return false;
+                if(!get_value(temp_double)) return false;
+                temp_double = mm(temp_double);
                 sd.controlz.push_back(temp_double);
                 break;
             case 11:
                 // fit x
                 get_line();
-                ss.str(m_str); ss >> temp_double; temp_double = mm(temp_double); if(ss.fail()) return false;
+                if(!get_value(temp_double)) return false;
+                temp_double = mm(temp_double);
                 sd.fitx.push_back(temp_double);
                 break;
             case 21:
                 // fit y
                 get_line();
-                ss.str(m_str); ss >> temp_double; temp_double = mm(temp_double); if(ss.fail()) return false;
+                if(!get_value(temp_double)) return false;
+                temp_double = mm(temp_double);
                 sd.fity.push_back(temp_double);
                 break;
             case 31:
                 // fit z
                 get_line();
-                ss.str(m_str); ss >> temp_double; temp_double = mm(temp_double); if(ss.fail()) return false;
+                if(!get_value(temp_double)) return false;
+                temp_double = mm(temp_double);
                 sd.fitz.push_back(temp_double);
                 break;
             case 42:
@@ -2271,17 +2295,15 @@ bool CDxfRead::ReadCircle()
     double c[3] = {0,0,0}; // centre
     bool hidden = false;
 
-    while(!((*m_ifs).eof()))
+    while(!m_eof)
     {
         get_line();
         int n;
-        if(sscanf(m_str, "%d", &n) != 1)
+        if(!get_value(n))
         {
             printf("CDxfRead::ReadCircle() Failed to read integer from '%s'\n", m_str);
             return false;
         }
-        std::istringstream ss;
-        ss.imbue(std::locale("C"));
         switch(n){
             case 0:
                 // next item found, so finish with Circle
@@ -2303,27 +2325,31 @@ bool CDxfRead::ReadCircle()
             case 10:
                 // centre x
                 get_line();
-                ss.str(m_str); ss >> c[0]; c[0] = mm(c[0]); if(ss.fail()) return false;
+                if(!get_value(c[0])) return false;
+                c[0] = mm(c[0]);
                 break;
             case 20:
                 // centre y
                 get_line();
-                ss.str(m_str); ss >> c[1]; c[1] = mm(c[1]); if(ss.fail()) return false;
+                if(!get_value(c[1])) return false;
+                c[1] = mm(c[1]);
                 break;
             case 30:
                 // centre z
                 get_line();
-                ss.str(m_str); ss >> c[2]; c[2] = mm(c[2]); if(ss.fail()) return false;
+                if(!get_value(c[2])) return false;
+                c[2] = mm(c[2]);
                 break;
             case 40:
                 // radius
                 get_line();
-                ss.str(m_str); ss >> radius; radius = mm(radius); if(ss.fail()) return false;
+                if(!get_value(radius)) return false;
+                radius = mm(radius);
                 break;
                 case 62:
                 // color index
                 get_line();
-                ss.str(m_str); ss >> m_aci; if(ss.fail()) return false;
+                if(!get_value(m_aci)) return false;
                 break;
 
             case 100:
@@ -2353,17 +2379,15 @@ bool CDxfRead::ReadText()
 
     memset( c, 0, sizeof(c) );
 
-    while(!((*m_ifs).eof()))
+    while(!m_eof)
     {
         get_line();
         int n;
-        if(sscanf(m_str, "%d", &n) != 1)
+        if(!get_value(n))
         {
             printf("CDxfRead::ReadText() Failed to read integer from '%s'\n", m_str);
             return false;
         }
-        std::istringstream ss;
-        ss.imbue(std::locale("C"));
         switch(n){
             case 0:
                 return false;
@@ -2375,22 +2399,26 @@ bool CDxfRead::ReadText()
             case 10:
                 // centre x
                 get_line();
-                ss.str(m_str); ss >> c[0]; c[0] = mm(c[0]); if(ss.fail()) return false;
+                if(!get_value(c[0])) return false;
+                c[0] = mm(c[0]);
                 break;
             case 20:
                 // centre y
                 get_line();
-                ss.str(m_str); ss >> c[1]; c[1] = mm(c[1]); if(ss.fail()) return false;
+                if(!get_value(c[1])) return false;
+                c[1] = mm(c[1]);
                 break;
             case 30:
                 // centre z
                 get_line();
-                ss.str(m_str); ss >> c[2]; c[2] = mm(c[2]); if(ss.fail()) return false;
+                if(!get_value(c[2])) return false;
+                c[2] = mm(c[2]);
                 break;
             case 40:
                 // text height
                 get_line();
-                ss.str(m_str); ss >> height; height = mm(height); if(ss.fail()) return false;
+                if(!get_value(height)) return false;
+                height = mm(height);
                 break;
             case 1:
                 // text
@@ -2402,7 +2430,7 @@ bool CDxfRead::ReadText()
             case 62:
                 // color index
                 get_line();
-                ss.str(m_str); ss >> m_aci; if(ss.fail()) return false;
+                if(!get_value(m_aci)) return false;
                 break;
 
             case 100:
@@ -2432,17 +2460,15 @@ bool CDxfRead::ReadEllipse()
     double start=0; //start of arc
     double end=0;  // end of arc
 
-    while(!((*m_ifs).eof()))
+    while(!m_eof)
     {
         get_line();
         int n;
-        if(sscanf(m_str, "%d", &n) != 1)
+        if(!get_value(n))
         {
             printf("CDxfRead::ReadEllipse() Failed to read integer from '%s'\n", m_str);
             return false;
         }
-        std::istringstream ss;
-        ss.imbue(std::locale("C"));
         switch(n){
             case 0:
                 // next item found, so finish with Ellipse
@@ -2457,52 +2483,58 @@ bool CDxfRead::ReadEllipse()
             case 10:
                 // centre x
                 get_line();
-                ss.str(m_str); ss >> c[0]; c[0] = mm(c[0]); if(ss.fail()) return false;
+                if(!get_value(c[0])) return false;
+                c[0] = mm(c[0]);
                 break;
             case 20:
                 // centre y
                 get_line();
-                ss.str(m_str); ss >> c[1]; c[1] = mm(c[1]); if(ss.fail()) return false;
+                if(!get_value(c[1])) return false;
+                c[1] = mm(c[1]);
                 break;
             case 30:
                 // centre z
                 get_line();
-                ss.str(m_str); ss >> c[2]; c[2] = mm(c[2]); if(ss.fail()) return false;
+                if(!get_value(c[2])) return false;
+                c[2] = mm(c[2]);
                 break;
             case 11:
                 // major x
                 get_line();
-                ss.str(m_str); ss >> m[0]; m[0] = mm(m[0]); if(ss.fail()) return false;
+                if(!get_value(m[0])) return false;
+                m[0] = mm(m[0]);
                 break;
             case 21:
                 // major y
                 get_line();
-                ss.str(m_str); ss >> m[1]; m[1] = mm(m[1]); if(ss.fail()) return false;
+                if(!get_value(m[1])) return false;
+                m[1] = mm(m[1]);
                 break;
             case 31:
                 // major z
                 get_line();
-                ss.str(m_str); ss >> m[2]; m[2] = mm(m[2]); if(ss.fail()) return false;
+                if(!get_value(m[2])) return false;
+                m[2] = mm(m[2]);
                 break;
             case 40:
                 // ratio
                 get_line();
-                ss.str(m_str); ss >> ratio; if(ss.fail()) return false;
+                if(!get_value(ratio)) return false;
                 break;
             case 41:
                 // start
                 get_line();
-                ss.str(m_str); ss >> start; if(ss.fail()) return false;
+                if(!get_value(start)) return false;
                 break;
             case 42:
                 // end
                 get_line();
-                ss.str(m_str); ss >> end; if(ss.fail()) return false;
+                if(!get_value(end)) return false;
                 break;
                 case 62:
                 // color index
                 get_line();
-                ss.str(m_str); ss >> m_aci; if(ss.fail()) return false;
+                if(!get_value(m_aci)) return false;
                 break;
             case 100:
             case 210:
@@ -2602,17 +2634,15 @@ bool CDxfRead::ReadLwPolyLine()
     int flags;
     bool next_item_found = false;
 
-    while(!((*m_ifs).eof()) && !next_item_found)
+    while(!m_eof && !next_item_found)
     {
         get_line();
         int n;
-        if(sscanf(m_str, "%d", &n) != 1)
+        if(!get_value(n))
         {
             printf("CDxfRead::ReadLwPolyLine() Failed to read integer from '%s'\n", m_str);
             return false;
         }
-        std::istringstream ss;
-        ss.imbue(std::locale("C"));
         switch(n){
             case 0:
                 // next item found
@@ -2641,36 +2671,39 @@ bool CDxfRead::ReadLwPolyLine()
                     x_found = false;
                     y_found = false;
                 }
-                ss.str(m_str); ss >> x; x = mm(x); if(ss.fail()) return false;
+                if(!get_value(x)) return false;
+                x = mm(x);
                 x_found = true;
                 break;
             case 20:
                 // y
                 get_line();
-                ss.str(m_str); ss >> y; y = mm(y); if(ss.fail()) return false;
+                if(!get_value(y)) return false;
+                y = mm(y);
                 y_found = true;
                 break;
             case 38: 
                 // elevation
                 get_line();
-                ss.str(m_str); ss >> z; z = mm(z); if(ss.fail()) return false;
+                if(!get_value(z)) return false;
+                z = mm(z);
                 break;
             case 42:
                 // bulge
                 get_line();
-                ss.str(m_str); ss >> bulge; if(ss.fail()) return false;
+                if(!get_value(bulge)) return false;
                 bulge_found = true;
                 break;
             case 70:
                 // flags
                 get_line();
-                if(sscanf(m_str, "%d", &flags) != 1)return false;
+                if(!get_value(flags))return false;
                 closed = ((flags & 1) != 0);
                 break;
                 case 62:
                 // color index
                 get_line();
-                ss.str(m_str); ss >> m_aci; if(ss.fail()) return false;
+                if(!get_value(m_aci)) return false;
                 break;
             default:
                 // skip the next line
@@ -2709,15 +2742,13 @@ bool CDxfRead::ReadVertex(double *pVertex, bool *bulge_found, double *bulge)
     pVertex[1] = 0.0;
     pVertex[2] = 0.0;
 
-    while(!(*m_ifs).eof()) {
+    while(!m_eof) {
         get_line();
         int n;
-        if(sscanf(m_str, "%d", &n) != 1) {
+        if(!get_value(n)) {
             printf("CDxfRead::ReadVertex() Failed to read integer from '%s'\n", m_str);
             return false;
         }
-        std::istringstream ss;
-        ss.imbue(std::locale("C"));
         switch(n){
         case 0:
         DerefACI();
@@ -2733,30 +2764,33 @@ bool CDxfRead::ReadVertex(double *pVertex, bool *bulge_found, double *bulge)
         case 10:
             // x
             get_line();
-            ss.str(m_str); ss >> x; pVertex[0] = mm(x); if(ss.fail()) return false;
+            if(!get_value(x)) return false;
+            pVertex[0] = mm(x);
             x_found = true;
             break;
         case 20:
             // y
             get_line();
-            ss.str(m_str); ss >> y; pVertex[1] = mm(y); if(ss.fail()) return false;
+            if(!get_value(y)) return false;
+            pVertex[1] = mm(y);
             y_found = true;
             break;
         case 30:
             // z
             get_line();
-            ss.str(m_str); ss >> z; pVertex[2] = mm(z); if(ss.fail()) return false;
+            if(!get_value(z)) return false;
+            pVertex[2] = mm(z);
             break;
 
         case 42:
             get_line();
             *bulge_found = true;
-            ss.str(m_str); ss >> *bulge; if(ss.fail()) return false;
+            if(!get_value(*bulge)) return false;
             break;
     case 62:
         // color index
         get_line();
-        ss.str(m_str); ss >> m_aci; if(ss.fail()) return false;
+        if(!get_value(m_aci)) return false;
         break;
 
         default:
@@ -2782,17 +2816,15 @@ bool CDxfRead::ReadPolyLine()
     bool bulge_found;
     double bulge;
 
-    while(!(*m_ifs).eof())
+    while(!m_eof)
     {
         get_line();
         int n;
-        if(sscanf(m_str, "%d", &n) != 1)
+        if(!get_value(n))
         {
             printf("CDxfRead::ReadPolyLine() Failed to read integer from '%s'\n", m_str);
             return false;
         }
-        std::istringstream ss;
-        ss.imbue(std::locale("C"));
         switch(n){
             case 0:
                 // next item found
@@ -2824,13 +2856,13 @@ bool CDxfRead::ReadPolyLine()
             case 70:
                 // flags
                 get_line();
-                if(sscanf(m_str, "%d", &flags) != 1)return false;
+                if(!get_value(flags))return false;
                 closed = ((flags & 1) != 0);
                 break;
                 case 62:
                 // color index
                 get_line();
-                ss.str(m_str); ss >> m_aci; if(ss.fail()) return false;
+                if(!get_value(m_aci)) return false;
                 break;
             default:
                 // skip the next line
@@ -2904,17 +2936,15 @@ bool CDxfRead::ReadInsert()
     double rot = 0.0; // rotation
     char name[1024] = {0};
 
-    while(!((*m_ifs).eof()))
+    while(!m_eof)
     {
         get_line();
         int n;
-        if(sscanf(m_str, "%d", &n) != 1)
+        if(!get_value(n))
         {
             printf("CDxfRead::ReadInsert() Failed to read integer from '%s'\n", m_str);
             return false;
         }
-        std::istringstream ss;
-        ss.imbue(std::locale("C"));
         switch(n){
             case 0: 
                 // next item found
@@ -2929,37 +2959,40 @@ bool CDxfRead::ReadInsert()
             case 10:
                 // coord x
                 get_line();
-                ss.str(m_str); ss >> c[0]; c[0] = mm(c[0]); if(ss.fail()) return false;
+                if(!get_value(c[0])) return false;
+                c[0] = mm(c[0]);
                 break;
             case 20:
                 // coord y
                 get_line();
-                ss.str(m_str); ss >> c[1]; c[1] = mm(c[1]); if(ss.fail()) return false;
+                if(!get_value(c[1])) return false;
+                c[1] = mm(c[1]);
                 break;
             case 30:
                 // coord z
                 get_line();
-                ss.str(m_str); ss >> c[2]; c[2] = mm(c[2]); if(ss.fail()) return false;
+                if(!get_value(c[2])) return false;
+                c[2] = mm(c[2]);
                 break;
             case 41:
                 // scale x
                 get_line();
-                ss.str(m_str); ss >> s[0]; if(ss.fail()) return false;
+                if(!get_value(s[0])) return false;
                 break;
             case 42:
                 // scale y
                 get_line();
-                ss.str(m_str); ss >> s[1]; if(ss.fail()) return false;
+                if(!get_value(s[1])) return false;
                 break;
             case 43:
                 // scale z
                 get_line();
-                ss.str(m_str); ss >> s[2]; if(ss.fail()) return false;
+                if(!get_value(s[2])) return false;
                 break;
             case 50:
                 // rotation
                 get_line();
-                ss.str(m_str); ss >> rot; if(ss.fail()) return false;
+                if(!get_value(rot)) return false;
                 break;
             case 2:
                 // block name
@@ -2969,7 +3002,7 @@ bool CDxfRead::ReadInsert()
             case 62:
                 // color index
                 get_line();
-                ss.str(m_str); ss >> m_aci; if(ss.fail()) return false;
+                if(!get_value(m_aci)) return false;
                 break;
             case 100:
             case 39:
@@ -2996,17 +3029,15 @@ bool CDxfRead::ReadDimension()
     double p[3] = {0,0,0}; // dimpoint
     double rot = -1.0; // rotation
 
-    while(!((*m_ifs).eof()))
+    while(!m_eof)
     {
         get_line();
         int n;
-        if(sscanf(m_str, "%d", &n) != 1)
+        if(!get_value(n))
         {
             printf("CDxfRead::ReadInsert() Failed to read integer from '%s'\n", m_str);
             return false;
         }
-        std::istringstream ss;
-        ss.imbue(std::locale("C"));
         switch(n){
             case 0: 
                 // next item found
@@ -3021,57 +3052,66 @@ bool CDxfRead::ReadDimension()
             case 13:
                 // start x
                 get_line();
-                ss.str(m_str); ss >> s[0]; s[0] = mm(s[0]); if(ss.fail()) return false;
+                if(!get_value(s[0])) return false;
+                s[0] = mm(s[0]);
                 break;
             case 23:
                 // start y
                 get_line();
-                ss.str(m_str); ss >> s[1]; s[1] = mm(s[1]); if(ss.fail()) return false;
+                if(!get_value(s[1])) return false;
+                s[1] = mm(s[1]);
                 break;
             case 33:
                 // start z
                 get_line();
-                ss.str(m_str); ss >> s[2]; s[2] = mm(s[2]); if(ss.fail()) return false;
+                if(!get_value(s[2])) return false;
+                s[2] = mm(s[2]);
                 break;
             case 14:
                 // end x
                 get_line();
-                ss.str(m_str); ss >> e[0]; e[0] = mm(e[0]); if(ss.fail()) return false;
+                if(!get_value(e[0])) return false;
+                e[0] = mm(e[0]);
                 break;
             case 24:
                 // end y
                 get_line();
-                ss.str(m_str); ss >> e[1]; e[1] = mm(e[1]); if(ss.fail()) return false;
+                if(!get_value(e[1])) return false;
+                e[1] = mm(e[1]);
                 break;
             case 34:
                 // end z
                 get_line();
-                ss.str(m_str); ss >> e[2]; e[2] = mm(e[2]); if(ss.fail()) return false;
+                if(!get_value(e[2])) return false;
+                e[2] = mm(e[2]);
                 break;
             case 10:
                 // dimline x
                 get_line();
-                ss.str(m_str); ss >> p[0]; p[0] = mm(p[0]); if(ss.fail()) return false;
+                if(!get_value(p[0])) return false;
+                p[0] = mm(p[0]);
                 break;
             case 20:
                 // dimline y
                 get_line();
-                ss.str(m_str); ss >> p[1]; p[1] = mm(p[1]); if(ss.fail()) return false;
+                if(!get_value(p[1])) return false;
+                p[1] = mm(p[1]);
                 break;
             case 30:
                 // dimline z
                 get_line();
-                ss.str(m_str); ss >> p[2]; p[2] = mm(p[2]); if(ss.fail()) return false;
+                if(!get_value(p[2])) return false;
+                p[2] = mm(p[2]);
                 break;
             case 50:
                 // rotation
                 get_line();
-                ss.str(m_str); ss >> rot; if(ss.fail()) return false;
+                if(!get_value(rot)) return false;
                 break;
             case 62:
                 // color index
                 get_line();
-                ss.str(m_str); ss >> m_aci; if(ss.fail()) return false;
+                if(!get_value(m_aci)) return false;
                 break;
             case 100:
             case 39:
@@ -3093,17 +3133,15 @@ bool CDxfRead::ReadDimension()
 
 bool CDxfRead::ReadBlockInfo()
 {
-    while(!((*m_ifs).eof()))
+    while(!m_eof)
     {
         get_line();
         int n;
-        if(sscanf(m_str, "%d", &n) != 1)
+        if(!get_value(n))
         {
             printf("CDxfRead::ReadBlockInfo() Failed to read integer from '%s'\n", m_str);
             return false;
         }
-        std::istringstream ss;
-        ss.imbue(std::locale("C"));
         switch(n){
             case 2:
                 // block name
@@ -3125,6 +3163,17 @@ bool CDxfRead::ReadBlockInfo()
 }
 
 
+bool CDxfRead::fill_buffer()
+{
+    m_buffer_pos = 0;
+    m_buffer_end = 0;
+    if(!(*m_ifs))
+        return false;
+    m_ifs->read(&m_buffer[0], m_buffer.size());
+    m_buffer_end = static_cast<size_t>(m_ifs->gcount());
+    return m_buffer_end > 0;
+}
+
 void CDxfRead::get_line()
 {
     if (m_unused_line[0] != '\0')
@@ -3134,23 +3183,136 @@ void CDxfRead::get_line()
         return;
     }
 
-    m_ifs->getline(m_str, 1024);
-
-    char str[1024];
-    size_t len = strlen(m_str);
-    int j = 0;
+    // Copy the next line out of the read buffer, without leading white space
+    // and carriage returns. Like istream::getline(), reaching the end of the
+    // file before the end of the line sets the end of file flag.
+    size_t j = 0;
     bool non_white_found = false;
-    for(size_t i = 0; i<len; i++){
-        if(non_white_found || (m_str[i] != ' ' && m_str[i] != '\t')){
-            if(m_str[i] != '\r')
-            {
-                str[j] = m_str[i]; j++;
+    bool eol_found = false;
+    while(m_buffer_pos < m_buffer_end || fill_buffer()) {
+        const char *begin = &m_buffer[m_buffer_pos];
+        const char *end = begin + (m_buffer_end - m_buffer_pos);
+        const char *eol = static_cast<const char*>(memchr(begin, '\n', end - begin));
+        if(eol) {
+            end = eol;
+            eol_found = true;
+        }
+        for(const char *c = begin; c != end; ++c) {
+            if(!non_white_found) {
+                if(*c == ' ' || *c == '\t')
+                    continue;
+                non_white_found = true;
             }
-            non_white_found = true;
+            if(*c != '\r' && j < sizeof(m_str) - 1)
+                m_str[j++] = *c;
         }
+        m_buffer_pos += (end - begin) + (eol_found ? 1 : 0);
+        if(eol_found)
+            break;
     }
-    str[j] = 0;
-    strcpy(m_str, str);
+    m_str[j] = 0;
+    if(!eol_found)
+        m_eof = true;
+}
+
+namespace {
+
+// Group codes and values are plain ASCII numbers. Parsing them without a
+// locale aware stream is by far faster, which matters for large files.
+
+const char *skip_white(const char *c)
+{
+    while(*c == ' ' || *c == '\t')
+        ++c;
+    return c;
+}
+
+bool parse_int(const char *str, int &value)
+{
+    const char *c = skip_white(str);
+    bool negative = false;
+    if(*c == '-' || *c == '+')
+        negative = (*c++ == '-');
+    if(*c < '0' || *c > '9')
+        return false;
+    long long v = 0;
+    for(; *c >= '0' && *c <= '9'; ++c) {
+        if(v < 100000000000LL)
+            v = v * 10 + (*c - '0');
+    }
+    value = static_cast<int>(negative ? -v : v);
+    return true;
+}
+
+bool parse_double_stream(const char *str, double &value)
+{
+    std::istringstream ss(str);
+    ss.imbue(std::locale::classic());
+    ss >> value;
+    return !ss.fail();
+}
+
+bool parse_double(const char *str, double &value)
+{
+    static const double pow10[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+    const char *c = skip_white(str);
+    bool negative = false;
+    if(*c == '-' || *c == '+')
+        negative = (*c++ == '-');
+
+    // Collect the significant digits as an integer. The conversion below is
+    // exact as long as the integer and the power of ten are exactly
+    // representable as double, any other input goes through the stream.
+    unsigned long long mantissa = 0;
+    int digits = 0;
+    int exponent = 0;
+    bool found = false;
+    for(; *c >= '0' && *c <= '9'; ++c) {
+        found = true;
+        if(mantissa || *c != '0') {
+            if(++digits > 18)
+                return parse_double_stream(str, value);
+            mantissa = mantissa * 10 + (*c - '0');
+        }
+    }
+    if(*c == '.') {
+        for(++c; *c >= '0' && *c <= '9'; ++c) {
+            found = true;
+            if(mantissa || *c != '0') {
+                if(++digits > 18)
+                    return parse_double_stream(str, value);
+                mantissa = mantissa * 10 + (*c - '0');
+            }
+            --exponent;
+        }
+    }
+    if(!found)
+        return parse_double_stream(str, value);
+    if(*c == 'e' || *c == 'E')
+        return parse_double_stream(str, value);
+
+    if(mantissa > (1ULL << 53) || exponent < -22)
+        return parse_double_stream(str, value);
+    double v = static_cast<double>(mantissa);
+    if(exponent < 0)
+        v /= pow10[-exponent];
+    value = negative ? -v : v;
+    return true;
+}
+
+} // anonymous namespace
+
+bool CDxfRead::get_value(int &value) const
+{
+    return parse_int(m_str, value);
+}
+
+bool CDxfRead::get_value(double &value) const
+{
+    return parse_double(m_str, value);
 }
 
 void CDxfRead::put_line(const char *value)
@@ -3164,7 +3326,7 @@ bool CDxfRead::ReadUnits()
     get_line(); // Skip to next line.
     get_line(); // Skip to next line.
     int n = 0;
-    if(sscanf(m_str, "%d", &n) == 1)
+    if(get_value(n))
     {
         m_eUnits = eDxfUnits_t( n );
         return(true);
@@ -3182,19 +3344,17 @@ bool CDxfRead::ReadLayer()
     std::string layername;
     int aci = -1;
 
-    while(!((*m_ifs).eof()))
+    while(!m_eof)
     {
         get_line();
         int n;
 
-        if(sscanf(m_str, "%d", &n) != 1)
+        if(!get_value(n))
         {
             printf("CDxfRead::ReadLayer() Failed to read integer from '%s'\n", m_str );
             return false;
         }
 
-        std::istringstream ss;
-        ss.imbue(std::locale("C"));
         switch(n){
             case 0: // next item found, so finish with line
                     if (layername.empty())
@@ -3213,7 +3373,7 @@ bool CDxfRead::ReadLayer()
             case 62:
                 // layer color ; if negative, layer is off
                 get_line();
-                if(sscanf(m_str, "%d", &aci) != 1)return false;
+                if(!get_value(aci))return false;
                 break;
 
             case 6: // linetype name
@@ -3241,7 +3401,7 @@ void CDxfRead::DoRead(const bool ignore_errors /* = false */ )
 
     get_line();
 
-    while(!((*m_ifs).eof()))
+    while(!m_eof)
     {
         if (!strcmp( m_str, "$INSUNITS" )){
             if (!ReadUnits())return;
@@ -3252,7 +3412,7 @@ void CDxfRead::DoRead(const bool ignore_errors /* = false */ )
             get_line();
             get_line();
             int n = 1;
-            if(sscanf(m_str, "%d", &n) == 1)
+            if(get_value(n))
             {
                 if(n == 0)m_measurement_inch = true;
             }
@@ -245,6 +245,10 @@ public:
 class ImportExport CDxfRead{
 private:
     std::ifstream* m_ifs;
+    std::vector<char> m_buffer; // data read ahead from m_ifs
+    size_t m_buffer_pos;
+    size_t m_buffer_end;
+    bool m_eof;
 
     bool m_fail;
     char m_str[1024];
@@ -279,8 +283,12 @@ private:
     bool ReadDimension();
     bool ReadBlockInfo();
 
+    bool fill_buffer();
     void get_line();
     void put_line(const char *value);
+    // parse the current line as number
+    bool get_value(int &value) const;
+    bool get_value(double &value) const;
     void DerefACI();
 
 protected:
@@ -22,13 +22,30 @@
 
 
 #include "PreCompiled.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <numeric>
+#include <unordered_map>
 #include <gp_Pnt.hxx>
+#include <gp_Pnt2d.hxx>
+#include <Bnd_Box.hxx>
+#include <BRep_Tool.hxx>
+#include <BRepBndLib.hxx>
 #include <BRepExtrema_DistShapeShape.hxx>
+#include <BRepBuilderAPI_Copy.hxx>
 #include <BRepBuilderAPI_MakeVertex.hxx>
 #include <BRepClass3d_SolidClassifier.hxx>
 #include <BRepGProp_Face.hxx>
+#include <BRepMesh_IncrementalMesh.hxx>
+#include <BRepTools.hxx>
+#include <BRepTopAdaptor_FClass2d.hxx>
+#include <GeomAPI_ProjectPointOnSurf.hxx>
+#include <Geom_Surface.hxx>
+#include <Precision.hxx>
+#include <TopExp_Explorer.hxx>
 #include <TopoDS.hxx>
+#include <TopoDS_Face.hxx>
 #include <TopoDS_Vertex.hxx>
 
 #include <QEventLoop>
@@ -36,9 +53,8 @@
 #include <QFutureWatcher>
 #include <QtConcurrentMap>
 
-#include <boost_bind_bind.hpp>
-
 #include <Base/Console.h>
+#include <Base/Converter.h>
 #include <Base/Exception.h>
 #include <Base/FutureWatcherProgress.h>
 #include <Base/Parameter.h>
@@ -48,6 +64,7 @@
 #include <Mod/Mesh/App/Mesh.h>
 #include <Mod/Mesh/App/MeshFeature.h>
 #include <Mod/Mesh/App/Core/Algorithm.h>
+#include <Mod/Mesh/App/Core/Elements.h>
 #include <Mod/Mesh/App/Core/Grid.h>
 #include <Mod/Mesh/App/Core/Iterator.h>
 #include <Mod/Mesh/App/Core/MeshKernel.h>
@@ -59,7 +76,6 @@
 
 
 using namespace Inspection;
-namespace bp = boost::placeholders;
 
 InspectActualMesh::InspectActualMesh(const Mesh::MeshObject& rMesh) : _mesh(rMesh.getKernel())
 {
@@ -438,73 +454,320 @@ float InspectNominalPoints::getDistance(const Base::Vector3f& point) const
 
 // ----------------------------------------------------------------
 
-InspectNominalShape::InspectNominalShape(const TopoDS_Shape& shape, float /*radius*/)
+namespace Inspection {
+/// Tessellation of the faces of a shape with a facet grid to quickly find the faces near a point
+class InspectNominalShape::FaceGrid
+{
+public:
+    FaceGrid(const TopoDS_Shape& nominal)
+        : deflection(0.0)
+    {
+        // mesh a copy so that the triangulation of the nominal shape is left alone
+        TopoDS_Shape shape = BRepBuilderAPI_Copy(nominal).Shape();
+        for (TopExp_Explorer xp(shape, TopAbs_FACE); xp.More(); xp.Next())
+            faces.push_back(TopoDS::Face(xp.Current()));
+        if (faces.empty())
+            return;
+
+        Bnd_Box bounds;
+        BRepBndLib::Add(shape, bounds);
+        bounds.SetGap(0.0);
+        Standard_Real xMin, yMin, zMin, xMax, yMax, zMax;
+        bounds.Get(xMin, yMin, zMin, xMax, yMax, zMax);
+        Standard_Real diag = sqrt((xMax-xMin)*(xMax-xMin) + (yMax-yMin)*(yMax-yMin) + (zMax-zMin)*(zMax-zMin));
+        deflection = std::max<Standard_Real>(0.001 * diag, Precision::Confusion());
+        BRepMesh_IncrementalMesh mesh(shape, deflection, Standard_False, 0.5, Standard_True);
+
+        // the domains are in the same order as the faces
+        std::vector<Data::ComplexGeoData::Domain> domains;
+        Part::TopoShape(shape).getDomains(domains);
+
+        MeshCore::MeshPointArray points;
+        MeshCore::MeshFacetArray facets;
+        for (std::size_t index = 0; index < domains.size(); ++index) {
+            const Data::ComplexGeoData::Domain& domain = domains[index];
+            if (domain.facets.empty()) {
+                // a face that couldn't be meshed is always checked
+                untessellated.push_back(index);
+                continue;
+            }
+
+            unsigned long offset = points.size();
+            for (std::vector<Base::Vector3d>::const_iterator it = domain.points.begin(); it != domain.points.end(); ++it)
+                points.push_back(MeshCore::MeshPoint(Base::convertTo<Base::Vector3f>(*it)));
+            for (std::vector<Data::ComplexGeoData::Facet>::const_iterator it = domain.facets.begin(); it != domain.facets.end(); ++it) {
+                facets.push_back(MeshCore::MeshFacet(offset + it->I1, offset + it->I2, offset + it->I3));
+                facetToFace.push_back(index);
+            }
+        }
+
+        kernel.Adopt(points, facets);
+        if (kernel.CountFacets() > 0) {
+            // same estimation of the grid length as for InspectNominalMesh
+            float fMaxGridElements=8000000.0f;
+            Base::BoundBox3f box = kernel.GetBoundBox();
+            float fMinGridLen = (float)pow((box.LengthX()*box.LengthY()*box.LengthZ()/fMaxGridElements), 0.3333f);
+            float fGridLen = 5.0f * MeshCore::MeshAlgorithm(kernel).GetAverageEdgeLength();
+            fGridLen = std::max<float>(fMinGridLen, fGridLen);
+            grid.reset(new MeshCore::MeshFacetGrid(kernel, fGridLen));
+        }
+    }
+
+    /**
+     * Collects the faces that may contain the nearest point to \a point if it's closer than \a maxDist.
+     * The tessellation deviates from the exact faces by the deflection. So, if the nearest facet has
+     * the distance d then every face with a facet closer than d + 2 * deflection is a candidate.
+     */
+    bool getCandidates(const Base::Vector3f& point, float maxDist, std::vector<unsigned long>& candidates) const
+    {
+        candidates = untessellated;
+        if (!grid)
+            return !candidates.empty();
+
+        float tolerance = 2.0f * static_cast<float>(deflection);
+        maxDist += tolerance;
+
+        Base::BoundBox3f box(point.x - maxDist, point.y - maxDist, point.z - maxDist,
+                             point.x + maxDist, point.y + maxDist, point.z + maxDist);
+        std::vector<unsigned long> elements;
+        grid->Inside(box, elements, point, maxDist, true);
+
+        float fMinDist = FLT_MAX;
+        std::map<unsigned long, float> faceDist;
+        for (std::vector<unsigned long>::iterator it = elements.begin(); it != elements.end(); ++it) {
+            float fDist = kernel.GetFacet(*it).DistanceToPoint(point);
+            if (fDist > maxDist)
+                continue;
+            std::map<unsigned long, float>::iterator jt = faceDist.insert(std::make_pair(facetToFace[*it], fDist)).first;
+            jt->second = std::min(jt->second, fDist);
+            fMinDist = std::min(fMinDist, fDist);
+        }
+
+        // add some safety as the deflection is only checked at sample points by the mesher
+        float fMaxDist = fMinDist + 2.0f * tolerance;
+        for (std::map<unsigned long, float>::iterator it = faceDist.begin(); it != faceDist.end(); ++it) {
+            if (it->second <= fMaxDist)
+                candidates.push_back(it->first);
+        }
+
+        return !candidates.empty();
+    }
+
+    std::vector<TopoDS_Face> faces;
+    std::vector<unsigned long> untessellated;
+    std::vector<unsigned long> facetToFace;
+    MeshCore::MeshKernel kernel;
+    std::unique_ptr<MeshCore::MeshFacetGrid> grid;
+    Standard_Real deflection;
+};
+
+/// The classifiers and projectors used by one thread, they are created on demand and then re-used
+class InspectNominalShape::ThreadContext
+{
+public:
+    ThreadContext(const TopoDS_Shape& shape, const FaceGrid& grid, bool isSolid)
+        : grid(grid)
+        , projectors(grid.faces.size())
+        , classifiers(grid.faces.size())
+    {
+        if (isSolid)
+            solidClassifier.Load(shape);
+    }
+
+    bool isInside(const gp_Pnt& pnt)
+    {
+        const Standard_Real tol = 0.001;
+        solidClassifier.Perform(pnt, tol);
+        return solidClassifier.State() == TopAbs_IN;
+    }
+
+    /**
+     * Computes the exact distance of \a pnt to the face with the given index. If the nearest
+     * point lies inside the face \a inFace is set to true and \a u, \a v are its parameters.
+     */
+    bool getDistance(unsigned long index, const gp_Pnt& pnt, Standard_Real& dist,
+                     bool& inFace, Standard_Real& u, Standard_Real& v)
+    {
+        GeomAPI_ProjectPointOnSurf& proj = getProjector(index);
+        proj.Perform(pnt);
+        if (proj.NbPoints() > 0) {
+            proj.LowerDistanceParameters(u, v);
+            if (getClassifier(index).Perform(gp_Pnt2d(u, v)) != TopAbs_OUT) {
+                dist = proj.LowerDistance();
+                inFace = true;
+                return true;
+            }
+        }
+
+        // the nearest point lies on the boundary of the face
+        BRepExtrema_DistShapeShape distss(grid.faces[index], BRepBuilderAPI_MakeVertex(pnt).Vertex());
+        if (!distss.IsDone() || distss.NbSolution() == 0)
+            return false;
+
+        dist = distss.Value();
+        inFace = false;
+        for (Standard_Integer i = 1; i <= distss.NbSolution(); i++) {
+            if (distss.SupportTypeShape1(i) == BRepExtrema_IsInFace) {
+                distss.ParOnFaceS1(i, u, v);
+                inFace = true;
+                break;
+            }
+        }
+        return true;
+    }
+
+private:
+    GeomAPI_ProjectPointOnSurf& getProjector(unsigned long index)
+    {
+        std::unique_ptr<GeomAPI_ProjectPointOnSurf>& proj = projectors[index];
+        if (!proj) {
+            const TopoDS_Face& face = grid.faces[index];
+            // use an own copy of the surface because evaluating some surface types isn't thread-safe
+            Handle(Geom_Surface) surface = Handle(Geom_Surface)::DownCast(BRep_Tool::Surface(face)->Copy());
+            Standard_Real u1, u2, v1, v2;
+            BRepTools::UVBounds(face, u1, u2, v1, v2);
+            proj.reset(new GeomAPI_ProjectPointOnSurf());
+            proj->Init(surface, u1, u2, v1, v2);
+        }
+        return *proj;
+    }
+
+    BRepTopAdaptor_FClass2d& getClassifier(unsigned long index)
+    {
+        std::unique_ptr<BRepTopAdaptor_FClass2d>& classifier = classifiers[index];
+        if (!classifier)
+            classifier.reset(new BRepTopAdaptor_FClass2d(grid.faces[index], Precision::Confusion()));
+        return *classifier;
+    }
+
+private:
+    const FaceGrid& grid;
+    BRepClass3d_SolidClassifier solidClassifier;
+    std::vector<std::unique_ptr<GeomAPI_ProjectPointOnSurf> > projectors;
+    std::vector<std::unique_ptr<BRepTopAdaptor_FClass2d> > classifiers;
+};
+}
+
+namespace {
+std::atomic<unsigned long> nominalShapeCounter(0);
+}
+
+InspectNominalShape::InspectNominalShape(const TopoDS_Shape& shape, float offset)
     : _rShape(shape)
     , isSolid(false)
+    , _offset(offset)
+    , _pGrid(0)
+    , _id(++nominalShapeCounter)
 {
-    distss = new BRepExtrema_DistShapeShape();
-    distss->LoadS1(_rShape);
-
-    // When having a solid then use its shell because otherwise the distance
-    // for inner points will always be zero
-    if (!_rShape.IsNull() && _rShape.ShapeType() == TopAbs_SOLID) {
-        TopExp_Explorer xp;
-        xp.Init(_rShape, TopAbs_SHELL);
-        if (xp.More()) {
-           distss->LoadS1(xp.Current());
-           isSolid = true;
-        }
+    if (_rShape.IsNull())
+        return;
+
+    // When having a solid then the distance of inner points will be negative
+    isSolid = (_rShape.ShapeType() == TopAbs_SOLID);
 
+    _pGrid = new FaceGrid(_rShape);
+    if (_pGrid->faces.empty()) {
+        delete _pGrid;
+        _pGrid = 0;
     }
-    //distss->SetDeflection(radius);
 }
 
 InspectNominalShape::~InspectNominalShape()
 {
-    delete distss;
+    for (std::map<std::thread::id, ThreadContext*>::iterator it = _contexts.begin(); it != _contexts.end(); ++it)
+        delete it->second;
+    delete _pGrid;
+}
+
+InspectNominalShape::ThreadContext& InspectNominalShape::getThreadContext() const
+{
+    // The map is only locked the first time a thread works for this instance, afterwards
+    // the context comes from a per-thread cache holding the contexts of all instances.
+    // It is keyed by the unique id and not by the address so that a later instance never
+    // picks up a context that has been deleted.
+    static thread_local std::unordered_map<unsigned long, ThreadContext*> cache;
+    ThreadContext*& cached = cache[_id];
+    if (cached)
+        return *cached;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    ThreadContext*& context = _contexts[std::this_thread::get_id()];
+    if (!context)
+        context = new ThreadContext(_rShape, *_pGrid, isSolid);
+    cached = context;
+    return *context;
+}
+
+bool InspectNominalShape::isInside(const gp_Pnt& pnt3d) const
+{
+    if (!isSolid)
+        return false;
+    return getThreadContext().isInside(pnt3d);
+}
+
+float InspectNominalShape::getShapeDistance(const gp_Pnt& pnt3d) const
+{
+    // shape without faces
+    if (_rShape.IsNull())
+        return FLT_MAX;
+
+    BRepExtrema_DistShapeShape distss(_rShape, BRepBuilderAPI_MakeVertex(pnt3d).Vertex());
+    if (distss.IsDone() && distss.NbSolution() > 0)
+        return (float)distss.Value();
+    return FLT_MAX;
 }
 
 float InspectNominalShape::getDistance(const Base::Vector3f& point) const
 {
     gp_Pnt pnt3d(point.x,point.y,point.z);
-    BRepBuilderAPI_MakeVertex mkVert(pnt3d);
-    distss->LoadS2(mkVert.Vertex());
+    if (!_pGrid)
+        return getShapeDistance(pnt3d);
 
-    float fMinDist=FLT_MAX;
-    if (distss->Perform() && distss->NbSolution() > 0) {
-        fMinDist = (float)distss->Value();
-        // the shape is a solid, check if the vertex is inside
-        if (isSolid) {
-            const Standard_Real tol = 0.001;
-            BRepClass3d_SolidClassifier classifier(_rShape);
-            classifier.Perform(pnt3d, tol);
-            if (classifier.State() == TopAbs_IN) {
-                fMinDist = -fMinDist;
-            }
+    std::vector<unsigned long> faces;
+    if (!_pGrid->getCandidates(point, _offset, faces)) {
+        // outside the search radius anyway, only the side matters
+        return isInside(pnt3d) ? -FLT_MAX : FLT_MAX;
+    }
 
+    ThreadContext& context = getThreadContext();
+    Standard_Real minDist = DBL_MAX;
+    Standard_Real minU = 0, minV = 0;
+    unsigned long minFace = 0;
+    bool minInFace = false;
+    for (std::vector<unsigned long>::iterator it = faces.begin(); it != faces.end(); ++it) {
+        Standard_Real dist, u = 0, v = 0;
+        bool inFace = false;
+        if (context.getDistance(*it, pnt3d, dist, inFace, u, v) && dist < minDist) {
+            minDist = dist;
+            minFace = *it;
+            minInFace = inFace;
+            minU = u;
+            minV = v;
         }
-        else if (fMinDist > 0) {
-            // check if the distance was compued from a face
-            for (Standard_Integer index = 1; index <= distss->NbSolution(); index++) {
-                if (distss->SupportTypeShape1(index) == BRepExtrema_IsInFace) {
-                    TopoDS_Shape face = distss->SupportOnShape1(index);
-                    Standard_Real u, v;
-                    distss->ParOnFaceS1(index, u, v);
-                    //gp_Pnt pnt = distss->PointOnShape1(index);
-                    BRepGProp_Face props(TopoDS::Face(face));
-                    gp_Vec normal;
-                    gp_Pnt center;
-                    props.Normal(u, v, center, normal);
-                    gp_Vec dir(center, pnt3d);
-                    Standard_Real scalar = normal.Dot(dir);
-                    if (scalar < 0) {
-                        fMinDist = -fMinDist;
-                    }
-                    break;
-                }
-            }
+    }
+
+    if (minDist == DBL_MAX)
+        return FLT_MAX;
+
+    float fMinDist = (float)minDist;
+    // the shape is a solid, check if the vertex is inside
+    if (isSolid) {
+        if (context.isInside(pnt3d))
+            fMinDist = -fMinDist;
+    }
+    else if (fMinDist > 0 && minInFace) {
+        // the distance was computed from a face
+        BRepGProp_Face props(_pGrid->faces[minFace]);
+        gp_Vec normal;
+        gp_Pnt center;
+        props.Normal(minU, minV, center, normal);
+        gp_Vec dir(center, pnt3d);
+        Standard_Real scalar = normal.Dot(dir);
+        if (scalar < 0) {
+            fMinDist = -fMinDist;
         }
     }
+
     return fMinDist;
 }
 
@@ -547,6 +810,13 @@ void PropertyDistanceList::setValues(const std::vector<float>& values)
     hasSetValue();
 }
 
+void PropertyDistanceList::setValues(std::vector<float>&& values)
+{
+    aboutToSetValue();
+    _lValueList = std::move(values);
+    hasSetValue();
+}
+
 PyObject *PropertyDistanceList::getPyObject(void)
 {
     PyObject* list = PyList_New(getSize());
@@ -689,22 +959,34 @@ struct DistanceInspection
     std::vector<InspectNominalGeometry*> nominal;
 };
 
-// Helper internal class for QtConcurrent map operation. Holds sums-of-squares and counts for RMS calculation
+// Helper internal class for QtConcurrent map operation. Holds sums-of-squares, counts and range for statistics
 class DistanceInspectionRMS {
 public:
-    DistanceInspectionRMS() : m_numv(0), m_sumsq(0.0) {};
+    DistanceInspectionRMS() : m_numv(0), m_sumsq(0.0), m_min(FLT_MAX), m_max(-FLT_MAX) {};
     DistanceInspectionRMS& operator += (const DistanceInspectionRMS& rhs)
     {
         this->m_numv += rhs.m_numv;
         this->m_sumsq += rhs.m_sumsq;
+        this->m_min = std::min(this->m_min, rhs.m_min);
+        this->m_max = std::max(this->m_max, rhs.m_max);
         return *this;
     }
+    void add(float fDist)
+    {
+        this->m_numv++;
+        this->m_sumsq += fDist * fDist;
+        this->m_min = std::min(this->m_min, fDist);
+        this->m_max = std::max(this->m_max, fDist);
+    }
     double getRMS()
     {
+        if (this->m_numv == 0)
+            return 0.0;
         return sqrt(this->m_sumsq / (double)this->m_numv);
     }
-    int m_numv;
+    unsigned long m_numv;
     double m_sumsq;
+    float m_min, m_max;
 };
 }
 
@@ -781,129 +1063,78 @@ App::DocumentObjectExecReturn* Feature::execute(void)
             inspectNominal.push_back(nominal);
     }
 
-#if 0
-#if 1 // test with some huge data sets
-    std::vector<unsigned long> index(actual->countPoints());
-    std::generate(index.begin(), index.end(), Base::iotaGen<unsigned long>(0));
+    unsigned long count = actual->countPoints();
     DistanceInspection check(this->SearchRadius.getValue(), actual, inspectNominal);
-    QFuture<float> future = QtConcurrent::mapped
-        (index, boost::bind(&DistanceInspection::mapped, &check, bp::_1));
-    //future.waitForFinished(); // blocks the GUI
-    Base::FutureWatcherProgress progress("Inspecting...", actual->countPoints());
-    QFutureWatcher<float> watcher;
-    QObject::connect(&watcher, SIGNAL(progressValueChanged(int)),
-                     &progress, SLOT(progressValueChanged(int)));
-
-    // keep it responsive during computation
-    QEventLoop loop;
-    QObject::connect(&watcher, SIGNAL(finished()), &loop, SLOT(quit()));
-    watcher.setFuture(future);
-    loop.exec();
 
-    std::vector<float> vals;
-    vals.insert(vals.end(), future.begin(), future.end());
-#else
-    DistanceInspection insp(this->SearchRadius.getValue(), actual, inspectNominal);
-    unsigned long count = actual->countPoints();
-    std::stringstream str;
-    str << "Inspecting " << this->Label.getValue() << "...";
-    Base::SequencerLauncher seq(str.str().c_str(), count);
+    // Split the points into chunks so that a work item outweighs the scheduling overhead
+    typedef std::pair<unsigned long, unsigned long> Chunk;
+    const unsigned long chunkSize = 1024;
+    std::vector<Chunk> chunks;
+    chunks.reserve(count / chunkSize + 1);
+    for (unsigned long first = 0; first < count; first += chunkSize)
+        chunks.push_back(Chunk(first, std::min(first + chunkSize, count)));
 
+    // Every chunk writes its own range, the property is only set if the inspection finishes
     std::vector<float> vals(count);
-    for (unsigned long index = 0; index < count; index++) {
-        float fMinDist = insp.mapped(index);
-        vals[index] = fMinDist;
-        seq.next();
-    }
-#endif
-
-    Distances.setValues(vals);
-
-    float fRMS = 0;
-    int countRMS = 0;
-    for (std::vector<float>::iterator it = vals.begin(); it != vals.end(); ++it) {
-        if (fabs(*it) < FLT_MAX) {
-            fRMS += (*it) * (*it);
-            countRMS++;
-        }
-    }
-
-    if (countRMS > 0) {
-        fRMS = fRMS / countRMS;
-        fRMS = sqrt(fRMS);
-    }
 
-    Base::Console().Message("RMS value for '%s' with search radius [%.4f,%.4f] is: %.4f\n",
-        this->Label.getValue(), -this->SearchRadius.getValue(), this->SearchRadius.getValue(), fRMS);
-#else
-    bool useMultithreading = true;
-    unsigned long count = actual->countPoints();
-    std::vector<float> vals(count);
-    std::function<DistanceInspectionRMS(int)> fMap = [&](unsigned int index)
+    DistanceInspectionRMS res;
+    std::mutex mutex;
+    std::function<void(Chunk&)> fMap = [&](Chunk& chunk)
     {
-        DistanceInspectionRMS res;
-        Base::Vector3f pnt = actual->getPoint(index);
-
-        float fMinDist = FLT_MAX;
-        for (std::vector<InspectNominalGeometry*>::iterator it = inspectNominal.begin(); it != inspectNominal.end(); ++it) {
-            float fDist = (*it)->getDistance(pnt);
-            if (fabs(fDist) < fabs(fMinDist))
-                fMinDist = fDist;
-        }
-
-        if (fMinDist > this->SearchRadius.getValue())
-            fMinDist = FLT_MAX;
-        else if (-fMinDist > this->SearchRadius.getValue())
-            fMinDist = -FLT_MAX;
-        else {
-            res.m_sumsq += fMinDist * fMinDist;
-            res.m_numv++;
+        DistanceInspectionRMS part;
+        for (unsigned long index = chunk.first; index < chunk.second; index++) {
+            float fMinDist = check.mapped(index);
+            if (fabs(fMinDist) < FLT_MAX)
+                part.add(fMinDist);
+            vals[index] = fMinDist;
         }
 
-        vals[index] = fMinDist;
-        return res;
+        std::lock_guard<std::mutex> lock(mutex);
+        res += part;
     };
 
-    DistanceInspectionRMS res;
-
-    if (useMultithreading) {
-        // Build vector of increasing indices
-        std::vector<unsigned long> index(count);
-        std::iota(index.begin(), index.end(), 0);
-        // Perform map-reduce operation : compute distances and update sum of squares for RMS computation
-        QFuture<DistanceInspectionRMS> future = QtConcurrent::mappedReduced(
-            index, fMap, &DistanceInspectionRMS::operator+=);
-        // Setup progress bar
-        Base::FutureWatcherProgress progress("Inspecting...", actual->countPoints());
-        QFutureWatcher<DistanceInspectionRMS> watcher;
-        QObject::connect(&watcher, SIGNAL(progressValueChanged(int)),
-            &progress, SLOT(progressValueChanged(int)));
-        // Keep UI responsive during computation
-        QEventLoop loop;
-        QObject::connect(&watcher, SIGNAL(finished()), &loop, SLOT(quit()));
-        watcher.setFuture(future);
-        loop.exec();
-        res = future.result();
-    }
-    else {
-        // Single-threaded operation
-        std::stringstream str;
-        str << "Inspecting " << this->Label.getValue() << "...";
-        Base::SequencerLauncher seq(str.str().c_str(), count);
+    QFuture<void> future = QtConcurrent::map(chunks, fMap);
 
-        for (unsigned int i = 0; i < count; i++)
-            res += fMap(i);
-    }
+    // Setup progress bar which shows the statistics so far and allows to cancel
+    std::stringstream str;
+    str << "Inspecting " << this->Label.getValue() << "...";
+    std::string text = str.str();
+    Base::FutureWatcherProgress progress(text.c_str(), chunks.size());
+    progress.setTextProvider([&]() {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (res.m_numv == 0)
+            return text;
+        std::stringstream status;
+        status << text << " RMS: " << res.getRMS() << ", min: " << res.m_min << ", max: " << res.m_max;
+        return status.str();
+    });
+
+    QFutureWatcher<void> watcher;
+    QObject::connect(&watcher, SIGNAL(progressValueChanged(int)),
+        &progress, SLOT(progressValueChanged(int)));
+    QObject::connect(&progress, SIGNAL(canceled()),
+        &watcher, SLOT(cancel()));
 
-    Base::Console().Message("RMS value for '%s' with search radius [%.4f,%.4f] is: %.4f\n",
-        this->Label.getValue(), -this->SearchRadius.getValue(), this->SearchRadius.getValue(), res.getRMS());
-    Distances.setValues(vals);
-#endif
+    // Keep UI responsive during computation
+    QEventLoop loop;
+    QObject::connect(&watcher, SIGNAL(finished()), &loop, SLOT(quit()));
+    watcher.setFuture(future);
+    loop.exec();
+    future.waitForFinished();
 
     delete actual;
     for (std::vector<InspectNominalGeometry*>::iterator it = inspectNominal.begin(); it != inspectNominal.end(); ++it)
         delete *it;
 
+    if (future.isCanceled())
+        throw Base::AbortException("Inspection canceled");
+
+    Distances.setValues(std::move(vals));
+
+    Base::Console().Message("RMS value for '%s' with search radius [%.4f,%.4f] is: %.4f (min: %.4f, max: %.4f)\n",
+        this->Label.getValue(), -this->SearchRadius.getValue(), this->SearchRadius.getValue(), res.getRMS(),
+        res.m_numv > 0 ? res.m_min : 0.0f, res.m_numv > 0 ? res.m_max : 0.0f);
+
     return 0;
 }
 
@@ -24,6 +24,10 @@
 #ifndef INSPECTION_FEATURE_H
 #define INSPECTION_FEATURE_H
 
+#include <map>
+#include <mutex>
+#include <thread>
+
 #include <App/DocumentObject.h>
 #include <App/PropertyLinks.h>
 #include <App/DocumentObjectGroup.h>
@@ -31,8 +35,8 @@
 #include <Mod/Mesh/App/Core/Iterator.h>
 #include <Mod/Points/App/Points.h>
 
+class gp_Pnt;
 class TopoDS_Shape;
-class BRepExtrema_DistShapeShape;
 
 namespace MeshCore {
 class MeshKernel;
@@ -146,6 +150,12 @@ private:
     Points::PointsGrid* _pGrid;
 };
 
+/**
+ * The faces of the shape are tessellated once and a facet grid is built on top of it.
+ * For a given point the grid delivers the faces that may contain the nearest point and
+ * only for these the exact distance is computed. getDistance() can be called from
+ * several threads at the same time.
+ */
 class InspectionExport InspectNominalShape : public InspectNominalGeometry
 {
 public:
@@ -154,9 +164,20 @@ public:
     virtual float getDistance(const Base::Vector3f&) const;
 
 private:
-    BRepExtrema_DistShapeShape* distss;
+    class FaceGrid;
+    class ThreadContext;
+    ThreadContext& getThreadContext() const;
+    float getShapeDistance(const gp_Pnt&) const;
+    bool isInside(const gp_Pnt&) const;
+
+private:
     const TopoDS_Shape& _rShape;
     bool isSolid;
+    float _offset;
+    FaceGrid* _pGrid;
+    unsigned long _id;
+    mutable std::mutex _mutex;
+    mutable std::map<std::thread::id, ThreadContext*> _contexts;
 };
 
 class InspectionExport PropertyDistanceList: public App::PropertyLists
@@ -189,6 +210,7 @@ public:
     
     void set1Value (const int idx, float value){_lValueList.operator[] (idx) = value;}
     void setValues (const std::vector<float>& values);
+    void setValues (std::vector<float>&& values);
     
     const std::vector<float> &getValues(void) const{return _lValueList;}
     
@@ -445,19 +445,46 @@ PropertyMeshKernel::~PropertyMeshKernel()
     }
 }
 
+void PropertyMeshKernel::setMeshObject(MeshObject* mesh)
+{
+    _meshObject = mesh;
+    // keep the Python wrapper in sync, it may be used to edit the mesh
+    if (meshPyObject)
+        meshPyObject->_pcTwinPointer = mesh;
+}
+
+void PropertyMeshKernel::detachMesh(bool keepData)
+{
+    // The mesh object may be shared with copies of this property, e.g. the
+    // ones kept by the undo/redo stack. So, make an own copy before changing it.
+    if (_meshObject.getRefCount() > 1) {
+        MeshObject* mesh;
+        if (keepData) {
+            mesh = new MeshObject(*_meshObject);
+        }
+        else {
+            // the mesh data will be replaced, only keep the placement
+            mesh = new MeshObject();
+            mesh->setTransform(_meshObject->getTransform());
+        }
+        setMeshObject(mesh);
+    }
+}
+
 void PropertyMeshKernel::setValuePtr(MeshObject* mesh)
 {
     // use the tmp. object to guarantee that the referenced mesh is not destroyed
     // before calling hasSetValue()
     Base::Reference<MeshObject> tmp(_meshObject);
     aboutToSetValue();
-    _meshObject = mesh;
+    setMeshObject(mesh);
     hasSetValue();
 }
 
 void PropertyMeshKernel::setValue(const MeshObject& mesh)
 {
     aboutToSetValue();
+    detachMesh(false);
     *_meshObject = mesh;
     hasSetValue();
 }
@@ -465,6 +492,7 @@ void PropertyMeshKernel::setValue(const MeshObject& mesh)
 void PropertyMeshKernel::setValue(const MeshCore::MeshKernel& mesh)
 {
     aboutToSetValue();
+    detachMesh(false);
     _meshObject->setKernel(mesh);
     hasSetValue();
 }
@@ -472,6 +500,7 @@ void PropertyMeshKernel::setValue(const MeshCore::MeshKernel& mesh)
 void PropertyMeshKernel::swapMesh(MeshObject& mesh)
 {
     aboutToSetValue();
+    detachMesh(false);
     _meshObject->swap(mesh);
     hasSetValue();
 }
@@ -479,6 +508,7 @@ void PropertyMeshKernel::swapMesh(MeshObject& mesh)
 void PropertyMeshKernel::swapMesh(MeshCore::MeshKernel& mesh)
 {
     aboutToSetValue();
+    detachMesh(false);
     _meshObject->swap(mesh);
     hasSetValue();
 }
@@ -511,9 +541,18 @@ unsigned int PropertyMeshKernel::getMemSize (void) const
     return size;
 }
 
+unsigned int PropertyMeshKernel::getExclusiveMemSize (void) const
+{
+    // the mesh object is accounted for by the other owners
+    if (_meshObject.getRefCount() > 1)
+        return sizeof(PropertyMeshKernel);
+    return getMemSize();
+}
+
 MeshObject* PropertyMeshKernel::startEditing()
 {
     aboutToSetValue();
+    detachMesh(true);
     return (MeshObject*)_meshObject;
 }
 
@@ -525,13 +564,21 @@ void PropertyMeshKernel::finishEditing()
 void PropertyMeshKernel::transformGeometry(const Base::Matrix4D &rclMat)
 {
     aboutToSetValue();
+    detachMesh(true);
     _meshObject->transformGeometry(rclMat);
     hasSetValue();
 }
 
+void PropertyMeshKernel::setTransform(const Base::Matrix4D &rclTrf)
+{
+    detachMesh(true);
+    _meshObject->setTransform(rclTrf);
+}
+
 void PropertyMeshKernel::setPointIndices(const std::vector<std::pair<unsigned long, Base::Vector3f> >& inds)
 {
     aboutToSetValue();
+    detachMesh(true);
     MeshCore::MeshKernel& kernel = _meshObject->getKernel();
     for (std::vector<std::pair<unsigned long, Base::Vector3f> >::const_iterator it = inds.begin(); it != inds.end(); ++it)
         kernel.SetPoint(it->first, it->second);
@@ -603,6 +650,7 @@ void PropertyMeshKernel::Restore(Base::XMLReader &reader)
         kernel.Adopt(points, facets);
 
         aboutToSetValue();
+        detachMesh(true);
         _meshObject->getKernel().Adopt(points, facets);
         hasSetValue();
     } 
@@ -620,23 +668,25 @@ void PropertyMeshKernel::SaveDocFile (Base::Writer &writer) const
 void PropertyMeshKernel::RestoreDocFile(Base::Reader &reader)
 {
     aboutToSetValue();
+    detachMesh(true);
     _meshObject->load(reader);
     hasSetValue();
 }
 
 App::Property *PropertyMeshKernel::Copy(void) const
 {
-    // Note: Copy the content, do NOT reference the same mesh object
+    // Note: Reference the same mesh object, it gets copied on modification
     PropertyMeshKernel *prop = new PropertyMeshKernel();
-    *(prop->_meshObject) = *(this->_meshObject);
+    prop->_meshObject = this->_meshObject;
     return prop;
 }
 
 void PropertyMeshKernel::Paste(const App::Property &from)
 {
-    // Note: Copy the content, do NOT reference the same mesh object
-    aboutToSetValue();
+    // Note: Reference the same mesh object, it gets copied on modification
     const PropertyMeshKernel& prop = dynamic_cast<const PropertyMeshKernel&>(from);
-    *(this->_meshObject) = *(prop._meshObject);
+    Base::Reference<MeshObject> tmp(_meshObject);
+    aboutToSetValue();
+    setMeshObject(prop._meshObject);
     hasSetValue();
 }
@@ -200,6 +200,7 @@ public:
     const MeshObject &getValue(void) const;
     const MeshObject *getValuePtr(void) const;
     virtual unsigned int getMemSize (void) const;
+    virtual unsigned int getExclusiveMemSize (void) const;
     //@}
 
     /** @name Getting basic geometric entities */
@@ -216,6 +217,8 @@ public:
     /// Transform the real mesh data
     void transformGeometry(const Base::Matrix4D &rclMat);
     void setPointIndices( const std::vector<std::pair<unsigned long, Base::Vector3f> >& );
+    /// Set the placement of the mesh without notification
+    void setTransform(const Base::Matrix4D &rclTrf);
     //@}
 
     /** @name Python interface */
@@ -245,10 +248,18 @@ public:
     void SaveDocFile (Base::Writer &writer) const;
     void RestoreDocFile(Base::Reader &reader);
 
+    /** Returns a copy of the property that shares the mesh object with this
+     * property. The mesh object is only copied once either of them gets
+     * modified (copy-on-write).
+     */
     App::Property *Copy(void) const;
     void Paste(const App::Property &from);
     //@}
 
+private:
+    void setMeshObject(MeshObject* mesh);
+    void detachMesh(bool keepData);
+
 private:
     Base::Reference<MeshObject> _meshObject;
     MeshPy* meshPyObject;
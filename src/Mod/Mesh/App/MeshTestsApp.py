@@ -230,3 +230,113 @@ class PolynomialFitCases(unittest.TestCase):
 
     def tearDown(self):
         pass
+
+
+class MeshPartProjectionCases(unittest.TestCase):
+    def setUp(self):
+        try:
+            import MeshPart
+        except ImportError:
+            self.skipTest("MeshPart module not available")
+        # planar mesh in the xy plane with 32 triangles
+        planarMesh = []
+        for x in range(4):
+            for y in range(4):
+                planarMesh.append([0.0 + x, 0.0 + y, 0.0])
+                planarMesh.append([1.0 + x, 1.0 + y, 0.0])
+                planarMesh.append([0.0 + x, 1.0 + y, 0.0])
+                planarMesh.append([0.0 + x, 0.0 + y, 0.0])
+                planarMesh.append([1.0 + x, 0.0 + y, 0.0])
+                planarMesh.append([1.0 + x, 1.0 + y, 0.0])
+        self.mesh = Mesh.Mesh(planarMesh)
+        self.direction = FreeCAD.Vector(0, 0, -1)
+
+    def checkArrays(self, arrays, polylines):
+        # the arrays must hold the same polylines as the list based result
+        points, offsets = arrays
+        self.assertIsInstance(points, bytearray)
+        self.assertIsInstance(offsets, bytearray)
+        coords = memoryview(points).cast('f')
+        offsets = memoryview(offsets).cast('I')
+        self.assertEqual(len(offsets), len(polylines) + 1)
+        self.assertEqual(offsets[0], 0)
+        self.assertEqual(3 * offsets[-1], len(coords))
+        for i, poly in enumerate(polylines):
+            self.assertEqual(offsets[i + 1] - offsets[i], len(poly))
+            for j, pnt in enumerate(poly):
+                k = 3 * (offsets[i] + j)
+                self.assertAlmostEqual(coords[k], pnt.x, 5)
+                self.assertAlmostEqual(coords[k + 1], pnt.y, 5)
+                self.assertAlmostEqual(coords[k + 2], pnt.z, 5)
+
+    def checkOnSegment(self, poly, start, end):
+        # all points lie on the plane z=0 below the segment from start to end
+        self.assertAlmostEqual(poly[0].x, start.x, 5)
+        self.assertAlmostEqual(poly[0].y, start.y, 5)
+        self.assertAlmostEqual(poly[-1].x, end.x, 5)
+        self.assertAlmostEqual(poly[-1].y, end.y, 5)
+        dx, dy = end.x - start.x, end.y - start.y
+        for pnt in poly:
+            self.assertAlmostEqual(pnt.z, 0.0, 5)
+            self.assertAlmostEqual(dx * (pnt.y - start.y) - dy * (pnt.x - start.x), 0.0, 4)
+
+    def testProjectInsideFacet(self):
+        import MeshPart
+        # both points hit the facet (0,0,0), (1,0,0), (1,1,0)
+        polygons = [[FreeCAD.Vector(0.6, 0.2, 1), FreeCAD.Vector(0.9, 0.3, 1)]]
+        polylines = MeshPart.projectShapeOnMesh(polygons, self.mesh, self.direction)
+        self.assertEqual(len(polylines), 1)
+        self.assertEqual(len(polylines[0]), 2)
+        self.checkOnSegment(polylines[0], polygons[0][0], polygons[0][1])
+        points, offsets = MeshPart.projectShapeOnMeshToArrays(polygons, self.mesh, self.direction)
+        self.assertEqual(list(memoryview(offsets).cast('I')), [0, 2])
+        coords = memoryview(points).cast('f')
+        for value, expected in zip(coords, [0.6, 0.2, 0.0, 0.9, 0.3, 0.0]):
+            self.assertAlmostEqual(value, expected, 5)
+
+    def testProjectPolygonsToArrays(self):
+        import MeshPart
+        polygons = [[FreeCAD.Vector(0.3, 0.6, 1), FreeCAD.Vector(3.3, 2.1, 1)],
+                    [FreeCAD.Vector(0.2, 3.7, 1), FreeCAD.Vector(1.9, 2.2, 1), FreeCAD.Vector(3.6, 0.4, 1)]]
+        polylines = MeshPart.projectShapeOnMesh(polygons, self.mesh, self.direction)
+        self.assertEqual(len(polylines), 2)
+        # the first segment crosses several facets, each crossing adds a point
+        self.assertGreater(len(polylines[0]), 2)
+        self.checkOnSegment(polylines[0], polygons[0][0], polygons[0][1])
+        self.assertGreater(len(polylines[1]), 4)
+        for pnt in polylines[1]:
+            self.assertAlmostEqual(pnt.z, 0.0, 5)
+        self.assertAlmostEqual(polylines[1][0].x, 0.2, 5)
+        self.assertAlmostEqual(polylines[1][0].y, 3.7, 5)
+        self.assertAlmostEqual(polylines[1][-1].x, 3.6, 5)
+        self.assertAlmostEqual(polylines[1][-1].y, 0.4, 5)
+        arrays = MeshPart.projectShapeOnMeshToArrays(polygons, self.mesh, self.direction)
+        self.checkArrays(arrays, polylines)
+
+    def testProjectMissToArrays(self):
+        import MeshPart
+        # the first polygon is beside the mesh, the second has only one point above it
+        polygons = [[FreeCAD.Vector(10.3, 0.6, 1), FreeCAD.Vector(13.3, 2.1, 1)],
+                    [FreeCAD.Vector(1.5, 1.5, 1), FreeCAD.Vector(11.5, 1.5, 1)]]
+        polylines = MeshPart.projectShapeOnMesh(polygons, self.mesh, self.direction)
+        self.assertEqual([len(poly) for poly in polylines], [0, 0])
+        points, offsets = MeshPart.projectShapeOnMeshToArrays(polygons, self.mesh, self.direction)
+        self.assertEqual(len(points), 0)
+        self.assertEqual(list(memoryview(offsets).cast('I')), [0, 0, 0])
+
+    def testProjectShapeToArrays(self):
+        import MeshPart, Part
+        shape = Part.makePolygon([FreeCAD.Vector(0.3, 0.6, 1), FreeCAD.Vector(3.3, 2.1, 1),
+                                  FreeCAD.Vector(1.2, 3.4, 1)])
+        polylines = MeshPart.projectShapeOnMesh(shape, self.mesh, self.direction)
+        self.assertEqual(len(polylines), 2)
+        self.checkOnSegment(polylines[0], FreeCAD.Vector(0.3, 0.6, 1), FreeCAD.Vector(3.3, 2.1, 1))
+        self.checkOnSegment(polylines[1], FreeCAD.Vector(3.3, 2.1, 1), FreeCAD.Vector(1.2, 3.4, 1))
+        arrays = MeshPart.projectShapeOnMeshToArrays(shape, self.mesh, self.direction)
+        self.checkArrays(arrays, polylines)
+
+    def testProjectNothingToArrays(self):
+        import MeshPart
+        points, offsets = MeshPart.projectShapeOnMeshToArrays([], self.mesh, self.direction)
+        self.assertEqual(len(points), 0)
+        self.assertEqual(list(memoryview(offsets).cast('I')), [0])
@@ -80,6 +80,16 @@ public:
             "projectShapeOnMesh(Shape, Mesh, Vector) -> list of polygons\n"
             "projectShapeOnMesh(list of polygons, Mesh, Vector) -> list of polygons\n"
         );
+        add_varargs_method("projectShapeOnMeshToArrays",&Module::projectShapeOnMeshToArrays,
+            "Projects a shape or sampled edges onto a mesh in a given direction.\n"
+            "The result is returned as a tuple of two bytearrays. The first holds the\n"
+            "x, y, z coordinates of all points as 32-bit floats, the second one the\n"
+            "index of the first point of each polygon and the total number of points as\n"
+            "32-bit unsigned integers. Use e.g. memoryview(points).cast('f') to read them.\n"
+            "\n"
+            "projectShapeOnMeshToArrays(Shape, Mesh, Vector) -> (points, offsets)\n"
+            "projectShapeOnMeshToArrays(list of polygons, Mesh, Vector) -> (points, offsets)\n"
+        );
         add_varargs_method("projectPointsOnMesh",&Module::projectPointsOnMesh,
             "Projects points onto a mesh with a given direction\n"
             "and tolerance."
@@ -251,79 +261,41 @@ private:
 
         return list;
     }
-    Py::Object projectShapeOnMesh(const Py::Tuple& args, const Py::Dict& kwds)
+    /*!
+     * Parses the arguments of a parallel projection, i.e. (Shape, Mesh, Vector) or
+     * (Polygons, Mesh, Vector), and projects them onto the mesh. The result type
+     * can be anything MeshProjection::projectParallelToMesh() accepts.
+     * Returns false with the Python error cleared if the arguments don't match.
+     */
+    template <typename PolyLines>
+    static bool projectParallel(const Py::Tuple& args, PyObject* kwds, PolyLines& polylines)
     {
-        static char* kwds_maxdist[] = {"Shape", "Mesh", "MaxDistance", NULL};
-        PyObject *s, *m;
-        double maxDist;
-        if (PyArg_ParseTupleAndKeywords(args.ptr(), kwds.ptr(),
-                                        "O!O!d", kwds_maxdist,
-                                        &Part::TopoShapePy::Type, &s,
-                                        &Mesh::MeshPy::Type, &m,
-                                        &maxDist)) {
-            TopoDS_Shape shape = static_cast<Part::TopoShapePy*>(s)->getTopoShapePtr()->getShape();
-            const Mesh::MeshObject* mesh = static_cast<Mesh::MeshPy*>(m)->getMeshObjectPtr();
-            MeshCore::MeshKernel kernel(mesh->getKernel());
-            kernel.Transform(mesh->getTransform());
-
-            MeshProjection proj(kernel);
-            std::vector<MeshProjection::PolyLine> polylines;
-            proj.projectToMesh(shape, maxDist, polylines);
-
-            Py::List list;
-            for (auto it : polylines) {
-                Py::List poly;
-                for (auto jt : it.points) {
-                    Py::Vector v(jt);
-                    poly.append(v);
-                }
-                list.append(poly);
-            }
-
-            return list;
-        }
-
         static char* kwds_dir[] = {"Shape", "Mesh", "Direction", NULL};
-        PyErr_Clear();
-        PyObject *v;
-        if (PyArg_ParseTupleAndKeywords(args.ptr(), kwds.ptr(),
+        PyObject *s, *m, *v;
+        TopoDS_Shape shape;
+        bool hasShape = false;
+        std::vector<MeshProjection::PolyLine> polylinesIn;
+        if (PyArg_ParseTupleAndKeywords(args.ptr(), kwds,
                                         "O!O!O!", kwds_dir,
                                         &Part::TopoShapePy::Type, &s,
                                         &Mesh::MeshPy::Type, &m,
                                         &Base::VectorPy::Type, &v)) {
-            TopoDS_Shape shape = static_cast<Part::TopoShapePy*>(s)->getTopoShapePtr()->getShape();
-            const Mesh::MeshObject* mesh = static_cast<Mesh::MeshPy*>(m)->getMeshObjectPtr();
-            Base::Vector3d* vec = static_cast<Base::VectorPy*>(v)->getVectorPtr();
-            Base::Vector3f dir = Base::convertTo<Base::Vector3f>(*vec);
-
-            MeshCore::MeshKernel kernel(mesh->getKernel());
-            kernel.Transform(mesh->getTransform());
-
-            MeshProjection proj(kernel);
-            std::vector<MeshProjection::PolyLine> polylines;
-            proj.projectParallelToMesh(shape, dir, polylines);
-            Py::List list;
-            for (auto it : polylines) {
-                Py::List poly;
-                for (auto jt : it.points) {
-                    Py::Vector v(jt);
-                    poly.append(v);
-                }
-                list.append(poly);
-            }
-
-            return list;
+            shape = static_cast<Part::TopoShapePy*>(s)->getTopoShapePtr()->getShape();
+            hasShape = true;
         }
+        else {
+            static char* kwds_poly[] = {"Polygons", "Mesh", "Direction", NULL};
+            PyErr_Clear();
+            PyObject *seq;
+            if (!PyArg_ParseTupleAndKeywords(args.ptr(), kwds,
+                                             "OO!O!", kwds_poly,
+                                             &seq,
+                                             &Mesh::MeshPy::Type, &m,
+                                             &Base::VectorPy::Type, &v)) {
+                PyErr_Clear();
+                return false;
+            }
 
-        static char* kwds_poly[] = {"Polygons", "Mesh", "Direction", NULL};
-        PyErr_Clear();
-        PyObject *seq;
-        if (PyArg_ParseTupleAndKeywords(args.ptr(), kwds.ptr(),
-                                        "OO!O!", kwds_poly,
-                                        &seq,
-                                        &Mesh::MeshPy::Type, &m,
-                                        &Base::VectorPy::Type, &v)) {
-            std::vector<MeshProjection::PolyLine> polylinesIn;
             Py::Sequence edges(seq);
             polylinesIn.reserve(edges.size());
 
@@ -340,36 +312,92 @@ private:
 
                 polylinesIn.push_back(poly);
             }
+        }
 
-            const Mesh::MeshObject* mesh = static_cast<Mesh::MeshPy*>(m)->getMeshObjectPtr();
-            Base::Vector3d* vec = static_cast<Base::VectorPy*>(v)->getVectorPtr();
-            Base::Vector3f dir = Base::convertTo<Base::Vector3f>(*vec);
+        const Mesh::MeshObject* mesh = static_cast<Mesh::MeshPy*>(m)->getMeshObjectPtr();
+        Base::Vector3d* vec = static_cast<Base::VectorPy*>(v)->getVectorPtr();
+        Base::Vector3f dir = Base::convertTo<Base::Vector3f>(*vec);
+
+        MeshCore::MeshKernel kernel(mesh->getKernel());
+        kernel.Transform(mesh->getTransform());
 
+        MeshProjection proj(kernel);
+        if (hasShape)
+            proj.projectParallelToMesh(shape, dir, polylines);
+        else
+            proj.projectParallelToMesh(polylinesIn, dir, polylines);
+        return true;
+    }
+    static Py::List toPyList(const std::vector<MeshProjection::PolyLine>& polylines)
+    {
+        Py::List list;
+        for (const auto& it : polylines) {
+            Py::List poly;
+            for (const auto& jt : it.points) {
+                Py::Vector v(jt);
+                poly.append(v);
+            }
+            list.append(poly);
+        }
+
+        return list;
+    }
+    Py::Object projectShapeOnMesh(const Py::Tuple& args, const Py::Dict& kwds)
+    {
+        static char* kwds_maxdist[] = {"Shape", "Mesh", "MaxDistance", NULL};
+        PyObject *s, *m;
+        double maxDist;
+        if (PyArg_ParseTupleAndKeywords(args.ptr(), kwds.ptr(),
+                                        "O!O!d", kwds_maxdist,
+                                        &Part::TopoShapePy::Type, &s,
+                                        &Mesh::MeshPy::Type, &m,
+                                        &maxDist)) {
+            TopoDS_Shape shape = static_cast<Part::TopoShapePy*>(s)->getTopoShapePtr()->getShape();
+            const Mesh::MeshObject* mesh = static_cast<Mesh::MeshPy*>(m)->getMeshObjectPtr();
             MeshCore::MeshKernel kernel(mesh->getKernel());
             kernel.Transform(mesh->getTransform());
 
             MeshProjection proj(kernel);
             std::vector<MeshProjection::PolyLine> polylines;
-            proj.projectParallelToMesh(polylinesIn, dir, polylines);
-
-            Py::List list;
-            for (auto it : polylines) {
-                Py::List poly;
-                for (auto jt : it.points) {
-                    Py::Vector v(jt);
-                    poly.append(v);
-                }
-                list.append(poly);
-            }
-
-            return list;
+            proj.projectToMesh(shape, maxDist, polylines);
+            return toPyList(polylines);
         }
 
+        PyErr_Clear();
+        std::vector<MeshProjection::PolyLine> polylines;
+        if (projectParallel(args, kwds.ptr(), polylines))
+            return toPyList(polylines);
+
         throw Py::TypeError("Expected arguments are:\n"
                             "Shape, Mesh, float or\n"
                             "Shape, Mesh, Vector or\n"
                             "Polygons, Mesh, Vector\n");
     }
+    Py::Object projectShapeOnMeshToArrays(const Py::Tuple& args)
+    {
+        MeshProjection::PolyLineArray polylines;
+        if (!projectParallel(args, nullptr, polylines)) {
+            throw Py::TypeError("Expected arguments are:\n"
+                                "Shape, Mesh, Vector or\n"
+                                "Polygons, Mesh, Vector\n");
+        }
+
+        // copy the coordinates one by one to not depend on the layout of Vector3f
+        std::vector<float> coords;
+        coords.reserve(3 * polylines.points.size());
+        for (const auto& it : polylines.points) {
+            coords.push_back(it.x);
+            coords.push_back(it.y);
+            coords.push_back(it.z);
+        }
+
+        Py::Tuple tuple(2);
+        tuple.setItem(0, Py::asObject(PyByteArray_FromStringAndSize(
+            reinterpret_cast<const char*>(coords.data()), coords.size() * sizeof(float))));
+        tuple.setItem(1, Py::asObject(PyByteArray_FromStringAndSize(
+            reinterpret_cast<const char*>(polylines.offsets.data()), polylines.offsets.size() * sizeof(uint32_t))));
+        return tuple;
+    }
     Py::Object projectPointsOnMesh(const Py::Tuple& args)
     {
         PyObject *seq, *m, *v;
@@ -43,8 +43,11 @@
 # include <BRep_Tool.hxx>
 # include <GeomAPI_IntCS.hxx>
 # include <Standard_Failure.hxx>
+# include <climits>
 #endif
 
+#include <QtConcurrentMap>
+
 
 #include "MeshAlgos.h"
 #include "CurveProjector.h"
@@ -926,54 +929,17 @@ void MeshProjection::projectOnMesh(const std::vector<Base::Vector3f>& pointsIn,
 
 void MeshProjection::projectParallelToMesh (const TopoDS_Shape &aShape, const Base::Vector3f& dir, std::vector<PolyLine>& rPolyLines) const
 {
-    // calculate the average edge length and create a grid
-    MeshAlgorithm clAlg(_rcMesh);
-    float fAvgLen = clAlg.GetAverageEdgeLength();
-    MeshFacetGrid cGrid(_rcMesh, 5.0f*fAvgLen);
+    // sample all edges up front, the projection itself doesn't need OCC
+    std::vector<PolyLine> polylines;
     TopExp_Explorer Ex;
-
-    int iCnt=0;
-    for (Ex.Init(aShape, TopAbs_EDGE); Ex.More(); Ex.Next())
-        iCnt++;
-
-    Base::SequencerLauncher seq( "Project curve on mesh", iCnt );
-
     for (Ex.Init(aShape, TopAbs_EDGE); Ex.More(); Ex.Next()) {
         const TopoDS_Edge& aEdge = TopoDS::Edge(Ex.Current());
-        std::vector<Base::Vector3f> points;
-        discretize(aEdge, points, 5);
-
-        typedef std::pair<Base::Vector3f, unsigned long> HitPoint;
-        std::vector<HitPoint> hitPoints;
-        typedef std::pair<HitPoint, HitPoint> HitPoints;
-        std::vector<HitPoints> hitPointPairs;
-        for (auto it : points) {
-            Base::Vector3f result;
-            unsigned long index;
-            if (clAlg.NearestFacetOnRay(it, dir, cGrid, result, index)) {
-                hitPoints.emplace_back(result, index);
-
-                if (hitPoints.size() > 1) {
-                    HitPoint p1 = hitPoints[hitPoints.size()-2];
-                    HitPoint p2 = hitPoints[hitPoints.size()-1];
-                    hitPointPairs.emplace_back(p1, p2);
-                }
-            }
-        }
-
-        MeshCore::MeshProjection meshProjection(_rcMesh);
         PolyLine polyline;
-        for (auto it : hitPointPairs) {
-            points.clear();
-            if (meshProjection.projectLineOnMesh(cGrid, it.first.first, it.first.second,
-                                                 it.second.first, it.second.second, dir, points)) {
-                polyline.points.insert(polyline.points.end(), points.begin(), points.end());
-            }
-        }
-        rPolyLines.push_back(polyline);
-
-        seq.next();
+        discretize(aEdge, polyline.points, 5);
+        polylines.push_back(polyline);
     }
+
+    projectParallelToMesh(polylines, dir, rPolyLines);
 }
 
 void MeshProjection::projectParallelToMesh (const std::vector<PolyLine> &aEdges, const Base::Vector3f& dir, std::vector<PolyLine>& rPolyLines) const
@@ -983,42 +949,92 @@ void MeshProjection::projectParallelToMesh (const std::vector<PolyLine> &aEdges,
     float fAvgLen = clAlg.GetAverageEdgeLength();
     MeshFacetGrid cGrid(_rcMesh, 5.0f*fAvgLen);
 
-    Base::SequencerLauncher seq( "Project curve on mesh", aEdges.size() );
-
-    for (auto it : aEdges) {
-        std::vector<Base::Vector3f> points = it.points;
-
-        typedef std::pair<Base::Vector3f, unsigned long> HitPoint;
-        std::vector<HitPoint> hitPoints;
-        typedef std::pair<HitPoint, HitPoint> HitPoints;
-        std::vector<HitPoints> hitPointPairs;
-        for (auto it : points) {
-            Base::Vector3f result;
-            unsigned long index;
-            if (clAlg.NearestFacetOnRay(it, dir, cGrid, result, index)) {
-                hitPoints.emplace_back(result, index);
-
-                if (hitPoints.size() > 1) {
-                    HitPoint p1 = hitPoints[hitPoints.size()-2];
-                    HitPoint p2 = hitPoints[hitPoints.size()-1];
-                    hitPointPairs.emplace_back(p1, p2);
-                }
-            }
+    // find the hit facets of the sample points of all edges in one go
+    struct HitPoint {
+        Base::Vector3f point;
+        Base::Vector3f result;
+        unsigned long index;
+        bool hit;
+    };
+
+    std::vector<HitPoint> hitPoints;
+    std::vector<std::size_t> firstPoint;
+    firstPoint.reserve(aEdges.size() + 1);
+    for (const auto& it : aEdges) {
+        firstPoint.push_back(hitPoints.size());
+        for (const auto& jt : it.points) {
+            HitPoint hp;
+            hp.point = jt;
+            hp.index = ULONG_MAX;
+            hp.hit = false;
+            hitPoints.push_back(hp);
         }
+    }
+    firstPoint.push_back(hitPoints.size());
 
+    QtConcurrent::blockingMap(hitPoints, [&clAlg, &cGrid, &dir](HitPoint& hp) {
+        hp.hit = clAlg.NearestFacetOnRay(hp.point, dir, cGrid, hp.result, hp.index);
+    });
+
+    // walk over the mesh between two successive hits, each edge on its own
+    std::size_t offset = rPolyLines.size();
+    rPolyLines.resize(offset + aEdges.size());
+    std::vector<std::size_t> edges(aEdges.size());
+    for (std::size_t i = 0; i < edges.size(); i++)
+        edges[i] = i;
+
+    QtConcurrent::blockingMap(edges, [&](std::size_t& edge) {
         MeshCore::MeshProjection meshProjection(_rcMesh);
-        PolyLine polyline;
-        for (auto it : hitPointPairs) {
-            points.clear();
-            if (meshProjection.projectLineOnMesh(cGrid, it.first.first, it.first.second,
-                                                 it.second.first, it.second.second, dir, points)) {
-                polyline.points.insert(polyline.points.end(), points.begin(), points.end());
+        PolyLine& polyline = rPolyLines[offset + edge];
+        std::vector<Base::Vector3f> points;
+        const HitPoint* prev = nullptr;
+        for (std::size_t i = firstPoint[edge]; i < firstPoint[edge+1]; i++) {
+            const HitPoint& next = hitPoints[i];
+            if (!next.hit)
+                continue;
+            if (prev) {
+                points.clear();
+                if (meshProjection.projectLineOnMesh(cGrid, prev->result, prev->index,
+                                                     next.result, next.index, dir, points)) {
+                    polyline.points.insert(polyline.points.end(), points.begin(), points.end());
+                }
             }
+            prev = &next;
         }
-        rPolyLines.push_back(polyline);
+    });
+}
 
-        seq.next();
+namespace {
+void toPolyLineArray(const std::vector<MeshProjection::PolyLine>& polylines, MeshProjection::PolyLineArray& array)
+{
+    std::size_t numPoints = 0;
+    for (const auto& it : polylines)
+        numPoints += it.points.size();
+
+    array.points.clear();
+    array.points.reserve(numPoints);
+    array.offsets.clear();
+    array.offsets.reserve(polylines.size() + 1);
+    for (const auto& it : polylines) {
+        array.offsets.push_back(static_cast<uint32_t>(array.points.size()));
+        array.points.insert(array.points.end(), it.points.begin(), it.points.end());
     }
+    array.offsets.push_back(static_cast<uint32_t>(array.points.size()));
+}
+}
+
+void MeshProjection::projectParallelToMesh (const std::vector<PolyLine> &aEdges, const Base::Vector3f& dir, PolyLineArray& rPolyLines) const
+{
+    std::vector<PolyLine> polylines;
+    projectParallelToMesh(aEdges, dir, polylines);
+    toPolyLineArray(polylines, rPolyLines);
+}
+
+void MeshProjection::projectParallelToMesh (const TopoDS_Shape &aShape, const Base::Vector3f& dir, PolyLineArray& rPolyLines) const
+{
+    std::vector<PolyLine> polylines;
+    projectParallelToMesh(aShape, dir, polylines);
+    toPolyLineArray(polylines, rPolyLines);
 }
 
 void MeshProjection::projectEdgeToEdge( const TopoDS_Edge &aEdge, float fMaxDist, const MeshFacetGrid& rGrid,
@@ -174,6 +174,13 @@ public:
     {
         std::vector<Base::Vector3f> points;
     };
+    /// Polylines in columnar form: polyline i consists of
+    /// points[offsets[i]] ... points[offsets[i+1]-1]
+    struct PolyLineArray
+    {
+        std::vector<Base::Vector3f> points;
+        std::vector<uint32_t> offsets;
+    };
 
     /// Construction
     MeshProjection(const MeshKernel& rMesh);
@@ -216,6 +223,12 @@ public:
      * Project all polylines onto the mesh using parallel projection.
      */
     void projectParallelToMesh (const std::vector<PolyLine>& aEdges, const Base::Vector3f& dir, std::vector<PolyLine>& rPolyLines) const;
+    /**
+     * Project all polylines onto the mesh using parallel projection and store the result
+     * in flat arrays.
+     */
+    void projectParallelToMesh (const std::vector<PolyLine>& aEdges, const Base::Vector3f& dir, PolyLineArray& rPolyLines) const;
+    void projectParallelToMesh (const TopoDS_Shape &aShape, const Base::Vector3f& dir, PolyLineArray& rPolyLines) const;
     /**
      * Cuts the mesh at the curve defined by \a aShape. This method call @ref projectToMesh() to get the
      * split the facet at the found points. @see projectToMesh() for more details.
@@ -22,6 +22,7 @@
 
 #include "PreCompiled.h"
 #include <algorithm>
+#include <climits>
 #include "Mesher.h"
 
 #include <Base/Console.h>
@@ -30,11 +31,22 @@
 #include <Mod/Mesh/App/Mesh.h>
 #include <Mod/Part/App/TopoShape.h>
 
+#include <TopoDS.hxx>
+#include <TopoDS_Face.hxx>
 #include <TopoDS_Shape.hxx>
+#include <TopoDS_Vertex.hxx>
+#include <TopExp.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+#include <BRep_Tool.hxx>
 #include <BRepTools.hxx>
 #include <BRepMesh_IncrementalMesh.hxx>
+#include <Poly_PolygonOnTriangulation.hxx>
+#include <Poly_Triangulation.hxx>
 #include <Standard_Version.hxx>
 
+#include <QtConcurrentMap>
+
 #ifdef HAVE_SMESH
 #if defined(__clang__)
 # pragma clang diagnostic push
@@ -119,38 +131,124 @@ int MeshingOutput::sync()
 
 // ----------------------------------------------------------------------------
 
-struct Mesher::Vertex {
-    static const double deflection;
-    Standard_Real x,y,z;
-    Standard_Integer i;
-    mutable MeshCore::MeshPoint p;
-
-    Vertex(Standard_Real X, Standard_Real Y, Standard_Real Z)
-        : x(X),y(Y),z(Z),i(0)
-    {
-        p.x = static_cast<float>(x);
-        p.y = static_cast<float>(y);
-        p.z = static_cast<float>(z);
+namespace {
+
+/**
+ * The nodes of the triangulation of a face that lie on one of its edges
+ */
+struct FaceEdge {
+    Handle(Poly_PolygonOnTriangulation) polygon;
+    int edge;               // index in the edge map, 0 if degenerated
+    unsigned long vertex1;  // global index of the first vertex
+    unsigned long vertex2;  // global index of the last vertex
+};
+
+/**
+ * The discretisation of an edge shared by the faces of the shape. The inner nodes
+ * of the edge get consecutive global indices starting at \a first.
+ */
+struct EdgeNodes {
+    int numNodes;
+    unsigned long first;
+};
+
+/**
+ * A face whose triangulation is copied into the mesh. The nodes on the boundary
+ * are mapped directly to the global indices of the shared vertex and edge nodes,
+ * only the inner nodes are added by the face itself.
+ */
+struct FaceMesh {
+    TopoDS_Face face;
+    Handle(Poly_Triangulation) triangulation;
+    TopLoc_Location loc;
+    std::vector<FaceEdge> edges;
+
+    // filled in by the worker
+    MeshCore::MeshPointArray points;    // the inner nodes
+    MeshCore::MeshFacetArray facets;    // indices flagged with InnerNode refer to points
+    unsigned long firstPoint;
+    unsigned long firstFacet;
+};
+
+const unsigned long InnerNode = 0x80000000UL;
+
+void mapFaceNodes(FaceMesh& fm, const std::vector<EdgeNodes>& edgeNodes)
+{
+    const TColgp_Array1OfPnt& nodes = fm.triangulation->Nodes();
+    std::vector<unsigned long> local(nodes.Length(), ULONG_MAX);
+
+    for (const auto& it : fm.edges) {
+        const TColStd_Array1OfInteger& indices = it.polygon->Nodes();
+        int count = indices.Length();
+        if (it.edge == 0) {
+            for (int i = indices.Lower(); i <= indices.Upper(); i++)
+                local[indices(i) - 1] = it.vertex1;
+            continue;
+        }
+
+        // the discretisation doesn't conform to the one of the other faces,
+        // keep the nodes of this face
+        const EdgeNodes& shared = edgeNodes[it.edge];
+        if (count != shared.numNodes)
+            continue;
+
+        local[indices(indices.Lower()) - 1] = it.vertex1;
+        local[indices(indices.Upper()) - 1] = it.vertex2;
+        for (int i = 1; i < count - 1; i++)
+            local[indices(indices.Lower() + i) - 1] = shared.first + i - 1;
     }
 
-    const MeshCore::MeshPoint& toPoint() const
-    {
-        return p;
+    gp_Trsf trsf = fm.loc.Transformation();
+    for (std::size_t i = 0; i < local.size(); i++) {
+        if (local[i] == ULONG_MAX) {
+            gp_Pnt p = nodes(static_cast<int>(i) + nodes.Lower());
+            p.Transform(trsf);
+            local[i] = InnerNode | static_cast<unsigned long>(fm.points.size());
+            fm.points.emplace_back(static_cast<float>(p.X()),
+                                   static_cast<float>(p.Y()),
+                                   static_cast<float>(p.Z()));
+        }
     }
 
-    bool operator < (const Vertex &v) const
-    {
-        if (fabs ( this->x - v.x) >= deflection)
-            return this->x < v.x;
-        if (fabs ( this->y - v.y) >= deflection)
-            return this->y < v.y;
-        if (fabs ( this->z - v.z) >= deflection)
-            return this->z < v.z;
-        return false; // points are considered to be equal
+    bool flip = (fm.face.Orientation() == TopAbs_REVERSED);
+    const Poly_Array1OfTriangle& triangles = fm.triangulation->Triangles();
+    fm.facets.reserve(triangles.Length());
+    for (int i = triangles.Lower(); i <= triangles.Upper(); i++) {
+        Standard_Integer n1, n2, n3;
+        triangles(i).Get(n1, n2, n3);
+        if (flip)
+            std::swap(n1, n2);
+
+        MeshCore::MeshFacet facet;
+        facet._aulPoints[0] = local[n1 - 1];
+        facet._aulPoints[1] = local[n2 - 1];
+        facet._aulPoints[2] = local[n3 - 1];
+
+        // make sure that we don't insert invalid facets
+        if (facet._aulPoints[0] != facet._aulPoints[1] &&
+            facet._aulPoints[1] != facet._aulPoints[2] &&
+            facet._aulPoints[2] != facet._aulPoints[0]) {
+            fm.facets.push_back(facet);
+        }
     }
-};
+}
 
-const double Mesher::Vertex::deflection = gp::Resolution();
+void copyFaceMesh(FaceMesh& fm, MeshCore::MeshPointArray& points, MeshCore::MeshFacetArray& facets)
+{
+    std::copy(fm.points.begin(), fm.points.end(), points.begin() + fm.firstPoint);
+    for (std::size_t i = 0; i < fm.facets.size(); i++) {
+        MeshCore::MeshFacet facet = fm.facets[i];
+        for (int j = 0; j < 3; j++) {
+            if (facet._aulPoints[j] & InnerNode)
+                facet._aulPoints[j] = fm.firstPoint + (facet._aulPoints[j] & ~InnerNode);
+        }
+        facets[fm.firstFacet + i] = facet;
+    }
+
+    MeshCore::MeshPointArray().swap(fm.points);
+}
+
+}
 
 // ----------------------------------------------------------------------------
 
@@ -189,111 +287,134 @@ Mesh::MeshObject* Mesher::createMesh() const
     if (method == Standard) {
         if (!shape.IsNull()) {
             BRepTools::Clean(shape);
-            BRepMesh_IncrementalMesh aMesh(shape, deflection, relative, angularDeflection);
+            // the faces are meshed in parallel, their common edges only once
+            BRepMesh_IncrementalMesh aMesh(shape, deflection, relative, angularDeflection, Standard_True);
         }
 
-        std::vector<Part::TopoShape::Domain> domains;
-        Part::TopoShape(shape).getDomains(domains);
+        // The vertices and the edges are discretised once for all the faces that
+        // share them, so that the face triangulations can be stitched by index.
+        TopTools_IndexedMapOfShape vertexMap, edgeMap;
+        TopExp::MapShapes(shape, TopAbs_VERTEX, vertexMap);
+        TopExp::MapShapes(shape, TopAbs_EDGE, edgeMap);
 
-        std::map<uint32_t, std::vector<std::size_t> > colorMap;
-        for (std::size_t i=0; i<colors.size(); i++) {
-            colorMap[colors[i]].push_back(i);
+        MeshCore::MeshPointArray verts;
+        verts.reserve(vertexMap.Extent());
+        for (int i = 1; i <= vertexMap.Extent(); i++) {
+            gp_Pnt p = BRep_Tool::Pnt(TopoDS::Vertex(vertexMap(i)));
+            verts.emplace_back(static_cast<float>(p.X()),
+                               static_cast<float>(p.Y()),
+                               static_cast<float>(p.Z()));
         }
 
-        bool createSegm = (colors.size() == domains.size());
-
-        MeshCore::MeshFacetArray faces;
-        std::size_t numTriangles = 0;
-        for (auto it : domains)
-            numTriangles += it.facets.size();
-        faces.reserve(numTriangles);
-
-        std::set<Vertex> vertices;
-        Standard_Real x1, y1, z1;
-        Standard_Real x2, y2, z2;
-        Standard_Real x3, y3, z3;
-
-        std::vector< std::vector<unsigned long> > meshSegments;
-        std::size_t numMeshFaces = 0;
-
-        for (std::size_t i = 0; i < domains.size(); ++i) {
-            std::size_t numDomainFaces = 0;
-            const Part::TopoShape::Domain& domain = domains[i];
-            for (std::size_t j = 0; j < domain.facets.size(); ++j) {
-                const Part::TopoShape::Facet& tria = domain.facets[j];
-                x1 = domain.points[tria.I1].x;
-                y1 = domain.points[tria.I1].y;
-                z1 = domain.points[tria.I1].z;
-
-                x2 = domain.points[tria.I2].x;
-                y2 = domain.points[tria.I2].y;
-                z2 = domain.points[tria.I2].z;
-
-                x3 = domain.points[tria.I3].x;
-                y3 = domain.points[tria.I3].y;
-                z3 = domain.points[tria.I3].z;
-
-                std::set<Vertex>::iterator it;
-                MeshCore::MeshFacet face;
-
-                // 1st vertex
-                Vertex v1(x1,y1,z1);
-                it = vertices.find(v1);
-                if (it == vertices.end()) {
-                    v1.i = vertices.size();
-                    face._aulPoints[0] = v1.i;
-                    vertices.insert(v1);
-                }
-                else {
-                    face._aulPoints[0] = it->i;
+        // the order of the faces must be the same as in TopoShape::getDomains
+        // because the colors refer to it
+        std::vector<FaceMesh> faceMeshes;
+        std::vector<EdgeNodes> edgeNodes(edgeMap.Extent() + 1, EdgeNodes{0, 0});
+        for (TopExp_Explorer xp(shape, TopAbs_FACE); xp.More(); xp.Next()) {
+            FaceMesh fm;
+            fm.face = TopoDS::Face(xp.Current());
+            fm.triangulation = BRep_Tool::Triangulation(fm.face, fm.loc);
+            fm.firstPoint = 0;
+            fm.firstFacet = 0;
+            if (!fm.triangulation.IsNull()) {
+                for (TopExp_Explorer xe(fm.face, TopAbs_EDGE); xe.More(); xe.Next()) {
+                    const TopoDS_Edge& edge = TopoDS::Edge(xe.Current());
+                    FaceEdge fe;
+                    fe.polygon = BRep_Tool::PolygonOnTriangulation(edge, fm.triangulation, fm.loc);
+                    if (fe.polygon.IsNull())
+                        continue;
+
+                    TopoDS_Vertex v1, v2;
+                    TopExp::Vertices(edge, v1, v2);
+                    fe.vertex1 = static_cast<unsigned long>(vertexMap.FindIndex(v1) - 1);
+                    fe.vertex2 = static_cast<unsigned long>(vertexMap.FindIndex(v2) - 1);
+                    fe.edge = BRep_Tool::Degenerated(edge) ? 0 : edgeMap.FindIndex(edge);
+
+                    // the first face that has the edge defines its inner nodes
+                    EdgeNodes& shared = edgeNodes[fe.edge];
+                    if (fe.edge > 0 && shared.numNodes == 0) {
+                        const TColStd_Array1OfInteger& indices = fe.polygon->Nodes();
+                        const TColgp_Array1OfPnt& nodes = fm.triangulation->Nodes();
+                        gp_Trsf trsf = fm.loc.Transformation();
+                        shared.numNodes = indices.Length();
+                        shared.first = verts.size();
+                        for (int i = indices.Lower() + 1; i < indices.Upper(); i++) {
+                            gp_Pnt p = nodes(indices(i));
+                            p.Transform(trsf);
+                            verts.emplace_back(static_cast<float>(p.X()),
+                                               static_cast<float>(p.Y()),
+                                               static_cast<float>(p.Z()));
+                        }
+                    }
+                    fm.edges.push_back(fe);
                 }
+            }
+            faceMeshes.push_back(fm);
+        }
 
-                // 2nd vertex
-                Vertex v2(x2,y2,z2);
-                it = vertices.find(v2);
-                if (it == vertices.end()) {
-                    v2.i = vertices.size();
-                    face._aulPoints[1] = v2.i;
-                    vertices.insert(v2);
-                }
-                else {
-                    face._aulPoints[1] = it->i;
-                }
+        QtConcurrent::blockingMap(faceMeshes, [&edgeNodes](FaceMesh& fm) {
+            if (!fm.triangulation.IsNull())
+                mapFaceNodes(fm, edgeNodes);
+        });
+
+        std::size_t numPoints = verts.size();
+        std::size_t numFacets = 0;
+        for (auto& it : faceMeshes) {
+            it.firstPoint = numPoints;
+            it.firstFacet = numFacets;
+            numPoints += it.points.size();
+            numFacets += it.facets.size();
+        }
 
-                // 3rd vertex
-                Vertex v3(x3,y3,z3);
-                it = vertices.find(v3);
-                if (it == vertices.end()) {
-                    v3.i = vertices.size();
-                    face._aulPoints[2] = v3.i;
-                    vertices.insert(v3);
-                }
-                else {
-                    face._aulPoints[2] = it->i;
-                }
+        if (numPoints >= InnerNode)
+            throw Base::RuntimeError("Too many points to create a mesh");
 
-                // make sure that we don't insert invalid facets
-                if (face._aulPoints[0] != face._aulPoints[1] &&
-                    face._aulPoints[1] != face._aulPoints[2] &&
-                    face._aulPoints[2] != face._aulPoints[0]) {
-                    faces.push_back(face);
-                    numDomainFaces++;
+        MeshCore::MeshFacetArray faces;
+        verts.resize(numPoints);
+        faces.resize(numFacets);
+        QtConcurrent::blockingMap(faceMeshes, [&verts, &faces](FaceMesh& fm) {
+            copyFaceMesh(fm, verts, faces);
+        });
+
+        // drop vertices and edge nodes that are not part of a triangulated face
+        std::vector<unsigned long> pointIndex(verts.size(), 0);
+        for (const auto& it : faces) {
+            for (int i = 0; i < 3; i++)
+                pointIndex[it._aulPoints[i]] = 1;
+        }
+        if (std::find(pointIndex.begin(), pointIndex.end(), 0) != pointIndex.end()) {
+            unsigned long count = 0;
+            for (std::size_t i = 0; i < pointIndex.size(); i++) {
+                if (pointIndex[i]) {
+                    verts[count] = verts[i];
+                    pointIndex[i] = count++;
                 }
             }
+            verts.resize(count);
+            for (auto& it : faces) {
+                for (int i = 0; i < 3; i++)
+                    it._aulPoints[i] = pointIndex[it._aulPoints[i]];
+            }
+        }
 
-            // add a segment for the face
-            if (createSegm || this->segments) {
-                std::vector<unsigned long> segment(numDomainFaces);
-                std::generate(segment.begin(), segment.end(), Base::iotaGen<unsigned long>(numMeshFaces));
-                numMeshFaces += numDomainFaces;
+        std::map<uint32_t, std::vector<std::size_t> > colorMap;
+        for (std::size_t i=0; i<colors.size(); i++) {
+            colorMap[colors[i]].push_back(i);
+        }
+
+        bool createSegm = (colors.size() == faceMeshes.size());
+
+        // add a segment for each face
+        std::vector< std::vector<unsigned long> > meshSegments;
+        if (createSegm || this->segments) {
+            meshSegments.reserve(faceMeshes.size());
+            for (const auto& it : faceMeshes) {
+                std::vector<unsigned long> segment(it.facets.size());
+                std::generate(segment.begin(), segment.end(), Base::iotaGen<unsigned long>(it.firstFacet));
                 meshSegments.push_back(segment);
             }
         }
-
-        MeshCore::MeshPointArray verts;
-        verts.resize(vertices.size());
-        for (auto it : vertices)
-            verts[it.i] = it.toPoint();
+        faceMeshes.clear();
 
         MeshCore::MeshKernel kernel;
         kernel.Adopt(verts, faces, true);
@@ -443,14 +564,18 @@ Mesh::MeshObject* Mesher::createMesh() const
     verts.reserve(mesh->NbNodes());
     faces.reserve(mesh->NbFaces());
 
+    // map the node ids directly to the point indices
     int index=0;
-    std::map<const SMDS_MeshNode*, int> mapNodeIndex;
+    std::vector<int> mapNodeIndex(mesh->GetMeshDS()->MaxNodeID() + 1, -1);
+    auto nodeIndex = [&mapNodeIndex](const SMDS_MeshNode* node) {
+        return mapNodeIndex[node->GetID()];
+    };
     for (;aNodeIter->more();) {
         const SMDS_MeshNode* aNode = aNodeIter->next();
         MeshCore::MeshPoint p;
         p.Set((float)aNode->X(), (float)aNode->Y(), (float)aNode->Z());
         verts.push_back(p);
-        mapNodeIndex[aNode] = index++;
+        mapNodeIndex[aNode->GetID()] = index++;
     }
     for (;aFaceIter->more();) {
         const SMDS_MeshFace* aFace = aFaceIter->next();
@@ -458,7 +583,7 @@ Mesh::MeshObject* Mesher::createMesh() const
             MeshCore::MeshFacet f;
             for (int i=0; i<3;i++) {
                 const SMDS_MeshNode* node = aFace->GetNode(i);
-                f._aulPoints[i] = mapNodeIndex[node];
+                f._aulPoints[i] = nodeIndex(node);
             }
             faces.push_back(f);
         }
@@ -469,13 +594,13 @@ Mesh::MeshObject* Mesher::createMesh() const
             const SMDS_MeshNode* node2 = aFace->GetNode(2);
             const SMDS_MeshNode* node3 = aFace->GetNode(3);
 
-            f1._aulPoints[0] = mapNodeIndex[node0];
-            f1._aulPoints[1] = mapNodeIndex[node1];
-            f1._aulPoints[2] = mapNodeIndex[node2];
+            f1._aulPoints[0] = nodeIndex(node0);
+            f1._aulPoints[1] = nodeIndex(node1);
+            f1._aulPoints[2] = nodeIndex(node2);
 
-            f2._aulPoints[0] = mapNodeIndex[node0];
-            f2._aulPoints[1] = mapNodeIndex[node2];
-            f2._aulPoints[2] = mapNodeIndex[node3];
+            f2._aulPoints[0] = nodeIndex(node0);
+            f2._aulPoints[1] = nodeIndex(node2);
+            f2._aulPoints[2] = nodeIndex(node3);
 
             faces.push_back(f1);
             faces.push_back(f2);
@@ -489,21 +614,21 @@ Mesh::MeshObject* Mesher::createMesh() const
             const SMDS_MeshNode* node4 = aFace->GetNode(4);
             const SMDS_MeshNode* node5 = aFace->GetNode(5);
 
-            f1._aulPoints[0] = mapNodeIndex[node0];
-            f1._aulPoints[1] = mapNodeIndex[node3];
-            f1._aulPoints[2] = mapNodeIndex[node5];
+            f1._aulPoints[0] = nodeIndex(node0);
+            f1._aulPoints[1] = nodeIndex(node3);
+            f1._aulPoints[2] = nodeIndex(node5);
 
-            f2._aulPoints[0] = mapNodeIndex[node1];
-            f2._aulPoints[1] = mapNodeIndex[node4];
-            f2._aulPoints[2] = mapNodeIndex[node3];
+            f2._aulPoints[0] = nodeIndex(node1);
+            f2._aulPoints[1] = nodeIndex(node4);
+            f2._aulPoints[2] = nodeIndex(node3);
 
-            f3._aulPoints[0] = mapNodeIndex[node2];
-            f3._aulPoints[1] = mapNodeIndex[node5];
-            f3._aulPoints[2] = mapNodeIndex[node4];
+            f3._aulPoints[0] = nodeIndex(node2);
+            f3._aulPoints[1] = nodeIndex(node5);
+            f3._aulPoints[2] = nodeIndex(node4);
 
-            f4._aulPoints[0] = mapNodeIndex[node3];
-            f4._aulPoints[1] = mapNodeIndex[node4];
-            f4._aulPoints[2] = mapNodeIndex[node5];
+            f4._aulPoints[0] = nodeIndex(node3);
+            f4._aulPoints[1] = nodeIndex(node4);
+            f4._aulPoints[2] = nodeIndex(node5);
 
             faces.push_back(f1);
             faces.push_back(f2);
@@ -521,21 +646,21 @@ Mesh::MeshObject* Mesher::createMesh() const
             const SMDS_MeshNode* node6 = aFace->GetNode(6);
             const SMDS_MeshNode* node7 = aFace->GetNode(7);
 
-            f1._aulPoints[0] = mapNodeIndex[node0];
-            f1._aulPoints[1] = mapNodeIndex[node4];
-            f1._aulPoints[2] = mapNodeIndex[node7];
+            f1._aulPoints[0] = nodeIndex(node0);
+            f1._aulPoints[1] = nodeIndex(node4);
+            f1._aulPoints[2] = nodeIndex(node7);
 
-            f2._aulPoints[0] = mapNodeIndex[node1];
-            f2._aulPoints[1] = mapNodeIndex[node5];
-            f2._aulPoints[2] = mapNodeIndex[node4];
+            f2._aulPoints[0] = nodeIndex(node1);
+            f2._aulPoints[1] = nodeIndex(node5);
+            f2._aulPoints[2] = nodeIndex(node4);
 
-            f3._aulPoints[0] = mapNodeIndex[node2];
-            f3._aulPoints[1] = mapNodeIndex[node6];
-            f3._aulPoints[2] = mapNodeIndex[node5];
+            f3._aulPoints[0] = nodeIndex(node2);
+            f3._aulPoints[1] = nodeIndex(node6);
+            f3._aulPoints[2] = nodeIndex(node5);
 
-            f4._aulPoints[0] = mapNodeIndex[node3];
-            f4._aulPoints[1] = mapNodeIndex[node7];
-            f4._aulPoints[2] = mapNodeIndex[node6];
+            f4._aulPoints[0] = nodeIndex(node3);
+            f4._aulPoints[1] = nodeIndex(node7);
+            f4._aulPoints[2] = nodeIndex(node6);
 
             // Two solutions are possible:
             // <4,6,7>, <4,5,6> or <4,5,7>, <5,6,7>
@@ -546,22 +671,22 @@ Mesh::MeshObject* Mesher::createMesh() const
             double dist46 = Base::DistanceP2(v4,v6);
             double dist57 = Base::DistanceP2(v5,v7);
             if (dist46 > dist57) {
-                f5._aulPoints[0] = mapNodeIndex[node4];
-                f5._aulPoints[1] = mapNodeIndex[node6];
-                f5._aulPoints[2] = mapNodeIndex[node7];
+                f5._aulPoints[0] = nodeIndex(node4);
+                f5._aulPoints[1] = nodeIndex(node6);
+                f5._aulPoints[2] = nodeIndex(node7);
 
-                f6._aulPoints[0] = mapNodeIndex[node4];
-                f6._aulPoints[1] = mapNodeIndex[node5];
-                f6._aulPoints[2] = mapNodeIndex[node6];
+                f6._aulPoints[0] = nodeIndex(node4);
+                f6._aulPoints[1] = nodeIndex(node5);
+                f6._aulPoints[2] = nodeIndex(node6);
             }
             else {
-                f5._aulPoints[0] = mapNodeIndex[node4];
-                f5._aulPoints[1] = mapNodeIndex[node5];
-                f5._aulPoints[2] = mapNodeIndex[node7];
+                f5._aulPoints[0] = nodeIndex(node4);
+                f5._aulPoints[1] = nodeIndex(node5);
+                f5._aulPoints[2] = nodeIndex(node7);
 
-                f6._aulPoints[0] = mapNodeIndex[node5];
-                f6._aulPoints[1] = mapNodeIndex[node6];
-                f6._aulPoints[2] = mapNodeIndex[node7];
+                f6._aulPoints[0] = nodeIndex(node5);
+                f6._aulPoints[1] = nodeIndex(node6);
+                f6._aulPoints[2] = nodeIndex(node7);
             }
 
             faces.push_back(f1);
@@ -155,7 +155,6 @@ private:
     bool allowquad;
 #endif
     std::vector<uint32_t> colors;
-    struct Vertex;
 
     static SMESH_Gen *_mesh_gen;
 };
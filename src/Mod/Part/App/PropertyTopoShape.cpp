@@ -205,6 +205,9 @@ void PropertyPartShape::setPyObject(PyObject *value)
 
 App::Property *PropertyPartShape::Copy(void) const
 {
+    // Note: The underlying TShapes can be modified in place, e.g. by meshing
+    // the shape or by the in-place methods of the Python shape object, so the
+    // copy used for undo must not share them with the property.
     PropertyPartShape *prop = new PropertyPartShape();
     prop->_Shape = this->_Shape;
     if (!_Shape.getShape().IsNull()) {
@@ -227,6 +230,17 @@ unsigned int PropertyPartShape::getMemSize (void) const
     return _Shape.getMemSize();
 }
 
+unsigned int PropertyPartShape::getExclusiveMemSize (void) const
+{
+#if OCC_VERSION_HEX >= 0x070000
+    // the shape data is accounted for by the other owners
+    const TopoDS_Shape& shape = _Shape.getShape();
+    if (!shape.IsNull() && shape.TShape()->GetRefCount() > 1)
+        return sizeof(PropertyPartShape);
+#endif
+    return getMemSize();
+}
+
 void PropertyPartShape::getPaths(std::vector<App::ObjectIdentifier> &paths) const
 {
     paths.push_back(App::ObjectIdentifier(getContainer()) << App::ObjectIdentifier::Component::SimpleComponent(getName())
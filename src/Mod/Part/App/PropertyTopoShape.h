@@ -86,6 +86,7 @@ public:
     App::Property *Copy(void) const;
     void Paste(const App::Property &from);
     unsigned int getMemSize (void) const;
+    unsigned int getExclusiveMemSize (void) const;
     //@}
 
     /// Get valid paths for this property; used by auto completer
@@ -0,0 +1,157 @@
+/***************************************************************************
+ *   Copyright (c) 2020 FreeCAD Developers                                 *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <algorithm>
+# include <float.h>
+# include <Inventor/actions/SoRayPickAction.h>
+# include <Inventor/elements/SoCoordinateElement.h>
+#endif
+
+#include "PickBVH.h"
+
+using namespace PartGui;
+
+namespace {
+// number of primitives stored in a leaf
+const int LeafSize = 8;
+}
+
+PickBVH::PickBVH() : valid(false), coordNodeId(0), numCoords(0)
+{
+}
+
+void PickBVH::clear()
+{
+    valid = false;
+    nodes.clear();
+    primitives.clear();
+}
+
+bool PickBVH::isValid(const SoCoordinateElement *coords) const
+{
+    return valid && coords
+        && coords->getNodeId() == coordNodeId
+        && coords->getNum() == numCoords;
+}
+
+void PickBVH::build(const std::vector<SbBox3f> &boxes, const SoCoordinateElement *coords)
+{
+    clear();
+    coordNodeId = coords ? coords->getNodeId() : 0;
+    numCoords = coords ? coords->getNum() : 0;
+    valid = true;
+
+    if (boxes.empty())
+        return;
+
+    std::vector<SbVec3f> centers;
+    centers.reserve(boxes.size());
+    for (const auto &box : boxes)
+        centers.push_back(box.getCenter());
+
+    primitives.resize(boxes.size());
+    for (std::size_t i=0; i<boxes.size(); ++i)
+        primitives[i] = static_cast<int32_t>(i);
+    nodes.reserve(2 * boxes.size() / LeafSize + 1);
+    buildNode(boxes, centers, 0, static_cast<int>(boxes.size()));
+
+    // Points and axis aligned edges give flat boxes which the intersection
+    // test of SoRayPickAction may miss, so give every box a little thickness.
+    const SbBox3f &root = nodes.front().box;
+    float eps = std::max((root.getMax() - root.getMin()).length() * 1e-6f, FLT_EPSILON);
+    SbVec3f delta(eps, eps, eps);
+    for (auto &node : nodes)
+        node.box.setBounds(node.box.getMin() - delta, node.box.getMax() + delta);
+}
+
+int PickBVH::buildNode(const std::vector<SbBox3f> &boxes, const std::vector<SbVec3f> &centers,
+                       int first, int count)
+{
+    int index = static_cast<int>(nodes.size());
+    nodes.emplace_back();
+
+    SbBox3f box, centerBox;
+    for (int i=first; i<first+count; ++i) {
+        box.extendBy(boxes[primitives[i]]);
+        centerBox.extendBy(centers[primitives[i]]);
+    }
+    nodes[index].box = box;
+
+    if (count <= LeafSize) {
+        nodes[index].first = first;
+        nodes[index].count = count;
+        return index;
+    }
+
+    // split at the median of the longest axis of the primitive centers
+    SbVec3f size = centerBox.getMax() - centerBox.getMin();
+    int axis = 0;
+    if (size[1] > size[axis])
+        axis = 1;
+    if (size[2] > size[axis])
+        axis = 2;
+
+    int half = count / 2;
+    std::nth_element(primitives.begin() + first, primitives.begin() + first + half,
+            primitives.begin() + first + count,
+            [&centers, axis](int32_t a, int32_t b) {
+                return centers[a][axis] < centers[b][axis];
+            });
+
+    buildNode(boxes, centers, first, half);
+    int second = buildNode(boxes, centers, first + half, count - half);
+    nodes[index].first = second;
+    nodes[index].count = 0;
+    return index;
+}
+
+void PickBVH::pick(SoRayPickAction *action, std::vector<int> &result) const
+{
+    result.clear();
+    if (nodes.empty())
+        return;
+
+    int stack[64];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        const Node &node = nodes[stack[--top]];
+        if (!action->intersect(node.box, TRUE))
+            continue;
+        if (node.count > 0) {
+            result.insert(result.end(), primitives.begin() + node.first,
+                    primitives.begin() + node.first + node.count);
+        }
+        else {
+            int self = static_cast<int>(&node - &nodes[0]);
+            stack[top++] = node.first;
+            stack[top++] = self + 1;
+        }
+    }
+
+    // report the primitives in their original order to get the same picked
+    // points as with the traversal of all primitives
+    std::sort(result.begin(), result.end());
+}
@@ -0,0 +1,84 @@
+/***************************************************************************
+ *   Copyright (c) 2020 FreeCAD Developers                                 *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef PARTGUI_PICKBVH_H
+#define PARTGUI_PICKBVH_H
+
+#include <Inventor/SbBox3f.h>
+#include <Inventor/SbBasic.h>
+#include <vector>
+
+class SoRayPickAction;
+class SoCoordinateElement;
+
+namespace PartGui {
+
+/**
+ * A bounding volume hierarchy over the primitives (triangles, line segments
+ * or points) of one of the SoBrep* shape nodes. It is used to answer ray pick
+ * queries without generating the primitives of the whole shape: only the
+ * primitives whose leaf box is hit by the pick volume are tested.
+ *
+ * The tree is built lazily on the first pick and kept until the owning node
+ * invalidates it, i.e. until its index fields or the coordinates change.
+ */
+class PartGuiExport PickBVH
+{
+public:
+    /// Shapes with less primitives are picked the conventional way
+    static const int MinPrimitives = 64;
+
+    PickBVH();
+
+    /// Discards the tree, the next pick rebuilds it
+    void clear();
+    /// Checks whether the tree has been built for the given coordinates
+    bool isValid(const SoCoordinateElement *coords) const;
+    /// Builds the tree from the bounding box of each primitive
+    void build(const std::vector<SbBox3f> &boxes, const SoCoordinateElement *coords);
+    /** Collects the primitives whose leaf box intersects the pick volume of
+     *  \a action. The indices refer to the boxes passed to build().
+     */
+    void pick(SoRayPickAction *action, std::vector<int> &primitives) const;
+
+private:
+    struct Node {
+        SbBox3f box;
+        /// index of the first primitive for leaves, of the second child otherwise
+        int32_t first;
+        /// number of primitives, 0 for inner nodes whose first child follows directly
+        int32_t count;
+    };
+
+    int buildNode(const std::vector<SbBox3f> &boxes, const std::vector<SbVec3f> &centers,
+                  int first, int count);
+
+    std::vector<Node> nodes;
+    std::vector<int32_t> primitives;
+    bool valid;
+    uint32_t coordNodeId;
+    int numCoords;
+};
+
+} // namespace PartGui
+
+#endif // PARTGUI_PICKBVH_H
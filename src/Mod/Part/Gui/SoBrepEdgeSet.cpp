@@ -42,10 +42,12 @@
 # include <Inventor/actions/SoGetPrimitiveCountAction.h>
 # include <Inventor/actions/SoGLRenderAction.h>
 # include <Inventor/actions/SoPickAction.h>
+# include <Inventor/actions/SoRayPickAction.h>
 # include <Inventor/actions/SoWriteAction.h>
 # include <Inventor/bundles/SoMaterialBundle.h>
 # include <Inventor/bundles/SoTextureCoordinateBundle.h>
 # include <Inventor/elements/SoOverrideElement.h>
+# include <Inventor/elements/SoPickStyleElement.h>
 # include <Inventor/elements/SoCoordinateElement.h>
 # include <Inventor/elements/SoGLCoordinateElement.h>
 # include <Inventor/elements/SoGLCacheContextElement.h>
@@ -55,7 +57,9 @@
 # include <Inventor/errors/SoReadError.h>
 # include <Inventor/details/SoFaceDetail.h>
 # include <Inventor/details/SoLineDetail.h>
+# include <Inventor/details/SoPointDetail.h>
 # include <Inventor/misc/SoState.h>
+# include <Inventor/misc/SoNotification.h>
 # include <Inventor/elements/SoCacheElement.h>
 #endif
 
@@ -466,6 +470,92 @@ void SoBrepEdgeSet::doAction(SoAction* action)
     inherited::doAction(action);
 }
 
+void SoBrepEdgeSet::notify(SoNotList * list)
+{
+    SoField *f = list->getLastField();
+    if (f == &this->coordIndex || f == &this->vertexProperty)
+        pickTree.clear();
+    inherited::notify(list);
+}
+
+void SoBrepEdgeSet::rayPick(SoRayPickAction *action)
+{
+    // Only the segments whose box is hit by the pick ray are tested. Small
+    // nodes and pick styles other than SHAPE use the default implementation.
+    if (this->coordIndex.getNum() < PickBVH::MinPrimitives
+            || SoPickStyleElement::get(action->getState()) != SoPickStyleElement::SHAPE) {
+        inherited::rayPick(action);
+        return;
+    }
+
+    if (!this->shouldRayPick(action))
+        return;
+
+    SoState * state = action->getState();
+    if (this->vertexProperty.getValue()) {
+        state->push();
+        this->vertexProperty.getValue()->doAction(action);
+    }
+
+    const SoCoordinateElement * coords = SoCoordinateElement::getInstance(state);
+    const int32_t * cindices = this->coordIndex.getValues(0);
+    int numindices = this->coordIndex.getNum();
+
+    if (!pickTree.isValid(coords)) {
+        int numcoords = coords->getNum();
+        std::vector<SbBox3f> boxes;
+        pickSegments.clear();
+        int32_t line = 0;
+        for (int i=0; i+1<numindices; i++) {
+            int32_t v1 = cindices[i];
+            int32_t v2 = cindices[i+1];
+            if (v1 < 0) {
+                ++line;
+                continue;
+            }
+            if (v2 < 0 || v1 >= numcoords || v2 >= numcoords)
+                continue;
+            SbBox3f box;
+            box.extendBy(coords->get3(v1));
+            box.extendBy(coords->get3(v2));
+            boxes.push_back(box);
+            pickSegments.emplace_back(i, line);
+        }
+        pickTree.build(boxes, coords);
+    }
+
+    this->computeObjectSpaceRay(action);
+
+    std::vector<int> candidates;
+    pickTree.pick(action, candidates);
+
+    for (int i : candidates) {
+        const auto &segment = pickSegments[i];
+        int32_t v1 = cindices[segment.first];
+        int32_t v2 = cindices[segment.first+1];
+
+        SbVec3f isect;
+        if (!action->intersect(coords->get3(v1), coords->get3(v2), isect) || !action->isBetweenPlanes(isect))
+            continue;
+        SoPickedPoint * pp = action->addIntersection(isect);
+        if (!pp)
+            continue;
+
+        SoLineDetail * detail = new SoLineDetail;
+        detail->setLineIndex(segment.second);
+        detail->setPartIndex(segment.second);
+        SoPointDetail pd;
+        pd.setCoordinateIndex(v1);
+        detail->setPoint0(&pd);
+        pd.setCoordinateIndex(v2);
+        detail->setPoint1(&pd);
+        pp->setDetail(detail, this);
+    }
+
+    if (this->vertexProperty.getValue())
+        state->pop();
+}
+
 SoDetail * SoBrepEdgeSet::createLineSegmentDetail(SoRayPickAction * action,
                                                   const SoPrimitiveVertex * v1,
                                                   const SoPrimitiveVertex * v2,
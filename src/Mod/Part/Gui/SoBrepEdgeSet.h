@@ -34,6 +34,7 @@
 #include <vector>
 #include <memory>
 #include <Gui/SoFCSelectionContext.h>
+#include "PickBVH.h"
 
 class SoCoordinateElement;
 class SoGLCoordinateElement;
@@ -62,6 +63,8 @@ protected:
         SoPickedPoint *pp);
 
     virtual void getBoundingBox(SoGetBoundingBoxAction * action);
+    virtual void rayPick(SoRayPickAction *action);
+    virtual void notify(SoNotList * list);
 
 private:
     struct SelContext;
@@ -78,6 +81,11 @@ private:
     SelContextPtr selContext2;
     Gui::SoFCSelectionCounter selCounter;
     uint32_t packedColor;
+
+    // Lazily built tree of the line segments for picking
+    PickBVH pickTree;
+    // position in coordIndex and line index of each segment
+    std::vector<std::pair<int32_t, int32_t> > pickSegments;
 };
 
 } // namespace PartGui
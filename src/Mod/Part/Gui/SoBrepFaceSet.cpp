@@ -40,11 +40,13 @@
 # include <Inventor/actions/SoGetPrimitiveCountAction.h>
 # include <Inventor/actions/SoGLRenderAction.h>
 # include <Inventor/actions/SoPickAction.h>
+# include <Inventor/actions/SoRayPickAction.h>
 # include <Inventor/actions/SoWriteAction.h>
 # include <Inventor/bundles/SoMaterialBundle.h>
 # include <Inventor/bundles/SoTextureCoordinateBundle.h>
 # include <Inventor/elements/SoLazyElement.h>
 # include <Inventor/elements/SoOverrideElement.h>
+# include <Inventor/elements/SoPickStyleElement.h>
 # include <Inventor/elements/SoCoordinateElement.h>
 # include <Inventor/elements/SoGLCoordinateElement.h>
 # include <Inventor/elements/SoGLCacheContextElement.h>
@@ -54,9 +56,11 @@
 # include <Inventor/errors/SoDebugError.h>
 # include <Inventor/errors/SoReadError.h>
 # include <Inventor/details/SoFaceDetail.h>
+# include <Inventor/details/SoPointDetail.h>
 # include <Inventor/details/SoLineDetail.h>
 # include <Inventor/misc/SoState.h>
 # include <Inventor/misc/SoContextHandler.h>
+# include <Inventor/misc/SoNotification.h>
 # include <Inventor/elements/SoShapeStyleElement.h>
 # include <Inventor/elements/SoCacheElement.h>
 # include <Inventor/elements/SoTextureEnabledElement.h>
@@ -1903,6 +1907,107 @@ void SoBrepFaceSet::renderShape(SoGLRenderAction * action,
     glEnd();
 }
 
+void SoBrepFaceSet::notify(SoNotList * list)
+{
+    SoField *f = list->getLastField();
+    if (f == &this->coordIndex || f == &this->partIndex || f == &this->vertexProperty)
+        pickTree.clear();
+    inherited::notify(list);
+}
+
+void SoBrepFaceSet::rayPick(SoRayPickAction *action)
+{
+    // Only the triangles whose box is hit by the pick ray are tested. Small
+    // shapes, anything that is not a pure triangle set (see
+    // generatePrimitives()) and pick styles other than SHAPE are left to the
+    // default implementation.
+    int numindices = this->coordIndex.getNum();
+    if (numindices < 4*PickBVH::MinPrimitives || numindices % 4 != 0
+            || SoPickStyleElement::get(action->getState()) != SoPickStyleElement::SHAPE) {
+        inherited::rayPick(action);
+        return;
+    }
+
+    if (!this->shouldRayPick(action))
+        return;
+
+    SoState * state = action->getState();
+    if (this->vertexProperty.getValue()) {
+        state->push();
+        this->vertexProperty.getValue()->doAction(action);
+    }
+
+    const SoCoordinateElement * coords = SoCoordinateElement::getInstance(state);
+    const int32_t * cindices = this->coordIndex.getValues(0);
+    int numtriangles = numindices / 4;
+    int numcoords = coords->getNum();
+
+    if (!pickTree.isValid(coords)) {
+        std::vector<SbBox3f> boxes;
+        boxes.reserve(numtriangles);
+        for (int i=0; i<numtriangles; i++) {
+            const int32_t *tri = &cindices[i*4];
+            if (tri[0] < 0 || tri[1] < 0 || tri[2] < 0 || tri[3] >= 0
+                    || tri[0] >= numcoords || tri[1] >= numcoords || tri[2] >= numcoords) {
+                boxes.clear();
+                break;
+            }
+            SbBox3f box;
+            box.extendBy(coords->get3(tri[0]));
+            box.extendBy(coords->get3(tri[1]));
+            box.extendBy(coords->get3(tri[2]));
+            boxes.push_back(box);
+        }
+        if (boxes.size() != (std::size_t)numtriangles) {
+            if (this->vertexProperty.getValue())
+                state->pop();
+            inherited::rayPick(action);
+            return;
+        }
+        pickTree.build(boxes, coords);
+    }
+
+    this->computeObjectSpaceRay(action);
+
+    std::vector<int> candidates;
+    pickTree.pick(action, candidates);
+
+    for (int i : candidates) {
+        const int32_t *tri = &cindices[i*4];
+        const SbVec3f &v0 = coords->get3(tri[0]);
+        const SbVec3f &v1 = coords->get3(tri[1]);
+        const SbVec3f &v2 = coords->get3(tri[2]);
+
+        SbVec3f isect, bary;
+        SbBool front;
+        if (!action->intersect(v0, v1, v2, isect, bary, front) || !action->isBetweenPlanes(isect))
+            continue;
+        SoPickedPoint * pp = action->addIntersection(isect);
+        if (!pp)
+            continue;
+
+        SoFaceDetail * detail = new SoFaceDetail;
+        detail->setFaceIndex(i);
+        int part = findPartIndex(i);
+        if (part >= 0)
+            detail->setPartIndex(part);
+        detail->setNumPoints(3);
+        SoPointDetail pd;
+        for (int j=0; j<3; j++) {
+            pd.setCoordinateIndex(tri[j]);
+            detail->setPoint(j, &pd);
+        }
+        pp->setDetail(detail, this);
+
+        SbVec3f normal = (v1 - v0).cross(v2 - v0);
+        normal.normalize();
+        pp->setObjectNormal(normal);
+    }
+
+    if (this->vertexProperty.getValue())
+        state->pop();
+}
+
 SoDetail * SoBrepFaceSet::createTriangleDetail(SoRayPickAction * action,
                                                const SoPrimitiveVertex * v1,
                                                const SoPrimitiveVertex * v2,
@@ -1910,23 +2015,30 @@ SoDetail * SoBrepFaceSet::createTriangleDetail(SoRayPickAction * action,
                                                SoPickedPoint * pp)
 {
     SoDetail* detail = inherited::createTriangleDetail(action, v1, v2, v3, pp);
-    const int32_t * indices = this->partIndex.getValues(0);
-    int num = this->partIndex.getNum();
-    if (indices) {
+    if (detail && this->partIndex.getNum() > 0) {
         SoFaceDetail* face_detail = static_cast<SoFaceDetail*>(detail);
-        int index = face_detail->getFaceIndex();
-        int count = 0;
-        for (int i=0; i<num; i++) {
-            count += indices[i];
-            if (index < count) {
-                face_detail->setPartIndex(i);
-                break;
-            }
-        }
+        int part = findPartIndex(face_detail->getFaceIndex());
+        if (part >= 0)
+            face_detail->setPartIndex(part);
     }
     return detail;
 }
 
+int SoBrepFaceSet::findPartIndex(int faceIndex) const
+{
+    // Returns the part containing the given triangle, or -1 if it is not
+    // covered by partIndex
+    const int32_t * indices = this->partIndex.getValues(0);
+    int num = this->partIndex.getNum();
+    int count = 0;
+    for (int i=0; i<num; i++) {
+        count += indices[i];
+        if (faceIndex < count)
+            return i;
+    }
+    return -1;
+}
+
 SoBrepFaceSet::Binding
 SoBrepFaceSet::findMaterialBinding(SoState * const state) const
 {
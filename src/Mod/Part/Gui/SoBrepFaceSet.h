@@ -34,6 +34,7 @@
 #include <vector>
 #include <memory>
 #include <Gui/SoFCSelectionContext.h>
+#include "PickBVH.h"
 
 class SoGLCoordinateElement;
 class SoTextureCoordinateBundle;
@@ -99,6 +100,8 @@ protected:
         SoPickedPoint * pp);
     virtual void generatePrimitives(SoAction * action);
     virtual void getBoundingBox(SoGetBoundingBoxAction * action);
+    virtual void rayPick(SoRayPickAction *action);
+    virtual void notify(SoNotList * list);
 
 private:
     enum Binding {
@@ -113,6 +116,7 @@ private:
     };
     Binding findMaterialBinding(SoState * const state) const;
     Binding findNormalBinding(SoState * const state) const;
+    int findPartIndex(int faceIndex) const;
     void renderShape(SoGLRenderAction * action,
                      SbBool hasVBO,
                      const SoGLCoordinateElement * const vertexlist,
@@ -155,6 +159,9 @@ private:
     uint32_t packedColor;
     Gui::SoFCSelectionCounter selCounter;
 
+    // Lazily built tree of the triangles for picking
+    PickBVH pickTree;
+
     // Define some VBO pointer for the current mesh
     class VBO;
     std::unique_ptr<VBO> pimpl;
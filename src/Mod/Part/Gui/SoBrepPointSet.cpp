@@ -42,10 +42,12 @@
 # include <Inventor/actions/SoGetPrimitiveCountAction.h>
 # include <Inventor/actions/SoGLRenderAction.h>
 # include <Inventor/actions/SoPickAction.h>
+# include <Inventor/actions/SoRayPickAction.h>
 # include <Inventor/actions/SoWriteAction.h>
 # include <Inventor/bundles/SoMaterialBundle.h>
 # include <Inventor/bundles/SoTextureCoordinateBundle.h>
 # include <Inventor/elements/SoOverrideElement.h>
+# include <Inventor/elements/SoPickStyleElement.h>
 # include <Inventor/elements/SoCoordinateElement.h>
 # include <Inventor/elements/SoGLCoordinateElement.h>
 # include <Inventor/elements/SoGLCacheContextElement.h>
@@ -55,7 +57,9 @@
 # include <Inventor/errors/SoReadError.h>
 # include <Inventor/details/SoFaceDetail.h>
 # include <Inventor/details/SoLineDetail.h>
+# include <Inventor/details/SoPointDetail.h>
 # include <Inventor/misc/SoState.h>
+# include <Inventor/misc/SoNotification.h>
 #endif
 
 #include "SoBrepPointSet.h"
@@ -181,6 +185,73 @@ void SoBrepPointSet::getBoundingBox(SoGetBoundingBoxAction * action) {
         action->extendBy(bbox);
 }
 
+void SoBrepPointSet::notify(SoNotList * list)
+{
+    SoField *f = list->getLastField();
+    if (f == &this->startIndex || f == &this->numPoints || f == &this->vertexProperty)
+        pickTree.clear();
+    inherited::notify(list);
+}
+
+void SoBrepPointSet::rayPick(SoRayPickAction *action)
+{
+    if (SoPickStyleElement::get(action->getState()) != SoPickStyleElement::SHAPE) {
+        inherited::rayPick(action);
+        return;
+    }
+
+    if (!this->shouldRayPick(action))
+        return;
+
+    SoState * state = action->getState();
+    if (this->vertexProperty.getValue()) {
+        state->push();
+        this->vertexProperty.getValue()->doAction(action);
+    }
+
+    const SoCoordinateElement * coords = SoCoordinateElement::getInstance(state);
+    int start = this->startIndex.getValue();
+    int num = this->numPoints.getValue();
+    if (num < 0 || start + num > coords->getNum())
+        num = coords->getNum() - start;
+
+    // Only the points whose box is hit by the pick ray are tested
+    if (num < PickBVH::MinPrimitives) {
+        if (this->vertexProperty.getValue())
+            state->pop();
+        inherited::rayPick(action);
+        return;
+    }
+
+    if (!pickTree.isValid(coords)) {
+        std::vector<SbBox3f> boxes(num);
+        for (int i=0; i<num; i++)
+            boxes[i].extendBy(coords->get3(start+i));
+        pickTree.build(boxes, coords);
+    }
+
+    this->computeObjectSpaceRay(action);
+
+    std::vector<int> candidates;
+    pickTree.pick(action, candidates);
+
+    for (int i : candidates) {
+        const SbVec3f &pt = coords->get3(start+i);
+        if (!action->intersect(pt) || !action->isBetweenPlanes(pt))
+            continue;
+        SoPickedPoint * pp = action->addIntersection(pt);
+        if (!pp)
+            continue;
+
+        SoPointDetail * detail = new SoPointDetail;
+        detail->setCoordinateIndex(start+i);
+        pp->setDetail(detail, this);
+    }
+
+    if (this->vertexProperty.getValue())
+        state->pop();
+}
+
 void SoBrepPointSet::renderHighlight(SoGLRenderAction *action, SelContextPtr ctx)
 {
     if(!ctx || ctx->highlightIndex<0)
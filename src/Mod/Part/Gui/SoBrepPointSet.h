@@ -34,6 +34,7 @@
 #include <vector>
 #include <memory>
 #include <Gui/SoFCSelectionContext.h>
+#include "PickBVH.h"
 
 class SoCoordinateElement;
 class SoGLCoordinateElement;
@@ -57,6 +58,8 @@ protected:
     virtual void doAction(SoAction* action); 
 
     virtual void getBoundingBox(SoGetBoundingBoxAction * action);
+    virtual void rayPick(SoRayPickAction *action);
+    virtual void notify(SoNotList * list);
 
 private:
     typedef Gui::SoFCSelectionContext SelContext;
@@ -69,6 +72,9 @@ private:
     SelContextPtr selContext2;
     Gui::SoFCSelectionCounter selCounter;
     uint32_t packedColor;
+
+    // Lazily built tree of the points for picking
+    PickBVH pickTree;
 };
 
 } // namespace PartGui
@@ -34,6 +34,7 @@
 # include <BRepBuilderAPI_Copy.hxx>
 # include <BRepBndLib.hxx>
 # include <Bnd_Box.hxx>
+# include <deque>
 #endif
 
 
@@ -269,6 +270,23 @@ App::DocumentObjectExecReturn *Transformed::execute(void)
             return new App::DocumentObjectExecReturn("Only additive and subtractive features can be transformed");
         }
 
+        // Fuse or cut all transformed shapes at once if possible. This is not
+        // done for features with both an add and a sub shape, as for these the
+        // order of the operations matters.
+        if (fuseShape.isNull() != cutShape.isNull()) {
+            std::vector<std::size_t> nointersect;
+            if (fuseOrCutAll(support, fuseShape.isNull() ? cutShape.getShape() : fuseShape.getShape(),
+                             !fuseShape.isNull(), transformations, nointersect)) {
+                for (std::vector<std::size_t>::const_iterator it = nointersect.begin(); it != nointersect.end(); ++it) {
+#ifdef FC_DEBUG // do not write this in release mode because a message appears already in the task view
+                    Base::Console().Warning("Transformed shape does not intersect support %s: Removed\n", (*o)->getNameInDocument());
+#endif
+                    nointersect_trsfms[*o].insert(transformations.begin() + *it);
+                }
+                continue;
+            }
+        }
+
         // Transform the add/subshape and collect the resulting shapes for overlap testing
         /*typedef std::vector<std::vector<gp_Trsf>::const_iterator> trsf_it_vec;
         trsf_it_vec v_transformations;
@@ -398,6 +416,100 @@ App::DocumentObjectExecReturn *Transformed::execute(void)
     return App::DocumentObject::StdReturn;
 }
 
+bool Transformed::fuseOrCutAll(TopoDS_Shape &support, const TopoDS_Shape &shape, bool fuse,
+                               const std::vector<gp_Trsf> &transformations,
+                               std::vector<std::size_t> &nointersect) const
+{
+    try {
+        // Skip first transformation, which is always the identity transformation
+        std::vector<TopoDS_Shape> tools;
+        std::vector<Bnd_Box> boxes;
+        for (std::vector<gp_Trsf>::const_iterator t = transformations.begin() + 1; t != transformations.end(); ++t) {
+            // Make an explicit copy of the shape because the "true" parameter to BRepBuilderAPI_Transform
+            // seems to be pretty broken
+            BRepBuilderAPI_Copy copy(shape);
+            if (copy.Shape().IsNull())
+                return false;
+
+            BRepBuilderAPI_Transform mkTrf(copy.Shape(), *t, false); // No need to copy, now
+            if (!mkTrf.IsDone())
+                return false;
+
+            tools.push_back(mkTrf.Shape());
+            boxes.push_back(Bnd_Box());
+            BRepBndLib::Add(tools.back(), boxes.back());
+        }
+
+        Bnd_Box supportBox;
+        BRepBndLib::Add(support, supportBox);
+
+        // Cull the transformed shapes by their bounding boxes. Cutting a shape
+        // that does not touch the support does nothing. A fused shape has to
+        // touch the support, either directly or through other fused shapes.
+        std::vector<bool> used(tools.size(), false);
+        std::deque<std::size_t> queue;
+        for (std::size_t i = 0; i < tools.size(); ++i) {
+            if (!boxes[i].IsOut(supportBox)) {
+                used[i] = true;
+                queue.push_back(i);
+            }
+        }
+        while (fuse && !queue.empty()) {
+            std::size_t j = queue.front();
+            queue.pop_front();
+            for (std::size_t i = 0; i < tools.size(); ++i) {
+                if (!used[i] && !boxes[i].IsOut(boxes[j])) {
+                    used[i] = true;
+                    queue.push_back(i);
+                }
+            }
+        }
+
+        std::vector<TopoDS_Shape> selected;
+        std::vector<std::size_t> culled;
+        for (std::size_t i = 0; i < tools.size(); ++i) {
+            if (used[i])
+                selected.push_back(tools[i]);
+            else if (fuse)
+                culled.push_back(i + 1);
+        }
+
+        // Nothing to fuse or cut, the culled shapes are disjoint from the support
+        if (selected.empty()) {
+            nointersect = culled;
+            return true;
+        }
+
+        Part::TopoShape supportShape(support);
+        TopoDS_Shape result;
+        if (fuse) {
+            result = supportShape.fuse(selected);
+            // A shape not intersecting the support results in an extra solid. Leave it to
+            // the step by step fusion to find out which one it was.
+            if (supportShape.countSubShapes(TopAbs_SOLID) != Part::TopoShape(result).countSubShapes(TopAbs_SOLID))
+                return false;
+            // we have to get the solids (fuse sometimes creates compounds)
+            result = this->getSolid(result);
+        }
+        else {
+            result = supportShape.cut(selected);
+        }
+
+        if (result.IsNull())
+            return false;
+
+        support = result;
+        nointersect = culled;
+        return true;
+    }
+    catch (Standard_Failure&) {
+        return false;
+    }
+    catch (Base::Exception&) {
+        return false;
+    }
+}
+
 TopoDS_Shape Transformed::refineShapeIfActive(const TopoDS_Shape& oldShape) const
 {
     if (this->Refine.getValue()) {
@@ -94,6 +94,17 @@ protected:
     TopoDS_Shape refineShapeIfActive(const TopoDS_Shape&) const;
     void divideTools(const std::vector<TopoDS_Shape> &toolsIn, std::vector<TopoDS_Shape> &individualsOut,
 		     TopoDS_Compound &compoundOut) const; 
+    /** Fuse or cut all transformed copies of \a shape with \a support in a single boolean operation
+     * @param support The support, replaced by the result on success
+     * @param shape The untransformed add or sub shape
+     * @param fuse Whether to fuse or to cut the transformed shapes
+     * @param transformations The transformations, the first one being the identity
+     * @param nointersect Returns the indices of the transformations that do not intersect the support
+     * @return false if the transformations must be applied one at a time instead
+     */
+    bool fuseOrCutAll(TopoDS_Shape &support, const TopoDS_Shape &shape, bool fuse,
+                      const std::vector<gp_Trsf> &transformations,
+                      std::vector<std::size_t> &nointersect) const;
 
     rejectedMap rejected;
 };
@@ -55,6 +55,7 @@
 #include <map>
 #include <vector>
 #include <set>
+#include <deque>
 #include <bitset>
 
 #include <cstring>
@@ -0,0 +1,106 @@
+/***************************************************************************
+ *   Copyright (c) 2020 FreeCAD Developers                                 *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+# include <mutex>
+# include <string>
+# include <unordered_map>
+#endif
+
+#ifndef FC_OS_WIN32
+# include <cstdlib>
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <unistd.h>
+#endif
+
+#include <App/Application.h>
+#include <Base/Console.h>
+
+#include "PagedStorage.h"
+
+using namespace Points;
+
+namespace {
+// Blocks mapped from a file, with their mapped size
+std::mutex mappedMutex;
+std::unordered_map<void*, std::size_t> mappedBlocks;
+}
+
+std::size_t PageStore::threshold()
+{
+    static std::size_t bytes = []() {
+        ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath(
+            "User parameter:BaseApp/Preferences/Mod/Points");
+        long mb = hGrp->GetInt("PagedStorageThreshold", 256);
+        return mb > 0 ? static_cast<std::size_t>(mb) << 20 : std::size_t(0);
+    }();
+    return bytes;
+}
+
+void* PageStore::allocate(std::size_t bytes)
+{
+#ifndef FC_OS_WIN32
+    std::size_t limit = threshold();
+    if (limit > 0 && bytes >= limit) {
+        long pageSize = sysconf(_SC_PAGESIZE);
+        std::size_t size = (bytes + pageSize - 1) / pageSize * pageSize;
+        std::string path = App::Application::getTempPath() + "FreeCADPoints.XXXXXX";
+        int fd = mkstemp(&path[0]);
+        if (fd >= 0) {
+            // the file is only reachable through the mapping
+            unlink(path.c_str());
+            void* ptr = MAP_FAILED;
+            if (ftruncate(fd, static_cast<off_t>(size)) == 0)
+                ptr = mmap(0, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            close(fd);
+            if (ptr != MAP_FAILED) {
+                std::lock_guard<std::mutex> lock(mappedMutex);
+                mappedBlocks[ptr] = size;
+                return ptr;
+            }
+        }
+        Base::Console().Log("Points: failed to map %lu bytes from a file, using the heap\n",
+                            static_cast<unsigned long>(bytes));
+    }
+#endif
+    return ::operator new(bytes);
+}
+
+void PageStore::deallocate(void* ptr, std::size_t bytes)
+{
+    (void)bytes;
+#ifndef FC_OS_WIN32
+    {
+        std::lock_guard<std::mutex> lock(mappedMutex);
+        auto it = mappedBlocks.find(ptr);
+        if (it != mappedBlocks.end()) {
+            munmap(ptr, it->second);
+            mappedBlocks.erase(it);
+            return;
+        }
+    }
+#endif
+    ::operator delete(ptr);
+}
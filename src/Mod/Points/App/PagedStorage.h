@@ -0,0 +1,92 @@
+/***************************************************************************
+ *   Copyright (c) 2020 FreeCAD Developers                                 *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef POINTS_PAGEDSTORAGE_H
+#define POINTS_PAGEDSTORAGE_H
+
+#include <cstddef>
+#include <new>
+
+namespace Points
+{
+
+/** Backing store for large point arrays
+ *
+ * Blocks above a size threshold are mapped from an unlinked temporary file
+ * instead of being taken from the heap. The pages of such a block are backed
+ * by the file, so the operating system can write them back and evict them
+ * under memory pressure without using swap space, and only the pages in use
+ * stay resident. Smaller blocks, and all blocks on systems without mmap, are
+ * allocated with operator new.
+ *
+ * The threshold is read once from the parameter PagedStorageThreshold (in MB,
+ * 0 disables the file backed pages) of the Points preferences.
+ */
+class PointsExport PageStore
+{
+public:
+    static void* allocate(std::size_t bytes);
+    static void deallocate(void* ptr, std::size_t bytes);
+    static std::size_t threshold();
+};
+
+/// Allocator to keep the points of a PointKernel in a PageStore
+template <class T>
+class PagedAllocator
+{
+public:
+    typedef T value_type;
+
+    PagedAllocator()
+    {
+    }
+    template <class U>
+    PagedAllocator(const PagedAllocator<U>&)
+    {
+    }
+
+    T* allocate(std::size_t n)
+    {
+        return static_cast<T*>(PageStore::allocate(n * sizeof(T)));
+    }
+    void deallocate(T* ptr, std::size_t n)
+    {
+        PageStore::deallocate(ptr, n * sizeof(T));
+    }
+};
+
+template <class T, class U>
+bool operator == (const PagedAllocator<T>&, const PagedAllocator<U>&)
+{
+    return true;
+}
+
+template <class T, class U>
+bool operator != (const PagedAllocator<T>&, const PagedAllocator<U>&)
+{
+    return false;
+}
+
+} // namespace Points
+
+#endif // POINTS_PAGEDSTORAGE_H
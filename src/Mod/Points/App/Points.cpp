@@ -23,7 +23,9 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+# include <algorithm>
 # include <cmath>
+# include <functional>
 # include <iostream>
 #endif
 
@@ -49,6 +51,32 @@ using namespace std;
 
 TYPESYSTEM_SOURCE(Points::PointKernel, Data::ComplexGeoData)
 
+namespace {
+// The points are processed in pages of a fixed size. This keeps the overhead per task of the
+// concurrent algorithms low and the memory accessed by a single task contiguous.
+typedef std::pair<PointKernel::size_type, PointKernel::size_type> PointPage;
+const PointKernel::size_type PointPageSize = 65536;
+
+std::vector<PointPage> makePages(PointKernel::size_type count)
+{
+    std::vector<PointPage> pages;
+    pages.reserve(count / PointPageSize + 1);
+    for (PointKernel::size_type first = 0; first < count; first += PointPageSize)
+        pages.push_back(PointPage(first, std::min(first + PointPageSize, count)));
+    return pages;
+}
+
+void addBoundBox(Base::BoundBox3d& bnd, const Base::BoundBox3d& lbb)
+{
+    bnd.Add(lbb);
+}
+
+void addCount(PointKernel::size_type& num, const PointKernel::size_type& cnt)
+{
+    num += cnt;
+}
+}
+
 PointKernel::PointKernel(const PointKernel& pts)
   : _Mtrx(pts._Mtrx)
   , _Points(pts._Points)
@@ -84,7 +112,7 @@ Data::Segment* PointKernel::getSubElement(const char* /*Type*/, unsigned long /*
 
 void PointKernel::transformGeometry(const Base::Matrix4D &rclMat)
 {
-    std::vector<value_type>& kernel = getBasicPoints();
+    PointArray& kernel = getBasicPoints();
 #ifdef _WIN32
     // Win32-only at the moment since ppl.h is a Microsoft library. Points is not using Qt so we cannot use QtConcurrent
     // We could also rewrite Points to leverage SIMD instructions
@@ -93,8 +121,10 @@ void PointKernel::transformGeometry(const Base::Matrix4D &rclMat)
         value = rclMat * value;
     });
 #else
-    QtConcurrent::blockingMap(kernel, [rclMat](value_type& value) {
-        rclMat.multVec(value, value);
+    std::vector<PointPage> pages = makePages(kernel.size());
+    QtConcurrent::blockingMap(pages, [&kernel, &rclMat](const PointPage& page) {
+        for (size_type i = page.first; i < page.second; i++)
+            rclMat.multVec(kernel[i], kernel[i]);
     });
 #endif
 }
@@ -116,8 +146,18 @@ Base::BoundBox3d PointKernel::getBoundBox(void)const
         bnd.Add(lbb);
     });
 #else
-    for (const_point_iterator it = begin(); it != end(); ++it)
-        bnd.Add(*it);
+    // Page-wise bounding boxes combined to the final bounding box
+    std::vector<PointPage> pages = makePages(_Points.size());
+    std::function<Base::BoundBox3d(const PointPage&)> fMap = [this](const PointPage& page) {
+        Base::BoundBox3d lbb;
+        for (size_type i = page.first; i < page.second; i++) {
+            const value_type& value = _Points[i];
+            Base::Vector3d vertd(value.x, value.y, value.z);
+            lbb.Add(this->_Mtrx * vertd);
+        }
+        return lbb;
+    };
+    bnd = QtConcurrent::blockingMappedReduced(pages, fMap, addBoundBox);
 #endif
     return bnd;
 }
@@ -138,14 +178,22 @@ unsigned int PointKernel::getMemSize (void) const
 
 PointKernel::size_type PointKernel::countValid(void) const
 {
-    size_type num = 0;
-    for (const_point_iterator it = begin(); it != end(); ++it) {
-        if (!(boost::math::isnan(it->x) || 
-              boost::math::isnan(it->y) ||
-              boost::math::isnan(it->z)))
-            num++;
-    }
-    return num;
+    // check the transformed points like the iterators do, an infinite
+    // coordinate may become NaN by the transformation
+    std::vector<PointPage> pages = makePages(_Points.size());
+    std::function<size_type(const PointPage&)> fMap = [this](const PointPage& page) {
+        size_type num = 0;
+        for (size_type i = page.first; i < page.second; i++) {
+            const value_type& value = _Points[i];
+            Base::Vector3d vertd = this->_Mtrx * Base::Vector3d(value.x, value.y, value.z);
+            if (!(boost::math::isnan(vertd.x) ||
+                  boost::math::isnan(vertd.y) ||
+                  boost::math::isnan(vertd.z)))
+                num++;
+        }
+        return num;
+    };
+    return QtConcurrent::blockingMappedReduced(pages, fMap, addCount);
 }
 
 std::vector<PointKernel::value_type> PointKernel::getValidPoints() const
@@ -179,9 +227,7 @@ void PointKernel::SaveDocFile (Base::Writer &writer) const
     uint32_t uCt = (uint32_t)size();
     str << uCt;
     // store the data without transforming it
-    for (std::vector<value_type>::const_iterator it = _Points.begin(); it != _Points.end(); ++it) {
-        str << it->x << it->y << it->z;
-    }
+    str.write(reinterpret_cast<const float*>(_Points.data()), 3*_Points.size());
 }
 
 void PointKernel::Restore(Base::XMLReader &reader)
@@ -207,11 +253,7 @@ void PointKernel::RestoreDocFile(Base::Reader &reader)
     uint32_t uCt = 0;
     str >> uCt;
     _Points.resize(uCt);
-    for (unsigned long i=0; i < uCt; i++) {
-        float x, y, z;
-        str >> x >> y >> z;
-        _Points[i].Set(x,y,z);
-    }
+    str.read(reinterpret_cast<float*>(_Points.data()), 3*_Points.size());
 }
 
 void PointKernel::save(const char* file) const
@@ -228,7 +270,7 @@ void PointKernel::load(const char* file)
 void PointKernel::save(std::ostream& out) const
 {
     out << "# ASCII" << std::endl;
-    for (std::vector<value_type>::const_iterator it = _Points.begin(); it != _Points.end(); ++it) {
+    for (PointArray::const_iterator it = _Points.begin(); it != _Points.end(); ++it) {
         out << it->x << " " << it->y << " " << it->z << std::endl;
     }
 }
@@ -247,7 +289,7 @@ void PointKernel::getPoints(std::vector<Base::Vector3d> &Points,
 // ----------------------------------------------------------------------------
 
 PointKernel::const_point_iterator::const_point_iterator
-(const PointKernel* kernel, std::vector<kernel_type>::const_iterator index)
+(const PointKernel* kernel, iter_type index)
   : _kernel(kernel), _p_it(index)
 {
     if(_p_it != kernel->_Points.end())
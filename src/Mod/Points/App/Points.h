@@ -35,6 +35,8 @@
 #include <App/PropertyStandard.h>
 #include <App/PropertyGeo.h>
 
+#include "PagedStorage.h"
+
 namespace Points
 {
 
@@ -48,8 +50,10 @@ class PointsExport PointKernel : public Data::ComplexGeoData
 public:
     typedef float float_type;
     typedef Base::Vector3<float_type> value_type;
-    typedef std::vector<value_type>::difference_type difference_type;
-    typedef std::vector<value_type>::size_type size_type;
+    /// The points are kept in a PageStore, large clouds are backed by a file
+    typedef std::vector<value_type, PagedAllocator<value_type> > PointArray;
+    typedef PointArray::difference_type difference_type;
+    typedef PointArray::size_type size_type;
 
     PointKernel(void)
     {
@@ -79,13 +83,13 @@ public:
 
     inline void setTransform(const Base::Matrix4D& rclTrf){_Mtrx = rclTrf;}
     inline Base::Matrix4D getTransform(void) const{return _Mtrx;}
-    std::vector<value_type>& getBasicPoints()
+    PointArray& getBasicPoints()
     { return this->_Points; }
-    const std::vector<value_type>& getBasicPoints() const
+    const PointArray& getBasicPoints() const
     { return this->_Points; }
     void setBasicPoints(const std::vector<value_type>& pts)
-    { this->_Points = pts; }
-    void swap(std::vector<value_type>& pts)
+    { this->_Points.assign(pts.begin(), pts.end()); }
+    void swap(PointArray& pts)
     { this->_Points.swap(pts); }
 
     virtual void getPoints(std::vector<Base::Vector3d> &Points,
@@ -110,7 +114,7 @@ public:
 
 private:
     Base::Matrix4D _Mtrx;
-    std::vector<value_type> _Points;
+    PointArray _Points;
 
 public:
     /// number of points stored 
@@ -144,13 +148,13 @@ public:
     public:
         typedef PointKernel::value_type kernel_type;
         typedef Base::Vector3d value_type;
-        typedef std::vector<kernel_type>::const_iterator iter_type;
+        typedef PointArray::const_iterator iter_type;
         typedef iter_type::difference_type difference_type;
         typedef iter_type::iterator_category iterator_category;
         typedef const value_type* pointer;
         typedef const value_type& reference;
 
-        const_point_iterator(const PointKernel*, std::vector<kernel_type>::const_iterator index);
+        const_point_iterator(const PointKernel*, iter_type index);
         const_point_iterator(const const_point_iterator& pi);
         //~const_point_iterator();
 
@@ -172,7 +176,7 @@ public:
         void dereference();
         const PointKernel* _kernel;
         value_type _point;
-        std::vector<kernel_type>::const_iterator _p_it;
+        iter_type _p_it;
     };
 
     typedef const_point_iterator const_iterator;
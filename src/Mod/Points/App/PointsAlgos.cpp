@@ -1421,7 +1421,7 @@ void PlyWriter::write(const std::string& filename)
 
     std::size_t numPoints = points.size();
     std::size_t numValid = 0;
-    const std::vector<Base::Vector3f>& pts = points.getBasicPoints();
+    const PointKernel::PointArray& pts = points.getBasicPoints();
     for (std::size_t i=0; i<numPoints; i++) {
         const Base::Vector3f& p = pts[i];
         if (!boost::math::isnan(p.x) &&
@@ -1583,7 +1583,7 @@ void PcdWriter::write(const std::string& filename)
     }
 
     std::size_t numPoints = points.size();
-    const std::vector<Base::Vector3f>& pts = points.getBasicPoints();
+    const PointKernel::PointArray& pts = points.getBasicPoints();
 
     Eigen::MatrixXf data(numPoints, fields.size());
 
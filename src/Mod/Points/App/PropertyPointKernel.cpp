@@ -42,18 +42,47 @@ using namespace Points;
 TYPESYSTEM_SOURCE(Points::PropertyPointKernel , App::PropertyComplexGeoData)
 
 PropertyPointKernel::PropertyPointKernel()
-    : _cPoints(new PointKernel())
+    : _cPoints(new PointKernel()), pointsPyObject(0)
 {
 
 }
 
 PropertyPointKernel::~PropertyPointKernel()
 {
+    if (pointsPyObject)
+        Py_DECREF(pointsPyObject);
+}
+
+void PropertyPointKernel::setPointKernel(PointKernel* points)
+{
+    _cPoints = points;
+    // keep the Python wrapper in sync
+    if (pointsPyObject)
+        pointsPyObject->_pcTwinPointer = points;
+}
+
+void PropertyPointKernel::detachPoints(bool keepData)
+{
+    // The point kernel may be shared with copies of this property, e.g. the
+    // ones kept by the undo/redo stack. So, make an own copy before changing it.
+    if (_cPoints.getRefCount() > 1) {
+        PointKernel* points;
+        if (keepData) {
+            points = new PointKernel(*_cPoints);
+        }
+        else {
+            // the points will be replaced, only keep the placement
+            points = new PointKernel();
+            points->setTransform(_cPoints->getTransform());
+        }
+        setPointKernel(points);
+    }
 }
 
 void PropertyPointKernel::setValue(const PointKernel& m)
 {
     aboutToSetValue();
+    detachPoints(false);
     *_cPoints = m;
     hasSetValue();
 }
@@ -75,9 +104,13 @@ Base::BoundBox3d PropertyPointKernel::getBoundingBox() const
 
 PyObject *PropertyPointKernel::getPyObject(void)
 {
-    PointsPy* points = new PointsPy(&*_cPoints);
-    points->setConst(); // set immutable
-    return points;
+    if (!pointsPyObject) {
+        pointsPyObject = new PointsPy(&*_cPoints);
+        pointsPyObject->setConst(); // set immutable
+    }
+
+    Py_INCREF(pointsPyObject);
+    return pointsPyObject;
 }
 
 void PropertyPointKernel::setPyObject(PyObject *value)
@@ -114,6 +147,7 @@ void PropertyPointKernel::Restore(Base::XMLReader &reader)
         mtrx.fromString(Matrix);
 
         aboutToSetValue();
+        detachPoints(true);
         _cPoints->setTransform(mtrx);
         hasSetValue();
     }
@@ -128,22 +162,25 @@ void PropertyPointKernel::SaveDocFile (Base::Writer &writer) const
 void PropertyPointKernel::RestoreDocFile(Base::Reader &reader)
 {
     aboutToSetValue();
+    detachPoints(false);
     _cPoints->RestoreDocFile(reader);
     hasSetValue();
 }
 
 App::Property *PropertyPointKernel::Copy(void) const 
 {
+    // Note: Reference the same point kernel, it gets copied on modification
     PropertyPointKernel* prop = new PropertyPointKernel();
-    (*prop->_cPoints) = (*this->_cPoints);
+    prop->_cPoints = this->_cPoints;
     return prop;
 }
 
 void PropertyPointKernel::Paste(const App::Property &from)
 {
-    aboutToSetValue();
     const PropertyPointKernel& prop = dynamic_cast<const PropertyPointKernel&>(from);
-    *(this->_cPoints) = *(prop._cPoints);
+    Base::Reference<PointKernel> tmp(_cPoints);
+    aboutToSetValue();
+    setPointKernel(prop._cPoints);
     hasSetValue();
 }
 
@@ -152,9 +189,18 @@ unsigned int PropertyPointKernel::getMemSize (void) const
     return sizeof(Base::Vector3f) * this->_cPoints->size();
 }
 
+unsigned int PropertyPointKernel::getExclusiveMemSize (void) const
+{
+    // the point kernel is accounted for by the other owners
+    if (_cPoints.getRefCount() > 1)
+        return sizeof(PropertyPointKernel);
+    return getMemSize();
+}
+
 PointKernel* PropertyPointKernel::startEditing()
 {
     aboutToSetValue();
+    detachPoints(true);
     return static_cast<PointKernel*>(_cPoints);
 }
 
@@ -194,6 +240,13 @@ void PropertyPointKernel::removeIndices( const std::vector<unsigned long>& uIndi
 void PropertyPointKernel::transformGeometry(const Base::Matrix4D &rclMat)
 {
     aboutToSetValue();
+    detachPoints(true);
     _cPoints->transformGeometry(rclMat);
     hasSetValue();
 }
+
+void PropertyPointKernel::setTransform(const Base::Matrix4D &rclTrf)
+{
+    detachPoints(true);
+    _cPoints->setTransform(rclTrf);
+}
@@ -29,6 +29,8 @@
 namespace Points
 {
 
+class PointsPy;
+
 /** The point kernel property
  */
 class PointsExport PropertyPointKernel : public App::PropertyComplexGeoData
@@ -63,10 +65,12 @@ public:
     /** @name Undo/Redo */
     //@{
     /// returns a new copy of the property (mainly for Undo/Redo and transactions)
+    /// that shares the point kernel until either of them gets modified
     App::Property *Copy(void) const;
     /// paste the value from the property (mainly for Undo/Redo and transactions)
     void Paste(const App::Property &from);
     unsigned int getMemSize (void) const;
+    unsigned int getExclusiveMemSize (void) const;
     //@}
 
     /** @name Save/restore */
@@ -84,10 +88,17 @@ public:
     /// Transform the real 3d point kernel
     void transformGeometry(const Base::Matrix4D &rclMat);
     void removeIndices( const std::vector<unsigned long>& );
+    /// Set the placement of the points without notification
+    void setTransform(const Base::Matrix4D &rclTrf);
     //@}
 
+private:
+    void setPointKernel(PointKernel* points);
+    void detachPoints(bool keepData);
+
 private:
     Base::Reference<PointKernel> _cPoints;
+    PointsPy* pointsPyObject;
 };
 
 } // namespace Points
@@ -678,8 +678,8 @@ void ViewProviderPointsBuilder::createPoints(const App::Property* prop, SoCoordi
 
     // get all points
     std::size_t idx=0;
-    const std::vector<Points::PointKernel::value_type>& kernel = cPts.getBasicPoints();
-    for (std::vector<Points::PointKernel::value_type>::const_iterator it = kernel.begin(); it != kernel.end(); ++it, idx++) {
+    const Points::PointKernel::PointArray& kernel = cPts.getBasicPoints();
+    for (Points::PointKernel::PointArray::const_iterator it = kernel.begin(); it != kernel.end(); ++it, idx++) {
         vec[idx].setValue(it->x, it->y, it->z);
     }
 
@@ -699,8 +699,8 @@ void ViewProviderPointsBuilder::createPoints(const App::Property* prop, SoCoordi
     std::size_t idx=0;
     std::vector<int32_t> indices;
     indices.reserve(cPts.size());
-    const std::vector<Points::PointKernel::value_type>& kernel = cPts.getBasicPoints();
-    for (std::vector<Points::PointKernel::value_type>::const_iterator it = kernel.begin(); it != kernel.end(); ++it, idx++) {
+    const Points::PointKernel::PointArray& kernel = cPts.getBasicPoints();
+    for (Points::PointKernel::PointArray::const_iterator it = kernel.begin(); it != kernel.end(); ++it, idx++) {
         vec[idx].setValue(it->x, it->y, it->z);
         // valid point?
         if (!(boost::math::isnan(it->x) || boost::math::isnan(it->y) || boost::math::isnan(it->z))) {
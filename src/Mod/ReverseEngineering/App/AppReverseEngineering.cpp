@@ -211,7 +211,8 @@ private:
             if (PyObject_TypeCheck(o, &(Points::PointsPy::Type))) {
                 Points::PointsPy* pPoints = static_cast<Points::PointsPy*>(o);
                 Points::PointKernel* points = pPoints->getPointKernelPtr();
-                pts = points->getBasicPoints();
+                const Points::PointKernel::PointArray& kernel = points->getBasicPoints();
+                pts.assign(kernel.begin(), kernel.end());
             }
             else if (PyObject_TypeCheck(o, &(Mesh::MeshPy::Type))) {
                 const Mesh::MeshObject* mesh = static_cast<Mesh::MeshPy*>(o)->getMeshObjectPtr();
@@ -569,7 +570,8 @@ Mesh.show(m)
 
         Points::PointKernel* points = static_cast<Points::PointsPy*>(pts)->getPointKernelPtr();
 
-        BSplineFitting fit(points->getBasicPoints());
+        const Points::PointKernel::PointArray& kernel = points->getBasicPoints();
+        BSplineFitting fit(std::vector<Base::Vector3f>(kernel.begin(), kernel.end()));
         fit.setOrder(degree+1);
         fit.setRefinement(refinement);
         fit.setIterations(iterations);
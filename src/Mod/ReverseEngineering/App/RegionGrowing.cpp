@@ -108,7 +108,7 @@ void RegionGrowing::perform(const std::vector<Base::Vector3f>& myNormals)
     normals->reserve(myNormals.size());
 
     std::size_t num_points = myPoints.size();
-    const std::vector<Base::Vector3f>& points = myPoints.getBasicPoints();
+    const Points::PointKernel::PointArray& points = myPoints.getBasicPoints();
     for (std::size_t index=0; index<num_points; index++) {
         const Base::Vector3f& p = points[index];
         const Base::Vector3f& n = myNormals[index];
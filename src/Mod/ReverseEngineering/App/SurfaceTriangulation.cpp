@@ -140,7 +140,7 @@ void SurfaceTriangulation::perform(const std::vector<Base::Vector3f>& normals)
 
     cloud_with_normals->reserve(myPoints.size());
     std::size_t num_points = myPoints.size();
-    const std::vector<Base::Vector3f>& points = myPoints.getBasicPoints();
+    const Points::PointKernel::PointArray& points = myPoints.getBasicPoints();
     for (std::size_t index=0; index<num_points; index++) {
         const Base::Vector3f& p = points[index];
         const Base::Vector3f& n = normals[index];
@@ -262,7 +262,7 @@ void PoissonReconstruction::perform(const std::vector<Base::Vector3f>& normals)
 
     cloud_with_normals->reserve(myPoints.size());
     std::size_t num_points = myPoints.size();
-    const std::vector<Base::Vector3f>& points = myPoints.getBasicPoints();
+    const Points::PointKernel::PointArray& points = myPoints.getBasicPoints();
     for (std::size_t index=0; index<num_points; index++) {
         const Base::Vector3f& p = points[index];
         const Base::Vector3f& n = normals[index];
@@ -371,7 +371,7 @@ void GridReconstruction::perform(const std::vector<Base::Vector3f>& normals)
 
     cloud_with_normals->reserve(myPoints.size());
     std::size_t num_points = myPoints.size();
-    const std::vector<Base::Vector3f>& points = myPoints.getBasicPoints();
+    const Points::PointKernel::PointArray& points = myPoints.getBasicPoints();
     for (std::size_t index=0; index<num_points; index++) {
         const Base::Vector3f& p = points[index];
         const Base::Vector3f& n = normals[index];
@@ -430,7 +430,7 @@ void ImageTriangulation::perform()
     cloud_organized->height = height;
     cloud_organized->points.resize (cloud_organized->width * cloud_organized->height);
 
-    const std::vector<Base::Vector3f>& points = myPoints.getBasicPoints();
+    const Points::PointKernel::PointArray& points = myPoints.getBasicPoints();
 
     int npoints = 0;
     for (size_t i = 0; i < cloud_organized->height; i++) {
@@ -558,7 +558,7 @@ void Reen::MarchingCubesRBF::perform(const std::vector<Base::Vector3f>& normals)
 
     cloud_with_normals->reserve(myPoints.size());
     std::size_t num_points = myPoints.size();
-    const std::vector<Base::Vector3f>& points = myPoints.getBasicPoints();
+    const Points::PointKernel::PointArray& points = myPoints.getBasicPoints();
     for (std::size_t index=0; index<num_points; index++) {
         const Base::Vector3f& p = points[index];
         const Base::Vector3f& n = normals[index];
@@ -667,7 +667,7 @@ void Reen::MarchingCubesHoppe::perform(const std::vector<Base::Vector3f>& normal
 
     cloud_with_normals->reserve(myPoints.size());
     std::size_t num_points = myPoints.size();
-    const std::vector<Base::Vector3f>& points = myPoints.getBasicPoints();
+    const Points::PointKernel::PointArray& points = myPoints.getBasicPoints();
     for (std::size_t index=0; index<num_points; index++) {
         const Base::Vector3f& p = points[index];
         const Base::Vector3f& n = normals[index];
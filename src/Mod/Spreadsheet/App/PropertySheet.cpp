@@ -73,6 +73,7 @@ void PropertySheet::clear()
     cellToPropertyNameMap.clear();
     documentObjectToCellMap.clear();
     cellToDocumentObjectMap.clear();
+    cellToDependantsMap.clear();
     aliasProp.clear();
     revAliasProp.clear();
 
@@ -200,6 +201,7 @@ PropertySheet::PropertySheet(const PropertySheet &other)
     , cellToPropertyNameMap(other.cellToPropertyNameMap)
     , documentObjectToCellMap(other.documentObjectToCellMap)
     , cellToDocumentObjectMap(other.cellToDocumentObjectMap)
+    , cellToDependantsMap(other.cellToDependantsMap)
     , aliasProp(other.aliasProp)
     , revAliasProp(other.revAliasProp)
     , updateCount(other.updateCount)
@@ -988,8 +990,12 @@ void PropertySheet::addDependencies(CellAddress key)
             propertyNameToCellMap[propName].insert(key);
             cellToPropertyNameMap[key].insert(propName);
 
-            // Also an alias?
             if (docObj==owner && props.first.size()) {
+                CellAddress addr = stringToAddress(props.first.c_str(), true);
+                if (addr.isValid())
+                    cellToDependantsMap[addr.asInt()].insert(key);
+
+                // Also an alias?
                 std::map<std::string, CellAddress>::const_iterator j = revAliasProp.find(props.first);
 
                 if (j != revAliasProp.end()) {
@@ -999,6 +1005,7 @@ void PropertySheet::addDependencies(CellAddress key)
                     // Insert into maps
                     propertyNameToCellMap[propName].insert(key);
                     cellToPropertyNameMap[key].insert(propName);
+                    cellToDependantsMap[j->second.asInt()].insert(key);
                 }
             }
         }
@@ -1020,6 +1027,7 @@ void PropertySheet::removeDependencies(CellAddress key)
     std::map<CellAddress, std::set< std::string > >::iterator i1 = cellToPropertyNameMap.find(key);
 
     if (i1 != cellToPropertyNameMap.end()) {
+        std::string ownerPrefix = owner->getFullName() + ".";
         std::set< std::string >::const_iterator j = i1->second.begin();
 
         while (j != i1->second.end()) {
@@ -1028,6 +1036,19 @@ void PropertySheet::removeDependencies(CellAddress key)
             //assert(k != propertyNameToCellMap.end());
             if (k != propertyNameToCellMap.end())
                 k->second.erase(key);
+
+            // Drop the matching entry of the cell to cell map
+            if (j->size() > ownerPrefix.size() && j->compare(0, ownerPrefix.size(), ownerPrefix) == 0) {
+                CellAddress addr = stringToAddress(j->c_str() + ownerPrefix.size(), true);
+                if (addr.isValid()) {
+                    auto it = cellToDependantsMap.find(addr.asInt());
+                    if (it != cellToDependantsMap.end()) {
+                        it->second.erase(key);
+                        if (it->second.empty())
+                            cellToDependantsMap.erase(it);
+                    }
+                }
+            }
             ++j;
         }
 
@@ -1224,6 +1245,17 @@ const std::set<std::string> &PropertySheet::getDeps(CellAddress pos) const
         return empty;
 }
 
+const std::set<CellAddress> &PropertySheet::getDependants(CellAddress pos) const
+{
+    static std::set<CellAddress> empty;
+    auto i = cellToDependantsMap.find(pos.asInt());
+
+    if (i != cellToDependantsMap.end())
+        return i->second;
+    else
+        return empty;
+}
+
 void PropertySheet::recomputeDependencies(CellAddress key)
 {
     AtomicPropertyChange signaller(*this);
@@ -24,6 +24,7 @@
 #define PROPERTYSHEET_H
 
 #include <map>
+#include <unordered_map>
 #include <App/DocumentObserver.h>
 #include <App/DocumentObject.h>
 #include <App/PropertyLinks.h>
@@ -154,6 +155,8 @@ public:
 
     const std::set<std::string> &getDeps(App::CellAddress pos) const;
 
+    const std::set<App::CellAddress> &getDependants(App::CellAddress pos) const;
+
     void recomputeDependencies(App::CellAddress key);
 
     PyObject *getPyObject(void) override;
@@ -243,6 +246,13 @@ private:
     /*! DocumentObject this cell depends on */
     std::map<App::CellAddress, std::set< std::string > > cellToDocumentObjectMap;
 
+    /*! Cells of the owner sheet depending on the cell given in key (see
+      CellAddress::asInt()). This mirrors the owner's entries in
+      propertyNameToCellMap, but avoids building and looking up full property
+      names when walking the dependency graph during recompute.
+      */
+    std::unordered_map<unsigned int, std::set< App::CellAddress > > cellToDependantsMap;
+
     /*! Mapping of cell position to alias property */
     std::map<App::CellAddress, std::string> aliasProp;
 
@@ -25,6 +25,8 @@
 #ifndef _PreComp_
 #endif
 
+#include <QThread>
+#include <QtConcurrentMap>
 #include <boost/regex.hpp>
 #include <boost/tokenizer.hpp>
 #include <boost/range/adaptor/map.hpp>
@@ -38,12 +40,14 @@
 #include <App/ExpressionParser.h>
 #include <Base/Exception.h>
 #include <Base/FileInfo.h>
+#include <Base/Interpreter.h>
 #include <Base/Placement.h>
 #include <Base/Reader.h>
 #include <Base/Stream.h>
 #include <Base/Writer.h>
 #include <Base/Tools.h>
 #include <Base/Console.h>
+#include <Base/TimeInfo.h>
 #include "Sheet.h"
 #include "SheetObserver.h"
 #include "Utils.h"
@@ -54,6 +58,8 @@
 #include <iomanip>
 #include <boost/regex.hpp>
 #include <deque>
+#include <memory>
+#include <unordered_map>
 
 FC_LOG_LEVEL_INIT("Spreadsheet",true,true)
 
@@ -662,10 +668,11 @@ struct CurrentAddressLock {
   * Update the Property given by \a key. This will also eventually trigger recomputations of cells depending on \a key.
   *
   * @param key The address of the cell we want to recompute.
+  * @param value Optional result of the cell expression evaluated beforehand.
   *
   */
 
-void Sheet::updateProperty(CellAddress key)
+void Sheet::updateProperty(CellAddress key, const Expression *value)
 {
     Cell * cell = getCell(key);
 
@@ -673,7 +680,10 @@ void Sheet::updateProperty(CellAddress key)
         std::unique_ptr<Expression> output;
         const Expression * input = cell->getExpression();
 
-        if (input) {
+        if (input && value) {
+            output.reset(value->copy());
+        }
+        else if (input) {
             CurrentAddressLock lock(currentRow,currentCol,key);
             output.reset(input->eval());
         }
@@ -755,9 +765,10 @@ void Sheet::touchCells(Range range) {
 /**
  * @brief Recompute cell at address \a p.
  * @param p Address of cell.
+ * @param value Optional result of the cell expression evaluated beforehand.
  */
 
-void Sheet::recomputeCell(CellAddress p)
+void Sheet::recomputeCell(CellAddress p, const Expression *value)
 {
     Cell * cell = cells.getValue(p);
 
@@ -768,7 +779,7 @@ void Sheet::recomputeCell(CellAddress p)
             cell->setContent(content.c_str());
         }
 
-        updateProperty(p);
+        updateProperty(p, value);
 
         if(!cell || !cell->hasException()) {
             cells.clearDirty(p);
@@ -798,6 +809,82 @@ void Sheet::recomputeCell(CellAddress p)
         cellSpanChanged(p);
 }
 
+namespace {
+
+// Minimum number of cells in a dependency level to evaluate them concurrently
+const std::size_t ConcurrentCellThreshold = 64;
+
+struct CellEvaluation {
+    CellEvaluation(CellAddress addr, const Expression *expr)
+        : address(addr), expression(expr)
+    {}
+
+    CellAddress address;
+    const Expression *expression;
+    Expression::NativeValue value;
+    bool valid = false;
+};
+
+}
+
+/**
+ * @brief Recompute a group of cells that do not depend on each other.
+ *
+ * If the group is large enough, the cell expressions that can be evaluated
+ * without Python (see App::Expression::getNativeValue()) are evaluated
+ * concurrently first. Their property bindings are resolved on the calling
+ * thread beforehand, and the GIL is released while the workers run. The cell
+ * properties are then updated in order on the calling thread, falling back to
+ * a normal evaluation for the other cells.
+ *
+ * @param addresses Sorted addresses of the cells.
+ */
+
+void Sheet::recomputeCells(const std::vector<CellAddress> &addresses)
+{
+    std::vector<CellEvaluation> evaluations;
+
+    if (addresses.size() >= ConcurrentCellThreshold && QThread::idealThreadCount() > 1) {
+        evaluations.reserve(addresses.size());
+        for (auto &addr : addresses) {
+            Cell * cell = cells.getValue(addr);
+            if (cell && !cell->hasException() && cell->getExpression()) {
+                cell->getExpression()->resolveBindings();
+                evaluations.emplace_back(addr, cell->getExpression());
+            }
+        }
+
+        // Python may be calling the recompute, don't let the workers wait for it
+        std::unique_ptr<Base::PyGILStateRelease> unlock;
+        if (Py_IsInitialized() && PyGILState_Check())
+            unlock.reset(new Base::PyGILStateRelease);
+        QtConcurrent::blockingMap(evaluations, [](CellEvaluation &evaluation) {
+            try {
+                evaluation.valid = evaluation.expression->getNativeValue(evaluation.value);
+            }
+            catch (...) {
+                // Let recomputeCell() evaluate it again and report the error
+                evaluation.valid = false;
+            }
+        });
+    }
+
+    auto it = evaluations.begin();
+    for (auto &addr : addresses) {
+        FC_LOG(addr.toString());
+        if (it != evaluations.end() && it->address == addr) {
+            const CellEvaluation &evaluation = *it++;
+            if (evaluation.valid) {
+                std::unique_ptr<Expression> value(evaluation.value.toExpression(this));
+                recomputeCell(addr, value.get());
+                ++recomputeStatistics.concurrent;
+                continue;
+            }
+        }
+        recomputeCell(addr);
+    }
+}
+
 /**
   * Update the document properties.
   *
@@ -817,54 +904,83 @@ DocumentObjectExecReturn *Sheet::execute(void)
          dirtyCells.insert(*i);
     }
 
-    DependencyList graph;
-    std::map<CellAddress, Vertex> VertexList;
-    std::map<Vertex, CellAddress> VertexIndexList;
+    // Collect all cells affected by the dirty cells, with the number of
+    // affected cells each of them depends on
+    struct CellNode {
+        CellAddress address;
+        int inputs = 0;
+        std::vector<CellAddress> dependants;
+    };
+    std::unordered_map<unsigned int, CellNode> nodes;
+    for(auto &addr : dirtyCells)
+        nodes[addr.asInt()].address = addr;
+
     std::deque<CellAddress> workQueue(dirtyCells.begin(),dirtyCells.end());
     while(workQueue.size()) {
         CellAddress currPos = workQueue.front();
         workQueue.pop_front();
 
-        // Insert into map of CellPos -> Index, if it doesn't exist already
-        auto res = VertexList.emplace(currPos,Vertex());
-        if(res.second) {
-            res.first->second = add_vertex(graph);
-            VertexIndexList[res.first->second] = currPos;
+        // Process cells that depend on the current cell
+        const auto &deps = cells.getDependants(currPos);
+        nodes[currPos.asInt()].dependants.assign(deps.begin(), deps.end());
+        for(auto &dep : deps) {
+            CellNode &node = nodes[dep.asInt()];
+            if(dirtyCells.insert(dep).second) {
+                node.address = dep;
+                workQueue.push_back(dep);
+            }
+            ++node.inputs;
         }
+    }
 
-        // Process cells that depend on the current cell
-        for(auto &dep : providesTo(currPos)) {
-            auto resDep = VertexList.emplace(dep,Vertex());
-            if(resDep.second) {
-                resDep.first->second = add_vertex(graph);
-                VertexIndexList[resDep.first->second] = dep;
-                if(dirtyCells.insert(dep).second)
-                    workQueue.push_back(dep);
+    // Sort the cells into levels, where each level only depends on the
+    // previous ones, so the cells of a level can be evaluated independently
+    std::vector<std::vector<CellAddress> > levels;
+    std::vector<CellAddress> level;
+    std::size_t count = 0;
+    for(auto &v : nodes) {
+        if(v.second.inputs == 0)
+            level.push_back(v.second.address);
+    }
+    while(level.size()) {
+        std::sort(level.begin(), level.end());
+        count += level.size();
+
+        std::vector<CellAddress> next;
+        for(auto &addr : level) {
+            for(auto &dep : nodes[addr.asInt()].dependants) {
+                if(--nodes[dep.asInt()].inputs == 0)
+                    next.push_back(dep);
             }
-            // Add edge to graph to signal dependency
-            add_edge(res.first->second, resDep.first->second, graph);
         }
+        levels.push_back(std::move(level));
+        level.swap(next);
     }
-    // Compute cells
-    std::list<Vertex> make_order;
-    // Sort graph topologically to find evaluation order
-    try {
-        boost::topological_sort(graph, std::front_inserter(make_order));
+
+    recomputeStatistics = RecomputeStatistics();
+    if(count == nodes.size()) {
         // Recompute cells
         FC_LOG("recomputing " << getFullName());
-        for(auto &pos : make_order) {
-            const auto &addr = VertexIndexList[pos];
-            FC_LOG(addr.toString());
-            recomputeCell(addr);
+        Base::TimeInfo start;
+        for(auto &cellLevel : levels) {
+            recomputeCells(cellLevel);
+            recomputeStatistics.cells += (int)cellLevel.size();
+            ++recomputeStatistics.levels;
         }
-    } catch (std::exception &) {
-        for(auto &v : VertexList) {
-            Cell * cell = cells.getValue(v.first);
+        recomputeStatistics.time = Base::TimeInfo::diffTimeF(start);
+        FC_LOG("recomputed " << recomputeStatistics.cells << " cells in "
+                << recomputeStatistics.levels << " levels, "
+                << recomputeStatistics.concurrent << " concurrently, "
+                << recomputeStatistics.time << " s");
+    } else {
+        // Not all cells could be sorted, i.e. there is a cycle
+        for(auto &v : nodes) {
+            Cell * cell = cells.getValue(v.second.address);
             // Mark as erroneous
             if(cell)  {
-                cellErrors.insert(v.first);
+                cellErrors.insert(v.second.address);
                 cell->setException("Pending computation due to cyclic dependency",true);
-                cellUpdated(v.first);
+                cellUpdated(v.second.address);
             }
         }
 
@@ -1368,7 +1484,7 @@ void Sheet::providesTo(CellAddress address, std::set<std::string> & result) cons
 
 std::set<CellAddress>  Sheet::providesTo(CellAddress address) const
 {
-    return cells.getDeps(getFullName()+"."+address.toString());
+    return cells.getDependants(address);
 }
 
 void Sheet::onDocumentRestored()
@@ -175,6 +175,16 @@ public:
 
     void touchCells(App::Range range);
 
+    /// Figures of the last cell recompute done by execute()
+    struct RecomputeStatistics {
+        double time = 0.0;      /**< Duration in seconds */
+        int cells = 0;          /**< Number of recomputed cells */
+        int levels = 0;         /**< Number of dependency levels */
+        int concurrent = 0;     /**< Number of cells evaluated concurrently */
+    };
+
+    const RecomputeStatistics &getRecomputeStatistics() const { return recomputeStatistics; }
+
     // Signals
 
     boost::signals2::signal<void (App::CellAddress)> cellUpdated;
@@ -197,7 +207,9 @@ protected:
 
     void onDocumentRestored();
 
-    void recomputeCell(App::CellAddress p);
+    void recomputeCell(App::CellAddress p, const App::Expression *value = 0);
+
+    void recomputeCells(const std::vector<App::CellAddress> &addresses);
 
     App::Property *getProperty(App::CellAddress key) const;
 
@@ -205,7 +217,7 @@ protected:
 
     void updateAlias(App::CellAddress key);
 
-    void updateProperty(App::CellAddress key);
+    void updateProperty(App::CellAddress key, const App::Expression *value = 0);
 
     App::Property *setStringProperty(App::CellAddress key, const std::string & value) ;
 
@@ -253,6 +265,8 @@ protected:
     int currentRow = -1;
     int currentCol = -1;
 
+    RecomputeStatistics recomputeStatistics;
+
     friend class SheetObserver;
 
     friend class PropertySheet;
@@ -963,6 +963,21 @@ PyObject* SheetPy::getRowHeight(PyObject *args)
     }
 }
 
+PyObject* SheetPy::getRecomputeStatistics(PyObject *args)
+{
+    if (!PyArg_ParseTuple(args, ""))
+        return 0;
+
+    const Sheet::RecomputeStatistics &stats = getSheetPtr()->getRecomputeStatistics();
+
+    Py::Dict dict;
+    dict.setItem("Time", Py::Float(stats.time));
+    dict.setItem("Cells", Py::Long(stats.cells));
+    dict.setItem("Levels", Py::Long(stats.levels));
+    dict.setItem("Concurrent", Py::Long(stats.concurrent));
+    return Py::new_reference_to(dict);
+}
+
 // +++ custom attributes implementer ++++++++++++++++++++++++++++++++++++++++
 
 PyObject *SheetPy::getCustomAttributes(const char* attr) const
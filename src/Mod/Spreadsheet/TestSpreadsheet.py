@@ -1017,6 +1017,71 @@ class SpreadsheetCases(unittest.TestCase):
         self.doc.recompute()
         self.assertEqual(sheet.get('C1'), Units.Quantity('3 mm'))
 
+    def testRecomputeLevelsFeaturePython(self):
+        """ Cells bound to a FeaturePython object are evaluated concurrently while Python runs the recompute """
+        class Proxy:
+            def __init__(self, obj):
+                obj.Proxy = self
+                obj.addProperty('App::PropertyFloat', 'Value')
+                obj.addProperty('App::PropertyInteger', 'Count')
+            def execute(self, obj):
+                obj.Count = obj.Count + 1
+
+        feature = self.doc.addObject('App::FeaturePython', 'Feature')
+        Proxy(feature)
+        feature.Value = 2.5
+        sheet = self.doc.addObject('Spreadsheet::Sheet','Spreadsheet')
+        for i in range(1, 101):
+            sheet.set('A{}'.format(i), '=Feature.Value * {}'.format(i))
+        sheet.set('B1', '=sum(A1:A100)')
+        self.doc.recompute()
+        self.assertEqual(feature.Count, 1)
+        for i in range(1, 101):
+            self.assertAlmostEqual(sheet.get('A{}'.format(i)), 2.5 * i)
+        self.assertAlmostEqual(sheet.get('B1'), 2.5 * 5050)
+        stats = sheet.getRecomputeStatistics()
+        self.assertEqual(stats['Cells'], 101)
+        self.assertEqual(stats['Levels'], 2)
+
+        feature.Value = 4
+        self.doc.recompute()
+        self.assertEqual(feature.Count, 2)
+        self.assertAlmostEqual(sheet.get('A100'), 400)
+        self.assertAlmostEqual(sheet.get('B1'), 4 * 5050)
+
+    def testRecomputeLevels(self):
+        """ Cells are recomputed level by level, many independent cells concurrently """
+        sheet = self.doc.addObject('Spreadsheet::Sheet','Spreadsheet')
+        sheet.set('A1', '1')
+        for i in range(2, 11):
+            sheet.set('A{}'.format(i), '=A{} + 1'.format(i - 1))
+        for i in range(1, 101):
+            sheet.set('B{}'.format(i), '=A1 * {}'.format(i))
+        self.doc.recompute()
+        for i in range(1, 11):
+            self.assertEqual(sheet.get('A{}'.format(i)), i)
+        for i in range(1, 101):
+            self.assertEqual(sheet.get('B{}'.format(i)), i)
+        stats = sheet.getRecomputeStatistics()
+        self.assertEqual(stats['Cells'], 110)
+        self.assertEqual(stats['Levels'], 10)
+        self.assertLessEqual(stats['Concurrent'], stats['Cells'])
+
+        # a chain change is propagated through all levels
+        sheet.set('A1', '2')
+        self.doc.recompute()
+        self.assertEqual(sheet.get('A10'), 11)
+        self.assertEqual(sheet.get('B100'), 200)
+
+        # with a cycle nothing is recomputed and the statistics are reset
+        sheet.set('A1', '=A10')
+        self.doc.recompute()
+        self.assertTrue(sheet.A10.startswith(u'ERR: Cyclic dependency'))
+        stats = sheet.getRecomputeStatistics()
+        self.assertEqual(stats['Cells'], 0)
+        self.assertEqual(stats['Levels'], 0)
+        self.assertEqual(stats['Concurrent'], 0)
+
 
     def tearDown(self):
         #closing doc
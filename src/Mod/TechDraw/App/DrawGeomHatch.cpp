@@ -30,6 +30,7 @@
 
 # include <QFile>
 # include <QFileInfo>
+# include <QtConcurrentMap>
 
 #include <gp_Pln.hxx>
 #include <gp_Pnt.hxx>
@@ -37,7 +38,9 @@
 #include <BRepBndLib.hxx>
 #include <BRep_Builder.hxx>
 
-#include <BRepAlgoAPI_Common.hxx>
+#include <BRepAdaptor_Curve.hxx>
+#include <BRep_Tool.hxx>
+#include <GCPnts_TangentialDeflection.hxx>
 #include <BRepBuilderAPI_MakeVertex.hxx>
 #include <BRepBuilderAPI_MakeEdge.hxx>
 #include <BRepBuilderAPI_MakeWire.hxx>
@@ -57,6 +60,7 @@
 #include <Precision.hxx>
 
 #include <cmath>
+#include <algorithm>
 
 #endif
 
@@ -105,6 +109,8 @@ DrawGeomHatch::DrawGeomHatch(void)
 
     m_saveFile = "";
     m_saveName = "";
+    m_trimmedGeneration = 0;
+    m_trimmedScale = 0.0;
 
 //    getParameters();
 
@@ -159,6 +165,7 @@ short DrawGeomHatch::mustExecute() const
 App::DocumentObjectExecReturn *DrawGeomHatch::execute(void)
 {
 //    Base::Console().Message("DGH::execute()\n");
+    clearTrimmedLines();
     makeLineSets();
     DrawViewPart* parent = getSourceView();
     if (parent != nullptr) {
@@ -228,7 +235,29 @@ std::vector<LineSet>  DrawGeomHatch::getTrimmedLines(int i)   //get the trimmed
         Base::Console().Log("DGH::getTrimmedLines - no source geometry\n");
         return result;
     }
-    return getTrimmedLines(source, m_lineSets,i, ScalePattern.getValue());
+
+    //the source changes its geometry generation each time it is projected
+    double scale = ScalePattern.getValue();
+    if ((m_trimmedGeneration != source->getGeometryGeneration()) ||
+        (m_trimmedScale != scale)) {
+        clearTrimmedLines();
+        m_trimmedGeneration = source->getGeometryGeneration();
+        m_trimmedScale = scale;
+    }
+
+    auto it = m_trimmedLines.find(i);
+    if (it != m_trimmedLines.end()) {
+        return it->second;
+    }
+    result = getTrimmedLines(source, m_lineSets,i, scale);
+    m_trimmedLines[i] = result;
+    return result;
+}
+
+void DrawGeomHatch::clearTrimmedLines(void)
+{
+    m_trimmedLines.clear();
+    m_trimmedGeneration = 0;
 }
 
 /* static */
@@ -258,6 +287,148 @@ std::vector<LineSet> DrawGeomHatch::getTrimmedLines(DrawViewPart* source, std::v
     return result;
 }
 
+namespace {
+
+//a straight piece of the face boundary
+struct BoundarySegment {
+    double x1, y1;
+    double x2, y2;
+};
+
+//the parallel lines of one PATLineSpec. Line k holds the points p with
+//  normal.p == offset + k * spacing
+//and runs along dir.
+struct HatchFamily {
+    double dirX, dirY;
+    double normalX, normalY;
+    double offset;
+    double spacing;
+};
+
+//a run of consecutive lines of one family, clipped in one go
+struct ClipJob {
+    const HatchFamily* family;
+    int first;
+    int last;
+    std::vector<std::pair<Base::Vector3d, Base::Vector3d> > segments;
+};
+
+const int LinesPerJob = 256;
+const double MaxLines = 1.0e6;
+
+//! approximate the face outline by straight segments
+std::vector<BoundarySegment> polygonizeFace(const TopoDS_Face& face, double deflection)
+{
+    std::vector<BoundarySegment> result;
+    for (TopExp_Explorer expl(face, TopAbs_EDGE); expl.More(); expl.Next()) {
+        const TopoDS_Edge& edge = TopoDS::Edge(expl.Current());
+        if (BRep_Tool::Degenerated(edge)) {
+            continue;
+        }
+        BRepAdaptor_Curve adapt(edge);
+        std::vector<gp_Pnt> points;
+        if (adapt.GetType() == GeomAbs_Line) {
+            points.push_back(adapt.Value(adapt.FirstParameter()));
+            points.push_back(adapt.Value(adapt.LastParameter()));
+        } else {
+            GCPnts_TangentialDeflection discretizer(adapt, 0.1, deflection);
+            for (int i = 1; i <= discretizer.NbPoints(); i++) {
+                points.push_back(discretizer.Value(i));
+            }
+        }
+        if (points.size() < 2) {
+            continue;
+        }
+        //use the vertices at the ends so that neighbouring edges meet exactly,
+        //otherwise a hatch line through a corner could be counted once or thrice
+        TopoDS_Vertex v1 = TopExp::FirstVertex(edge);
+        TopoDS_Vertex v2 = TopExp::LastVertex(edge);
+        if (!v1.IsNull()) {
+            points.front() = BRep_Tool::Pnt(v1);
+        }
+        if (!v2.IsNull()) {
+            points.back() = BRep_Tool::Pnt(v2);
+        }
+        for (size_t i = 1; i < points.size(); i++) {
+            BoundarySegment seg = { points[i-1].X(), points[i-1].Y(),
+                                    points[i].X(), points[i].Y() };
+            result.push_back(seg);
+        }
+    }
+    return result;
+}
+
+//! describe the lines of a PATLineSpec in face coordinates
+HatchFamily makeFamily(PATLineSpec& hl, double scale)
+{
+    HatchFamily result;
+    double angle = hl.getAngle() * M_PI / 180.0;
+    result.dirX = cos(angle);
+    result.dirY = sin(angle);
+    //the lines run upwards, or to the right if they are horizontal, the same
+    //direction as the former overlay edges. getUnitDir() and the dash start
+    //calculations depend on it.
+    if ((result.dirY < -Precision::Confusion()) ||
+        ((fabs(result.dirY) <= Precision::Confusion()) && (result.dirX < 0.0))) {
+        result.dirX = -result.dirX;
+        result.dirY = -result.dirY;
+    }
+    result.normalX = -result.dirY;
+    result.normalY = result.dirX;
+    Base::Vector3d origin = hl.getOrigin();
+    result.offset = result.normalX * origin.x + result.normalY * origin.y;
+    result.spacing = fabs(hl.getInterval() * scale);
+    return result;
+}
+
+//! intersect the lines of the job with the boundary and keep the inside parts
+void clipLines(ClipJob& job, const std::vector<BoundarySegment>& boundary)
+{
+    const HatchFamily& family = *job.family;
+    std::vector<std::vector<double> > crossings(job.last - job.first + 1);
+
+    for (auto& seg: boundary) {
+        double c1 = family.normalX * seg.x1 + family.normalY * seg.y1 - family.offset;
+        double c2 = family.normalX * seg.x2 + family.normalY * seg.y2 - family.offset;
+        if (c1 == c2) {
+            continue;           //parallel to the hatch lines
+        }
+        //each segment covers [low, high) so that a line through a vertex is counted once
+        double low = std::min(c1, c2) / family.spacing;
+        double high = std::max(c1, c2) / family.spacing;
+        int kFirst = std::max(job.first, int(ceil(low)));
+        int kLast = std::min(job.last, int(ceil(high)) - 1);
+        for (int k = kFirst; k <= kLast; k++) {
+            double t = (k * family.spacing - c1) / (c2 - c1);
+            double x = seg.x1 + t * (seg.x2 - seg.x1);
+            double y = seg.y1 + t * (seg.y2 - seg.y1);
+            crossings[k - job.first].push_back(family.dirX * x + family.dirY * y);
+        }
+    }
+
+    for (size_t i = 0; i < crossings.size(); i++) {
+        std::vector<double>& along = crossings[i];
+        if (along.size() < 2) {
+            continue;
+        }
+        std::sort(along.begin(), along.end());
+        double c = family.offset + (job.first + int(i)) * family.spacing;
+        Base::Vector3d base(c * family.normalX, c * family.normalY, 0.0);
+        Base::Vector3d dir(family.dirX, family.dirY, 0.0);
+        for (size_t j = 0; j + 1 < along.size(); j += 2) {
+            if (along[j + 1] - along[j] <= Precision::Confusion()) {
+                continue;
+            }
+            job.segments.emplace_back(base + dir * along[j], base + dir * along[j + 1]);
+        }
+    }
+}
+
+} //end anonymous namespace
+
+//! clip the lines of each LineSet to the face. The face outline is approximated by
+//! straight segments and each line is cut at its crossings with the outline, pairing
+//! the crossings in order (even-odd rule). The lines are clipped in parallel.
 std::vector<LineSet> DrawGeomHatch::getTrimmedLines(DrawViewPart* source,
                                                     std::vector<LineSet> lineSets,
                                                     TopoDS_Face f,
@@ -271,64 +442,79 @@ std::vector<LineSet> DrawGeomHatch::getTrimmedLines(DrawViewPart* source,
         return result;
     }
 
-    TopoDS_Face face = f;
+    if (f.IsNull()) {
+        Base::Console().Log("INFO - DGH::getTrimmedLines - face is NULL\n");
+        return result;
+    }
 
     Bnd_Box bBox;
-    BRepBndLib::Add(face, bBox);
+    BRepBndLib::Add(f, bBox);
     bBox.SetGap(0.0);
+    if (bBox.IsVoid()) {
+        return result;
+    }
+    double deflection = std::max(sqrt(bBox.SquareExtent()) * 1.0e-4, Precision::Confusion());
+    std::vector<BoundarySegment> boundary = polygonizeFace(f, deflection);
 
+    std::vector<HatchFamily> families;
+    families.reserve(lineSets.size());
     for (auto& ls: lineSets) {
         PATLineSpec hl = ls.getPATLineSpec();
-        std::vector<TopoDS_Edge> candidates = DrawGeomHatch::makeEdgeOverlay(hl, bBox, scale);   //completely cover face bbox with lines
-
-        //make Compound for this linespec
-        BRep_Builder builder;
-        TopoDS_Compound grid;
-        builder.MakeCompound(grid);
-        for (auto& c: candidates) {
-           builder.Add(grid, c);
-        }
+        families.push_back(makeFamily(hl, scale));
+    }
 
-        //Common(Compound,Face)
-        BRepAlgoAPI_Common mkCommon(face, grid);
-        if ((!mkCommon.IsDone())  ||
-            (mkCommon.Shape().IsNull()) ) {
-            Base::Console().Log("INFO - DGH::getTrimmedLines - Common creation failed\n");
-            return result;
+    //split each family into runs of lines covering the face
+    std::vector<ClipJob> jobs;
+    for (auto& family: families) {
+        if (family.spacing <= Precision::Confusion() || boundary.empty()) {
+            continue;
         }
-        TopoDS_Shape common = mkCommon.Shape();
-
-        //save the boundingBox of hatch pattern
-        Bnd_Box overlayBox;
-        overlayBox.SetGap(0.0);
-        BRepBndLib::Add(common, overlayBox);
-        ls.setBBox(overlayBox);
-
-        //get resulting edges
-        std::vector<TopoDS_Edge> resultEdges;
-        TopTools_IndexedMapOfShape mapOfEdges;
-        TopExp::MapShapes(common, TopAbs_EDGE, mapOfEdges);
-        for ( int i = 1 ; i <= mapOfEdges.Extent() ; i++ ) {           //remember, TopExp makes no promises about the order it finds edges
-            const TopoDS_Edge& edge = TopoDS::Edge(mapOfEdges(i));
-            if (edge.IsNull()) {
-                Base::Console().Log("INFO - DGH::getTrimmedLines - edge: %d is NULL\n",i);
-                continue;
-            }
-            resultEdges.push_back(edge);
+        double cMin = std::numeric_limits<double>::max();
+        double cMax = -std::numeric_limits<double>::max();
+        for (auto& seg: boundary) {
+            double c = family.normalX * seg.x1 + family.normalY * seg.y1 - family.offset;
+            cMin = std::min(cMin, c);
+            cMax = std::max(cMax, c);
+        }
+        if ((cMax - cMin) / family.spacing > MaxLines) {
+            Base::Console().Warning("DGH::getTrimmedLines - hatch pattern too fine for face, skipped\n");
+            continue;
         }
+        int first = int(ceil(cMin / family.spacing));
+        int last = int(floor(cMax / family.spacing));
+        for (int k = first; k <= last; k += LinesPerJob) {
+            ClipJob job;
+            job.family = &family;
+            job.first = k;
+            job.last = std::min(last, k + LinesPerJob - 1);
+            jobs.push_back(job);
+        }
+    }
 
+    QtConcurrent::blockingMap(jobs, [&boundary](ClipJob& job) {
+        clipLines(job, boundary);
+    });
+
+    auto itJob = jobs.begin();
+    for (size_t i = 0; i < lineSets.size(); i++) {
+        LineSet& ls = lineSets[i];
         std::vector<TechDraw::BaseGeom*> resultGeoms;
-        int i = 0;
-        for (auto& e: resultEdges) {
-            TechDraw::BaseGeom* base = BaseGeom::baseFactory(e);
-            if (base == nullptr) {
-                Base::Console().Log("FAIL - DGH::getTrimmedLines - baseFactory failed for edge: %d\n",i);
-                throw Base::ValueError("DGH::getTrimmedLines - baseFactory failed");
+        Bnd_Box overlayBox;
+        overlayBox.SetGap(0.0);
+        for (; (itJob != jobs.end()) && (itJob->family == &families[i]); ++itJob) {
+            for (auto& seg: itJob->segments) {
+                //no OCC edge here, LineSet::getEdges() makes them if asked
+                TechDraw::Generic* line = new TechDraw::Generic();
+                line->points.push_back(seg.first);
+                line->points.push_back(seg.second);
+                resultGeoms.push_back(line);
+                overlayBox.Add(gp_Pnt(seg.first.x, seg.first.y, 0.0));
+                overlayBox.Add(gp_Pnt(seg.second.x, seg.second.y, 0.0));
             }
-            resultGeoms.push_back(base);
-            i++;
         }
-        ls.setEdges(resultEdges);
+        //save the boundingBox of hatch pattern
+        ls.setBBox(overlayBox);
+        ls.setEdges(std::vector<TopoDS_Edge>());
         ls.setGeoms(resultGeoms);
         result.push_back(ls);
     }
@@ -29,6 +29,8 @@
 #include <App/PropertyLinks.h>
 #include <App/PropertyFile.h>
 
+#include <map>
+
 class TopoDS_Edge;
 class TopoDS_Face;
 class Bnd_Box;
@@ -107,9 +109,16 @@ protected:
     std::string m_saveFile;
     std::string m_saveName;
 
+    void clearTrimmedLines(void);
+
 private:
     static App::PropertyFloatConstraint::Constraints scaleRange;
 
+    //trimmed lines per face, valid for the current pattern and source geometry
+    std::map<int, std::vector<LineSet> > m_trimmedLines;
+    unsigned long m_trimmedGeneration;
+    double m_trimmedScale;
+
 };
 
 typedef App::FeaturePythonT<DrawGeomHatch> DrawGeomHatchPython;
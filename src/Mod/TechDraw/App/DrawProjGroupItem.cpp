@@ -167,6 +167,15 @@ void DrawProjGroupItem::autoPosition()
     }
 }
 
+//! the position of an item depends on the size of its neighbours
+void DrawProjGroupItem::postProjection()
+{
+    auto pgroup = getPGroup();
+    if (pgroup != nullptr) {
+        pgroup->autoPositionChildren();
+    }
+}
+
 void DrawProjGroupItem::onDocumentRestored()
 {
 //    Base::Console().Message("DPGI::onDocumentRestored() - %s\n", getNameInDocument());
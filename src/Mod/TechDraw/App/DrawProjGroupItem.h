@@ -93,6 +93,7 @@ protected:
     void onChanged(const App::Property* prop) override;
     virtual bool isLocked(void) const override;
     virtual bool showLock(void) const override;
+    virtual void postProjection(void) override;
 
 private:
     static const char* TypeEnums[];
@@ -60,11 +60,14 @@
 #include <TopExp_Explorer.hxx>
 #include <TopTools_IndexedMapOfShape.hxx>
 
+#include <QtConcurrentMap>
+
 #endif
 
 #include <limits>
 #include <algorithm>
 #include <cmath>
+#include <unordered_map>
 #include <GeomLib_Tool.hxx>
 
 #include <App/Application.h>
@@ -170,63 +173,7 @@ std::vector<TopoDS_Edge> DrawProjectSplit::getEdges(TechDraw::GeometryObject* ge
 
     //HLR algo does not provide all edge intersections for edge endpoints.
     //need to split long edges touched by Vertex of another edge
-    std::vector<splitPoint> splits;
-    std::vector<TopoDS_Edge>::iterator itOuter = origEdges.begin();
-    int iOuter = 0;
-    for (; itOuter != origEdges.end(); ++itOuter, iOuter++) {
-        TopoDS_Vertex v1 = TopExp::FirstVertex((*itOuter));
-        TopoDS_Vertex v2 = TopExp::LastVertex((*itOuter));
-        Bnd_Box sOuter;
-        BRepBndLib::Add(*itOuter, sOuter);
-        sOuter.SetGap(0.1);
-        if (sOuter.IsVoid()) {
-            Base::Console().Message("DPS::Extract Faces - outer Bnd_Box is void\n");
-            continue;
-        }
-        if (DrawUtil::isZeroEdge(*itOuter)) {
-            Base::Console().Message("DPS::extractFaces - outerEdge: %d is ZeroEdge\n",iOuter);   //this is not finding ZeroEdges
-            continue;  //skip zero length edges. shouldn't happen ;)
-        }
-        int iInner = 0;
-        std::vector<TopoDS_Edge>::iterator itInner = faceEdges.begin();
-        for (; itInner != faceEdges.end(); ++itInner,iInner++) {
-            if (iInner == iOuter) {
-                continue;
-            }
-            if (DrawUtil::isZeroEdge((*itInner))) {
-                continue;  //skip zero length edges. shouldn't happen ;)
-            }
-
-            Bnd_Box sInner;
-            BRepBndLib::Add(*itInner, sInner);
-            sInner.SetGap(0.1);
-            if (sInner.IsVoid()) {
-                Base::Console().Log("INFO - DPS::Extract Faces - inner Bnd_Box is void\n");
-                continue;
-            }
-            if (sOuter.IsOut(sInner)) {      //bboxes of edges don't intersect, don't bother
-                continue;
-            }
-
-            double param = -1;
-            if (isOnEdge((*itInner),v1,param,false)) {
-                gp_Pnt pnt1 = BRep_Tool::Pnt(v1);
-                splitPoint s1;
-                s1.i = iInner;
-                s1.v = Base::Vector3d(pnt1.X(),pnt1.Y(),pnt1.Z());
-                s1.param = param;
-                splits.push_back(s1);
-            }
-            if (isOnEdge((*itInner),v2,param,false)) {
-                gp_Pnt pnt2 = BRep_Tool::Pnt(v2);
-                splitPoint s2;
-                s2.i = iInner;
-                s2.v = Base::Vector3d(pnt2.X(),pnt2.Y(),pnt2.Z());
-                s2.param = param;
-                splits.push_back(s2);
-            }
-        } //inner loop
-    }   //outer loop
+    std::vector<splitPoint> splits = findSplits(origEdges);
 
     std::vector<splitPoint> sorted = sortSplits(splits,true);
     auto last = std::unique(sorted.begin(), sorted.end(), DrawProjectSplit::splitEqual);  //duplicates to back
@@ -241,12 +188,137 @@ std::vector<TopoDS_Edge> DrawProjectSplit::getEdges(TechDraw::GeometryObject* ge
 }
 
 
+namespace {
+
+//! the part of isOnEdge after the bounding box test
+bool isOnCurve(const TopoDS_Edge& e, const TopoDS_Vertex& v, double& param, bool allowEnds)
+{
+    bool result = false;
+    double dist = DrawUtil::simpleMinDist(v,e);
+    if (dist < 0.0) {
+        Base::Console().Error("DPS::isOnEdge - simpleMinDist failed: %.3f\n",dist);
+        result = false;
+    } else if (dist < Precision::Confusion()) {
+        const gp_Pnt pt = BRep_Tool::Pnt(v);                         //have to duplicate method 3 to get param
+        BRepAdaptor_Curve adapt(e);
+        const Handle(Geom_Curve) c = adapt.Curve().Curve();
+        double maxDist = 0.000001;     //magic number.  less than this gives false positives.
+        //bool found =
+        (void) GeomLib_Tool::Parameter(c,pt,maxDist,param);  //already know point it on curve
+        result = true;
+    }
+    if (result) {
+        TopoDS_Vertex v1 = TopExp::FirstVertex(e);
+        TopoDS_Vertex v2 = TopExp::LastVertex(e);
+        if (DrawUtil::isSamePoint(v,v1) || DrawUtil::isSamePoint(v,v2)) {
+            if (!allowEnds) {
+                result = false;
+            }
+        }
+    }
+    return result;
+}
+
+//! what findSplits needs to know about an edge, computed once per edge
+struct SplitEdge {
+    Bnd_Box box;
+    TopoDS_Vertex v1;
+    TopoDS_Vertex v2;
+    gp_Pnt p1;
+    gp_Pnt p2;
+    bool usable;
+};
+
+//! uniform grid over the xy extent of the edge boxes. Each cell lists the
+//! edges whose box overlaps it.
+class EdgeGrid
+{
+public:
+    EdgeGrid(const std::vector<SplitEdge>& edges);
+
+    //! returns the edges whose box may contain pt
+    const std::vector<int>& candidates(const gp_Pnt& pt) const;
+
+private:
+    int cellX(double x) const;
+    int cellY(double y) const;
+
+    static const int MaxCells = 1024;       //per axis
+    double xMin, yMin;
+    double cellSize;
+    int nx, ny;
+    std::vector<std::vector<int> > cells;
+    std::vector<int> none;
+};
+
+EdgeGrid::EdgeGrid(const std::vector<SplitEdge>& edges)
+  : xMin(0.0), yMin(0.0), cellSize(1.0), nx(0), ny(0)
+{
+    Bnd_Box all;
+    int count = 0;
+    for (auto& e: edges) {
+        if (e.usable) {
+            all.Add(e.box);
+            count++;
+        }
+    }
+    if (all.IsVoid()) {
+        return;
+    }
+
+    double zMin, xMax, yMax, zMax;
+    all.Get(xMin, yMin, zMin, xMax, yMax, zMax);
+    double width = std::max(xMax - xMin, Precision::Confusion());
+    double height = std::max(yMax - yMin, Precision::Confusion());
+    //about one cell per edge
+    cellSize = std::max(std::sqrt(width * height / count),
+                        std::max(width, height) / MaxCells);
+    nx = std::min(int(width / cellSize) + 1, MaxCells);
+    ny = std::min(int(height / cellSize) + 1, MaxCells);
+    cells.resize(nx * ny);
+
+    for (int i = 0; i < int(edges.size()); i++) {
+        if (!edges[i].usable) {
+            continue;
+        }
+        double bxMin, byMin, bzMin, bxMax, byMax, bzMax;
+        edges[i].box.Get(bxMin, byMin, bzMin, bxMax, byMax, bzMax);
+        int cxMax = cellX(bxMax);
+        int cyMax = cellY(byMax);
+        for (int cy = cellY(byMin); cy <= cyMax; cy++) {
+            for (int cx = cellX(bxMin); cx <= cxMax; cx++) {
+                cells[cy * nx + cx].push_back(i);
+            }
+        }
+    }
+}
+
+int EdgeGrid::cellX(double x) const
+{
+    int c = int((x - xMin) / cellSize);
+    return std::max(0, std::min(c, nx - 1));
+}
+
+int EdgeGrid::cellY(double y) const
+{
+    int c = int((y - yMin) / cellSize);
+    return std::max(0, std::min(c, ny - 1));
+}
+
+const std::vector<int>& EdgeGrid::candidates(const gp_Pnt& pt) const
+{
+    if (cells.empty()) {
+        return none;
+    }
+    return cells[cellY(pt.Y()) * nx + cellX(pt.X())];
+}
+
+} //end anonymous namespace
+
 //this routine is the big time consumer.  gets called many times (and is slow?))
 //note param gets modified here
 bool DrawProjectSplit::isOnEdge(TopoDS_Edge e, TopoDS_Vertex v, double& param, bool allowEnds)
 {
-    bool result = false;
-    bool outOfBox = false;
     param = -2;
 
     //eliminate obvious cases
@@ -258,37 +330,86 @@ bool DrawProjectSplit::isOnEdge(TopoDS_Edge e, TopoDS_Vertex v, double& param, b
     } else {
         gp_Pnt pt = BRep_Tool::Pnt(v);
         if (sBox.IsOut(pt)) {
-            outOfBox = true;
+            return false;
         }
     }
-    if (!outOfBox) {
-            double dist = DrawUtil::simpleMinDist(v,e);
-            if (dist < 0.0) {
-                Base::Console().Error("DPS::isOnEdge - simpleMinDist failed: %.3f\n",dist);
-                result = false;
-            } else if (dist < Precision::Confusion()) {
-                const gp_Pnt pt = BRep_Tool::Pnt(v);                         //have to duplicate method 3 to get param
-                BRepAdaptor_Curve adapt(e);
-                const Handle(Geom_Curve) c = adapt.Curve().Curve();
-                double maxDist = 0.000001;     //magic number.  less than this gives false positives.
-                //bool found =
-                (void) GeomLib_Tool::Parameter(c,pt,maxDist,param);  //already know point it on curve
-                result = true;
+    return isOnCurve(e, v, param, allowEnds);
+}
+
+//! find the points where a vertex of one edge touches the inside of another
+//! edge. The edge boxes are computed once and kept in a grid, so each vertex
+//! is only tested against the edges near it. The edges are processed in
+//! parallel.
+std::vector<splitPoint> DrawProjectSplit::findSplits(const std::vector<TopoDS_Edge>& edges)
+{
+    std::vector<SplitEdge> data(edges.size());
+    for (size_t i = 0; i < edges.size(); i++) {
+        SplitEdge& d = data[i];
+        d.usable = false;
+        BRepBndLib::Add(edges[i], d.box);
+        d.box.SetGap(0.1);
+        if (d.box.IsVoid()) {
+            Base::Console().Log("INFO - DPS::findSplits - Bnd_Box is void\n");
+            continue;
+        }
+        if (DrawUtil::isZeroEdge(edges[i])) {
+            continue;  //skip zero length edges. shouldn't happen ;)
+        }
+        d.v1 = TopExp::FirstVertex(edges[i]);
+        d.v2 = TopExp::LastVertex(edges[i]);
+        d.p1 = BRep_Tool::Pnt(d.v1);
+        d.p2 = BRep_Tool::Pnt(d.v2);
+        d.usable = true;
+    }
+    EdgeGrid grid(data);
+
+    struct SplitJob {
+        int first;
+        int last;
+        std::vector<splitPoint> splits;
+    };
+    const int blockSize = 64;
+    std::vector<SplitJob> jobs;
+    for (int i = 0; i < int(edges.size()); i += blockSize) {
+        SplitJob job;
+        job.first = i;
+        job.last = std::min(i + blockSize, int(edges.size()));
+        jobs.push_back(job);
+    }
+
+    QtConcurrent::blockingMap(jobs, [&edges, &data, &grid](SplitJob& job) {
+        for (int iOuter = job.first; iOuter < job.last; iOuter++) {
+            const SplitEdge& outer = data[iOuter];
+            if (!outer.usable) {
+                continue;
             }
-            if (result) {
-                TopoDS_Vertex v1 = TopExp::FirstVertex(e);
-                TopoDS_Vertex v2 = TopExp::LastVertex(e);
-                if (DrawUtil::isSamePoint(v,v1) || DrawUtil::isSamePoint(v,v2)) {
-                    if (!allowEnds) {
-                        result = false;
+            for (int end = 0; end < 2; end++) {
+                const TopoDS_Vertex& v = end == 0 ? outer.v1 : outer.v2;
+                const gp_Pnt& pt = end == 0 ? outer.p1 : outer.p2;
+                for (int iInner : grid.candidates(pt)) {
+                    if (iInner == iOuter || data[iInner].box.IsOut(pt)) {
+                        continue;
+                    }
+                    double param = -1;
+                    if (isOnCurve(edges[iInner], v, param, false)) {
+                        splitPoint s;
+                        s.i = iInner;
+                        s.v = Base::Vector3d(pt.X(),pt.Y(),pt.Z());
+                        s.param = param;
+                        job.splits.push_back(s);
                     }
                 }
             }
-    } //!outofbox
+        }
+    });
+
+    std::vector<splitPoint> result;
+    for (auto& job: jobs) {
+        result.insert(result.end(), job.splits.begin(), job.splits.end());
+    }
     return result;
 }
 
-
 std::vector<TopoDS_Edge> DrawProjectSplit::splitEdges(std::vector<TopoDS_Edge> edges, std::vector<splitPoint> splits)
 {
     std::vector<TopoDS_Edge> result;
@@ -413,10 +534,28 @@ std::vector<splitPoint> DrawProjectSplit::sortSplits(std::vector<splitPoint>& s,
     return result;
 }
 
+//! removes edges with the same end points and end angles as an earlier edge.
+//! The kept edges are hashed by their quantised start point, so each edge is
+//! only compared with the kept edges starting in the neighbouring cells.
 std::vector<TopoDS_Edge> DrawProjectSplit::removeDuplicateEdges(std::vector<TopoDS_Edge>& inEdges)
 {
+    struct CellKey {
+        long long x, y, z;
+        bool operator==(const CellKey& other) const {
+            return x == other.x && y == other.y && z == other.z;
+        }
+    };
+    struct CellHash {
+        std::size_t operator()(const CellKey& k) const {
+            return std::hash<long long>()(k.x * 73856093LL ^ k.y * 19349663LL ^ k.z * 83492791LL);
+        }
+    };
+    //any size larger than the tolerance of edgeEqual works
+    const double cellSize = 1000.0 * Precision::Confusion();
+
     std::vector<TopoDS_Edge> result;
-    std::vector<edgeSortItem> temp;
+    std::vector<edgeSortItem> kept;
+    std::unordered_map<CellKey, std::vector<unsigned int>, CellHash> cells;
 
     unsigned int idx = 0;
     for (auto& e: inEdges) {
@@ -436,22 +575,37 @@ std::vector<TopoDS_Edge> DrawProjectSplit::removeDuplicateEdges(std::vector<Topo
              item.startAngle = item.endAngle;
              item.endAngle = aTemp;
         }
-        item.idx = idx;
-        temp.push_back(item);
-        idx++;
-    }
-
-    std::vector<edgeSortItem> sorted = sortEdges(temp,true);
-    auto last = std::unique(sorted.begin(), sorted.end(), edgeSortItem::edgeEqual);  //duplicates to back
-    sorted.erase(last, sorted.end());                         //remove dupls
-
-    //TODO: "sorted" turns to garbage if pagescale set to "0.1"!!!!???? ***
-    for (auto e: sorted) {
-        if (e.idx < inEdges.size()) {
-            result.push_back(inEdges.at(e.idx));                  //<<< ***here
-        } else {
-            Base::Console().Message("ERROR - DPS::removeDuplicateEdges - access: %d inEdges: %d\n",e.idx,inEdges.size());
+        item.idx = idx++;
+
+        CellKey key = { (long long)std::floor(item.start.x / cellSize),
+                        (long long)std::floor(item.start.y / cellSize),
+                        (long long)std::floor(item.start.z / cellSize) };
+        bool duplicate = false;
+        for (long long dx = -1; dx <= 1 && !duplicate; dx++) {
+            for (long long dy = -1; dy <= 1 && !duplicate; dy++) {
+                for (long long dz = -1; dz <= 1 && !duplicate; dz++) {
+                    CellKey adjacent = { key.x + dx, key.y + dy, key.z + dz };
+                    auto it = cells.find(adjacent);
+                    if (it == cells.end()) {
+                        continue;
+                    }
+                    for (auto k: it->second) {
+                        //edges sharing their geometry are duplicates for sure
+                        if (e.IsSame(inEdges[kept[k].idx]) ||
+                            edgeSortItem::edgeEqual(item, kept[k])) {
+                            duplicate = true;
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+        if (duplicate) {
+            continue;
         }
+        cells[key].push_back(kept.size());
+        kept.push_back(item);
+        result.push_back(e);
     }
     return result;
 }
@@ -420,7 +420,7 @@ void DrawViewDetail::detailExec(TopoDS_Shape shape,
         BRepTools::Write(tool, "DVDScaled.brep");            //debug
     }
 
-    geometryObject =  buildGeometryObject(scaledShape,viewAxis);
+    setGeometryObject(buildGeometryObject(scaledShape,viewAxis));
     geometryObject->pruneVertexGeom(Base::Vector3d(0.0,0.0,0.0),
                                     Radius.getValue() * scale);      //remove vertices beyond clipradius
 
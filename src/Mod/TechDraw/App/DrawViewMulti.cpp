@@ -151,7 +151,7 @@ App::DocumentObjectExecReturn *DrawViewMulti::execute(void)
                                                           viewAxis,
                                                           Rotation.getValue());
         }
-        geometryObject = buildGeometryObject(mirroredShape,viewAxis);
+        setGeometryObject(buildGeometryObject(mirroredShape,viewAxis));
 
 #if MOD_TECHDRAW_HANDLE_FACES
         extractFaces();
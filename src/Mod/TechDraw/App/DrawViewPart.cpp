@@ -57,6 +57,7 @@
 #include <HLRBRep_Algo.hxx>
 #include <HLRBRep_HLRToShape.hxx>
 #include <HLRBRep_ShapeBounds.hxx>
+#include <Precision.hxx>
 #include <ShapeExtend_WireData.hxx>
 #include <ShapeFix_ShapeTolerance.hxx>
 #include <ShapeFix_Wire.hxx>
@@ -73,6 +74,10 @@
 
 #include <TopTools_IndexedMapOfShape.hxx>
 
+#include <QCoreApplication>
+#include <QThread>
+#include <QtConcurrentRun>
+
 #endif
 
 #include <limits>
@@ -80,6 +85,7 @@
 #include <cmath>
 
 #include <App/Application.h>
+#include <App/AutoTransaction.h>
 #include <App/Document.h>
 #include <App/GroupExtension.h>
 #include <App/Part.h>
@@ -109,6 +115,7 @@
 #include "Geometry.h"
 #include "GeometryObject.h"
 #include "LineGroup.h"
+#include "ProjectionWatcher.h"
 #include "ShapeExtractor.h"
 
 #include <Mod/TechDraw/App/DrawViewPartPy.h>  // generated from DrawViewPartPy.xml
@@ -127,7 +134,11 @@ PROPERTY_SOURCE_WITH_EXTENSIONS(TechDraw::DrawViewPart,
                                 TechDraw::DrawView)
 
 DrawViewPart::DrawViewPart(void) :
-    geometryObject(0)
+    geometryObject(0),
+    m_projectionWatcher(nullptr),
+    m_pendingGeometry(nullptr),
+    m_restartProjection(false),
+    m_geometryGeneration(0)
 {
     static const char *group = "Projection";
     static const char *sgroup = "HLR Parameters";
@@ -176,6 +187,9 @@ DrawViewPart::DrawViewPart(void) :
 
 DrawViewPart::~DrawViewPart()
 {
+    //the worker thread can't be interrupted, it still writes to m_pendingGeometry
+    delete m_projectionWatcher;
+    delete m_pendingGeometry;
     removeAllReferencesFromGeom();
     delete geometryObject;
 }
@@ -289,6 +303,12 @@ App::DocumentObjectExecReturn *DrawViewPart::execute(void)
     }
 
     m_saveShape = shape;
+    if (useAsyncProjection()) {
+        //the current geometry is shown until the projection is done
+        startProjection(shape);
+        return DrawView::execute();
+    }
+
     partExec(shape);
     addShapes2d();
 
@@ -348,7 +368,7 @@ void DrawViewPart::onChanged(const App::Property* prop)
 void DrawViewPart::partExec(TopoDS_Shape shape)
 {
 //    Base::Console().Message("DVP::partExec()\n");
-    geometryObject = makeGeometryForShape(shape);
+    setGeometryObject(makeGeometryForShape(shape));
     if (geometryObject == nullptr) {
         return;
     }
@@ -371,6 +391,140 @@ void DrawViewPart::partExec(TopoDS_Shape shape)
     addReferencesToGeom();
 }
 
+//! the projection runs in a worker thread if the result can be handed back
+//! by the event loop, i.e. when the GUI is up
+bool DrawViewPart::useAsyncProjection(void) const
+{
+    if (App::Application::Config()["RunMode"] != "Gui") {
+        return false;
+    }
+    QCoreApplication* app = QCoreApplication::instance();
+    if (app == nullptr || app->thread() != QThread::currentThread()) {
+        return false;
+    }
+    Base::Reference<ParameterGrp> hGrp = App::GetApplication().GetUserParameter()
+        .GetGroup("BaseApp")->GetGroup("Preferences")->GetGroup("Mod/TechDraw/General");
+    return hGrp->GetBool("AsyncProjection", true);
+}
+
+//! projects shape in a worker thread. The current geometry is kept until
+//! onProjectionFinished() takes over the new one.
+void DrawViewPart::startProjection(TopoDS_Shape shape)
+{
+    if (m_projectionWatcher == nullptr) {
+        m_projectionWatcher = new ProjectionWatcher(this);
+    }
+
+    m_pendingSource = shape;
+    if (m_projectionWatcher->isPending()) {
+        //OCC's HLR can't be interrupted. The running projection is discarded
+        //when it is done, and started again with the latest input.
+        m_restartProjection = true;
+        return;
+    }
+    m_restartProjection = false;
+
+    gp_Ax2 viewAxis;
+    TopoDS_Shape scaledShape = prepareShape(shape,
+                                            viewAxis,
+                                            m_pendingCentroid,
+                                            m_pendingShape);
+    m_pendingGeometry = newGeometryObject();
+    m_projectionWatcher->setFuture(QtConcurrent::run(&DrawViewPart::projectGeometry,
+                                                     m_pendingGeometry,
+                                                     scaledShape,
+                                                     viewAxis,
+                                                     getHlrSettings()));
+}
+
+bool DrawViewPart::isProjecting(void) const
+{
+    return m_projectionWatcher != nullptr && m_projectionWatcher->isPending();
+}
+
+void DrawViewPart::waitForProjection(void)
+{
+    if (m_projectionWatcher != nullptr) {
+        m_projectionWatcher->waitForFinished();
+    }
+}
+
+void DrawViewPart::onProjectionFinished(void)
+{
+    if (installProjection()) {
+        finishProjection();
+    }
+}
+
+//! replaces the geometry with the projected one. Nothing else in the document
+//! is touched, so this is safe while the document is recomputing.
+bool DrawViewPart::installProjection(void)
+{
+    TechDraw::GeometryObject* go = m_pendingGeometry;
+    m_pendingGeometry = nullptr;
+    if (m_restartProjection) {
+        delete go;
+        startProjection(m_pendingSource);
+        return false;
+    }
+    if (go == nullptr || getNameInDocument() == nullptr || nowUnsetting) {
+        delete go;
+        return false;
+    }
+
+    //the reference vertexes belong to the view, not to the geometry
+    if (geometryObject != nullptr) {
+        removeAllReferencesFromGeom();
+        delete geometryObject;
+    }
+    setGeometryObject(go);
+    m_saveCentroid = m_pendingCentroid;
+    m_saveShape = m_pendingShape;
+    bbox = geometryObject->calcBoundingBox();
+
+    addCosmeticVertexesToGeom();
+    addCosmeticEdgesToGeom();
+    addCenterLinesToGeom();
+    addReferencesToGeom();
+    addShapes2d();
+    return true;
+}
+
+//! the part of the handover that changes other properties and objects, which
+//! must not run while the document is recomputing
+void DrawViewPart::finishProjection(void)
+{
+    if (getNameInDocument() == nullptr || nowUnsetting || geometryObject == nullptr) {
+        return;
+    }
+
+    //second pass if required
+    if (ScaleType.isValue("Automatic") && !checkFit()) {
+        double newScale = autoScale();
+        if (!DrawUtil::fpCompare(newScale, Scale.getValue())) {
+            App::AutoTransaction committer("Automatic scale", true);
+            Scale.setValue(newScale);
+            Scale.purgeTouched();
+            startProjection(m_pendingSource);
+            return;
+        }
+    }
+
+    //these were recomputed with the old geometry
+    for (auto& dim: getDimensions()) {
+        dim->recomputeFeature();
+    }
+    for (auto& balloon: getBalloons()) {
+        balloon->recomputeFeature();
+    }
+    for (auto& hatch: getGeomHatches()) {
+        hatch->recomputeFeature();
+    }
+
+    requestPaint();
+    postProjection();
+}
+
 void DrawViewPart::addShapes2d(void)
 {
     std::vector<TopoDS_Shape> shapes = getSourceShape2d();
@@ -403,22 +557,62 @@ void DrawViewPart::addShapes2d(void)
 
 GeometryObject* DrawViewPart::makeGeometryForShape(TopoDS_Shape shape)
 {
-    gp_Pnt inputCenter;
+    gp_Ax2 viewAxis;
+    TopoDS_Shape scaledShape = prepareShape(shape,
+                                            viewAxis,
+                                            m_saveCentroid,
+                                            m_saveShape);
+//    BRepTools::Write(scaledShape, "DVPScaled.brep");            //debug
+    GeometryObject* go =  buildGeometryObject(scaledShape,viewAxis);
+    return go;
+}
+
+//! centers, scales and rotates shape for projection
+TopoDS_Shape DrawViewPart::prepareShape(const TopoDS_Shape& shape,
+                                        gp_Ax2& viewAxis,
+                                        Base::Vector3d& centroid,
+                                        TopoDS_Shape& centeredShape)
+{
     Base::Vector3d stdOrg(0.0,0.0,0.0);
+    viewAxis = getProjectionCS(stdOrg);
+
+    //the shapes of the sources identify the input, as shape is a copy of them
+    std::vector<TopoDS_Shape> sources;
+    if (CoarseView.getValue()) {
+        for (auto& obj: getAllSources()) {
+            TopoDS_Shape s = Part::Feature::getShape(obj);
+            if (s.IsNull()) {
+                sources.clear();
+                break;
+            }
+            sources.push_back(s);
+        }
+    }
 
-    gp_Ax2 viewAxis = getProjectionCS(stdOrg);
+    CoarseShapeCache& cache = m_coarseCache;
+    if (!sources.empty() &&
+        sources.size() == cache.sources.size() &&
+        std::equal(sources.begin(), sources.end(), cache.sources.begin(),
+                   [](const TopoDS_Shape& a, const TopoDS_Shape& b) { return a.IsEqual(b); }) &&
+        viewAxis.Location().IsEqual(cache.viewAxis.Location(), Precision::Confusion()) &&
+        viewAxis.Direction().IsEqual(cache.viewAxis.Direction(), Precision::Angular()) &&
+        viewAxis.XDirection().IsEqual(cache.viewAxis.XDirection(), Precision::Angular()) &&
+        DrawUtil::fpCompare(getScale(), cache.scale) &&
+        DrawUtil::fpCompare(Rotation.getValue(), cache.rotation)) {
+        centroid = cache.centroid;
+        centeredShape = cache.centeredShape;
+        return cache.scaledShape;
+    }
 
-    inputCenter = TechDraw::findCentroid(shape,
-                                         viewAxis);
-    Base::Vector3d centroid(inputCenter.X(),
-                            inputCenter.Y(),
-                            inputCenter.Z());
+    gp_Pnt inputCenter = TechDraw::findCentroid(shape,
+                                                viewAxis);
+    centroid = Base::Vector3d(inputCenter.X(),
+                              inputCenter.Y(),
+                              inputCenter.Z());
 
     //center shape on origin
-    TopoDS_Shape centeredShape = TechDraw::moveShape(shape,
-                                                     centroid * -1.0);
-    m_saveCentroid = centroid;
-    m_saveShape = centeredShape;
+    centeredShape = TechDraw::moveShape(shape,
+                                        centroid * -1.0);
 
     TopoDS_Shape scaledShape = TechDraw::scaleShape(centeredShape,
                                                     getScale());
@@ -427,20 +621,73 @@ GeometryObject* DrawViewPart::makeGeometryForShape(TopoDS_Shape shape)
                                             viewAxis,
                                             Rotation.getValue());  //conventional rotation
      }
-//    BRepTools::Write(scaledShape, "DVPScaled.brep");            //debug
-    GeometryObject* go =  buildGeometryObject(scaledShape,viewAxis);
-    return go;
+
+    //neither moving, scaling by 1 nor rotating copies the TShapes. The
+    //projection may run in a worker thread, and the polygon HLR meshes the
+    //shape, so it gets a private copy that shares nothing with the sources.
+    BRepBuilderAPI_Copy copier(scaledShape);
+    scaledShape = copier.Shape();
+
+    cache = CoarseShapeCache();
+    if (!sources.empty()) {
+        cache.sources = sources;
+        cache.viewAxis = viewAxis;
+        cache.scale = getScale();
+        cache.rotation = Rotation.getValue();
+        cache.centroid = centroid;
+        cache.centeredShape = centeredShape;
+        cache.scaledShape = scaledShape;
+    }
+    return scaledShape;
 }
 
 //note: slightly different than routine with same name in DrawProjectSplit
 TechDraw::GeometryObject* DrawViewPart::buildGeometryObject(TopoDS_Shape shape, gp_Ax2 viewAxis)
+{
+    TechDraw::GeometryObject* go = newGeometryObject();
+    HlrSettings settings = getHlrSettings();
+    settings.faces = false;                 //faces are made by the caller
+    projectGeometry(go, shape, viewAxis, settings);
+    bbox = go->calcBoundingBox();
+    return go;
+}
+
+TechDraw::GeometryObject* DrawViewPart::newGeometryObject(void)
 {
     TechDraw::GeometryObject* go = new TechDraw::GeometryObject(getNameInDocument(), this);
     go->setIsoCount(IsoCount.getValue());
     go->isPerspective(Perspective.getValue());
     go->setFocus(Focus.getValue());
     go->usePolygonHLR(CoarseView.getValue());
+    return go;
+}
 
+DrawViewPart::HlrSettings DrawViewPart::getHlrSettings(void) const
+{
+    HlrSettings settings;
+    settings.smoothVisible = SmoothVisible.getValue();
+    settings.seamVisible = SeamVisible.getValue();
+    settings.isoVisible = IsoVisible.getValue();
+    settings.hardHidden = HardHidden.getValue();
+    settings.smoothHidden = SmoothHidden.getValue();
+    settings.seamHidden = SeamHidden.getValue();
+    settings.isoHidden = IsoHidden.getValue();
+    settings.isoCount = IsoCount.getValue();
+#if MOD_TECHDRAW_HANDLE_FACES
+    settings.faces = m_handleFaces && !CoarseView.getValue();
+#else
+    settings.faces = false;
+#endif
+    return settings;
+}
+
+//! projects shape and extracts the requested edges (and faces). Doesn't touch
+//! the view, so this can run in a worker thread.
+void DrawViewPart::projectGeometry(TechDraw::GeometryObject* go,
+                                   TopoDS_Shape shape,
+                                   gp_Ax2 viewAxis,
+                                   HlrSettings settings)
+{
     if (go->usePolygonHLR()){
         go->projectShapeWithPolygonAlgo(shape,
             viewAxis);
@@ -454,33 +701,33 @@ TechDraw::GeometryObject* DrawViewPart::buildGeometryObject(TopoDS_Shape shape,
                         true);
     go->extractGeometry(TechDraw::ecOUTLINE,
                         true);
-    if (SmoothVisible.getValue()) {
+    if (settings.smoothVisible) {
         go->extractGeometry(TechDraw::ecSMOOTH,
                             true);
     }
-    if (SeamVisible.getValue()) {
+    if (settings.seamVisible) {
         go->extractGeometry(TechDraw::ecSEAM,
                             true);
     }
-    if ((IsoVisible.getValue()) && (IsoCount.getValue() > 0)) {
+    if ((settings.isoVisible) && (settings.isoCount > 0)) {
         go->extractGeometry(TechDraw::ecUVISO,
                             true);
     }
-    if (HardHidden.getValue()) {
+    if (settings.hardHidden) {
         go->extractGeometry(TechDraw::ecHARD,
                             false);
         go->extractGeometry(TechDraw::ecOUTLINE,
                             false);
     }
-    if (SmoothHidden.getValue()) {
+    if (settings.smoothHidden) {
         go->extractGeometry(TechDraw::ecSMOOTH,
                             false);
     }
-    if (SeamHidden.getValue()) {
+    if (settings.seamHidden) {
         go->extractGeometry(TechDraw::ecSEAM,
                             false);
     }
-    if (IsoHidden.getValue() && (IsoCount.getValue() > 0)) {
+    if (settings.isoHidden && (settings.isoCount > 0)) {
         go->extractGeometry(TechDraw::ecUVISO,
                             false);
     }
@@ -489,8 +736,16 @@ TechDraw::GeometryObject* DrawViewPart::buildGeometryObject(TopoDS_Shape shape,
     if (edges.empty()) {
         Base::Console().Log("DVP::buildGO - NO extracted edges!\n");
     }
-    bbox = go->calcBoundingBox();
-    return go;
+
+    if (settings.faces) {
+        try {
+            extractFaces(go, settings.smoothVisible, settings.seamVisible);
+        }
+        catch (Standard_Failure& e4) {
+            Base::Console().Log("LOG - DVP::projectGeometry - extractFaces failed for %s - %s **\n",
+                                go->getParentName().c_str(), e4.GetMessageString());
+        }
+    }
 }
 
 //! make faces from the existing edge geometry
@@ -499,9 +754,23 @@ void DrawViewPart::extractFaces()
     if (geometryObject == nullptr) {
         return;
     }
-    geometryObject->clearFaceGeom();
+    m_geometryGeneration++;
+    extractFaces(geometryObject, SmoothVisible.getValue(), SeamVisible.getValue());
+}
+
+//! take over new geometry, dependent objects see the change through the generation
+void DrawViewPart::setGeometryObject(TechDraw::GeometryObject* go)
+{
+    geometryObject = go;
+    m_geometryGeneration++;
+}
+
+void DrawViewPart::extractFaces(TechDraw::GeometryObject* go, bool smooth, bool seam)
+{
+    const char* name = go->getParentName().c_str();
+    go->clearFaceGeom();
     const std::vector<TechDraw::BaseGeom*>& goEdges =
-                       geometryObject->getVisibleFaceEdges(SmoothVisible.getValue(),SeamVisible.getValue());
+                       go->getVisibleFaceEdges(smooth,seam);
     std::vector<TechDraw::BaseGeom*>::const_iterator itEdge = goEdges.begin();
     std::vector<TopoDS_Edge> origEdges;
     for (;itEdge != goEdges.end(); itEdge++) {
@@ -514,69 +783,13 @@ void DrawViewPart::extractFaces()
         if (!DrawUtil::isZeroEdge(e)) {
             nonZero.push_back(e);
         } else {
-            Base::Console().Log("INFO - DVP::extractFaces for %s found ZeroEdge!\n",getNameInDocument());
+            Base::Console().Log("INFO - DVP::extractFaces for %s found ZeroEdge!\n",name);
         }
     }
 
     //HLR algo does not provide all edge intersections for edge endpoints.
     //need to split long edges touched by Vertex of another edge
-    std::vector<splitPoint> splits;
-    std::vector<TopoDS_Edge>::iterator itOuter = nonZero.begin();
-    int iOuter = 0;
-    for (; itOuter != nonZero.end(); ++itOuter, iOuter++) {    //*** itOuter != nonZero.end() - 1
-        TopoDS_Vertex v1 = TopExp::FirstVertex((*itOuter));
-        TopoDS_Vertex v2 = TopExp::LastVertex((*itOuter));
-        Bnd_Box sOuter;
-        BRepBndLib::Add(*itOuter, sOuter);
-        sOuter.SetGap(0.1);
-        if (sOuter.IsVoid()) {
-            Base::Console().Log("DVP::Extract Faces - outer Bnd_Box is void for %s\n",getNameInDocument());
-            continue;
-        }
-        if (DrawUtil::isZeroEdge(*itOuter)) {
-            Base::Console().Log("DVP::extractFaces - outerEdge: %d is ZeroEdge\n",iOuter);   //this is not finding ZeroEdges
-            continue;  //skip zero length edges. shouldn't happen ;)
-        }
-        int iInner = 0;
-        std::vector<TopoDS_Edge>::iterator itInner = nonZero.begin();   //***sb itOuter + 1;
-        for (; itInner != nonZero.end(); ++itInner,iInner++) {
-            if (iInner == iOuter) {
-                continue;
-            }
-            if (DrawUtil::isZeroEdge((*itInner))) {
-                continue;  //skip zero length edges. shouldn't happen ;)
-            }
-
-            Bnd_Box sInner;
-            BRepBndLib::Add(*itInner, sInner);
-            sInner.SetGap(0.1);
-            if (sInner.IsVoid()) {
-                Base::Console().Log("INFO - DVP::Extract Faces - inner Bnd_Box is void for %s\n",getNameInDocument());
-                continue;
-            }
-            if (sOuter.IsOut(sInner)) {      //bboxes of edges don't intersect, don't bother
-                continue;
-            }
-
-            double param = -1;
-            if (DrawProjectSplit::isOnEdge((*itInner),v1,param,false)) {
-                gp_Pnt pnt1 = BRep_Tool::Pnt(v1);
-                splitPoint s1;
-                s1.i = iInner;
-                s1.v = Base::Vector3d(pnt1.X(),pnt1.Y(),pnt1.Z());
-                s1.param = param;
-                splits.push_back(s1);
-            }
-            if (DrawProjectSplit::isOnEdge((*itInner),v2,param,false)) {
-                gp_Pnt pnt2 = BRep_Tool::Pnt(v2);
-                splitPoint s2;
-                s2.i = iInner;
-                s2.v = Base::Vector3d(pnt2.X(),pnt2.Y(),pnt2.Z());
-                s2.param = param;
-                splits.push_back(s2);
-            }
-        } //inner loop
-    }   //outer loop
+    std::vector<splitPoint> splits = DrawProjectSplit::findSplits(nonZero);
 
     std::vector<splitPoint> sorted = DrawProjectSplit::sortSplits(splits,true);
     auto last = std::unique(sorted.begin(), sorted.end(), DrawProjectSplit::splitEqual);  //duplicates to back
@@ -595,7 +808,7 @@ void DrawViewPart::extractFaces()
     ew.loadEdges(newEdges);
     bool success = ew.perform();
     if (!success) {
-        Base::Console().Warning("DVP::extractFaces - %s -Can't make faces from projected edges\n", getNameInDocument());
+        Base::Console().Warning("DVP::extractFaces - %s -Can't make faces from projected edges\n", name);
         return;
     }
     std::vector<TopoDS_Wire> fw = ew.getResultNoDups();
@@ -616,7 +829,7 @@ void DrawViewPart::extractFaces()
         const TopoDS_Wire& wire = (*itWire);
         TechDraw::Wire* w = new TechDraw::Wire(wire);
         f->wires.push_back(w);
-        geometryObject->addFaceGeom(f);
+        go->addFaceGeom(f);
     }
 }
 
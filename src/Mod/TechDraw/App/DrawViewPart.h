@@ -25,6 +25,7 @@
 #ifndef _DrawViewPart_h_
 #define _DrawViewPart_h_
 
+#include <gp_Ax2.hxx>
 #include <TopoDS_Edge.hxx>
 #include <TopoDS_Vertex.hxx>
 #include <TopoDS_Wire.hxx>
@@ -46,7 +47,6 @@
 
 class gp_Pnt;
 class gp_Pln;
-class gp_Ax2;
 //class TopoDS_Edge;
 //class TopoDS_Vertex;
 //class TopoDS_Wire;
@@ -77,6 +77,7 @@ class CosmeticVertex;
 class CosmeticEdge;
 class CenterLine;
 class GeomFormat;
+class ProjectionWatcher;
 }
 
 namespace TechDraw
@@ -132,6 +133,19 @@ public:
 
     bool hasGeometry(void) const;
     TechDraw::GeometryObject* getGeometryObject(void) const { return geometryObject; }
+    /// Changes whenever the geometry is replaced or its faces are rebuilt
+    unsigned long getGeometryGeneration(void) const { return m_geometryGeneration; }
+
+    /// Returns true while the geometry is being projected in a worker thread
+    bool isProjecting(void) const;
+    /// Blocks until the geometry projected in a worker thread is available
+    void waitForProjection(void);
+    /// Takes over the geometry projected in a worker thread, called by ProjectionWatcher
+    void onProjectionFinished(void);
+    /// Installs the projected geometry only, returns false if nothing was installed
+    bool installProjection(void);
+    /// Rescales and updates the dependent views after installProjection()
+    void finishProjection(void);
 
     TechDraw::BaseGeom* getGeomByIndex(int idx) const;               //get existing geom for edge idx in projection
     TechDraw::Vertex* getProjVertexByIndex(int idx) const;           //get existing geom for vertex idx in projection
@@ -211,6 +225,7 @@ protected:
     bool checkXDirection(void) const;
 
     TechDraw::GeometryObject *geometryObject;
+    void setGeometryObject(TechDraw::GeometryObject* go);
     Base::BoundBox3d bbox;
 
     virtual void onChanged(const App::Property* prop) override;
@@ -218,10 +233,39 @@ protected:
 
     virtual TechDraw::GeometryObject*  buildGeometryObject(TopoDS_Shape shape, gp_Ax2 viewAxis); //const??
     virtual TechDraw::GeometryObject*  makeGeometryForShape(TopoDS_Shape shape);   //const??
+    TopoDS_Shape prepareShape(const TopoDS_Shape& shape,
+                              gp_Ax2& viewAxis,
+                              Base::Vector3d& centroid,
+                              TopoDS_Shape& centeredShape);
     void partExec(TopoDS_Shape shape);
     virtual void addShapes2d(void);
 
     void extractFaces();
+    static void extractFaces(TechDraw::GeometryObject* go, bool smooth, bool seam);
+
+    //! HLR settings copied from the properties, so that they can be used in a worker thread
+    struct HlrSettings {
+        bool smoothVisible;
+        bool seamVisible;
+        bool isoVisible;
+        bool hardHidden;
+        bool smoothHidden;
+        bool seamHidden;
+        bool isoHidden;
+        int  isoCount;
+        bool faces;
+    };
+    HlrSettings getHlrSettings(void) const;
+    TechDraw::GeometryObject* newGeometryObject(void);
+    static void projectGeometry(TechDraw::GeometryObject* go,
+                                TopoDS_Shape shape,
+                                gp_Ax2 viewAxis,
+                                HlrSettings settings);
+
+    bool useAsyncProjection(void) const;
+    void startProjection(TopoDS_Shape shape);
+    //! called after the geometry projected in a worker thread has been taken over
+    virtual void postProjection(void) {}
 
     Base::Vector3d shapeCentroid;
     void getRunControl(void);
@@ -249,6 +293,29 @@ protected:
 private:
     bool nowUnsetting;
 
+    //projection running in a worker thread
+    TechDraw::ProjectionWatcher* m_projectionWatcher;
+    TechDraw::GeometryObject* m_pendingGeometry;
+    TopoDS_Shape m_pendingSource;
+    TopoDS_Shape m_pendingShape;
+    Base::Vector3d m_pendingCentroid;
+    bool m_restartProjection;
+    unsigned long m_geometryGeneration;
+
+    //the polygon HLR needs a tessellated shape. The scaled shape, a private
+    //copy of the sources, is kept with its tessellation until the sources,
+    //projection CS, scale or rotation change.
+    struct CoarseShapeCache {
+        std::vector<TopoDS_Shape> sources;
+        gp_Ax2 viewAxis;
+        double scale;
+        double rotation;
+        Base::Vector3d centroid;
+        TopoDS_Shape centeredShape;
+        TopoDS_Shape scaledShape;
+    };
+    CoarseShapeCache m_coarseCache;
+
 };
 
 typedef App::FeaturePythonT<DrawViewPart> DrawViewPartPython;
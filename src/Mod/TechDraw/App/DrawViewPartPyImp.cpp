@@ -77,6 +77,7 @@ PyObject* DrawViewPartPy::getVisibleEdges(PyObject *args)
 {
     (void) args;
     DrawViewPart* dvp = getDrawViewPartPtr();
+    dvp->waitForProjection();
     PyObject* pEdgeList = PyList_New(0);
     std::vector<TechDraw::BaseGeom*> geoms = dvp->getEdgeGeometry();
     for (auto& g: geoms) {
@@ -93,6 +94,7 @@ PyObject* DrawViewPartPy::getHiddenEdges(PyObject *args)
 {
     (void) args;
     DrawViewPart* dvp = getDrawViewPartPtr();
+    dvp->waitForProjection();
     PyObject* pEdgeList = PyList_New(0);
     std::vector<TechDraw::BaseGeom*> geoms = dvp->getEdgeGeometry();
     for (auto& g: geoms) {
@@ -655,6 +657,7 @@ PyObject* DrawViewPartPy::getEdgeByIndex(PyObject *args)
         throw Py::TypeError("expected (edgeIndex)");
     }
     DrawViewPart* dvp = getDrawViewPartPtr();
+    dvp->waitForProjection();
 
     //this is scaled and +Yup
     //need unscaled and +Ydown
@@ -675,6 +678,7 @@ PyObject* DrawViewPartPy::getVertexByIndex(PyObject *args)
         throw Py::TypeError("expected (vertIndex)");
     }
     DrawViewPart* dvp = getDrawViewPartPtr();
+    dvp->waitForProjection();
 
     //this is scaled and +Yup
     //need unscaled and +Ydown
@@ -454,7 +454,7 @@ void DrawViewSection::sectionExec(TopoDS_Shape baseShape)
 //            DrawUtil::dumpCS("DVS::execute - CS to GO", viewAxis);
         }
 
-        geometryObject = buildGeometryObject(scaledShape,viewAxis);
+        setGeometryObject(buildGeometryObject(scaledShape,viewAxis));
 
 #if MOD_TECHDRAW_HANDLE_FACES
         extractFaces();
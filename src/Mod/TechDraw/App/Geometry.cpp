@@ -289,7 +289,15 @@ std::vector<Base::Vector3d> BaseGeom::findEndPoints()
         result.emplace_back(p.X(),p.Y(), p.Z());
         p = BRep_Tool::Pnt(TopExp::LastVertex(occEdge));
         result.emplace_back(p.X(),p.Y(), p.Z());
-    } else {
+    } else if (geomType == GENERIC) {
+        //lightweight segments (ex hatch lines) only carry their points
+        Generic* gen = static_cast<Generic*>(this);
+        if (gen->points.size() > 1) {
+            result.push_back(gen->points.front());
+            result.push_back(gen->points.back());
+        }
+    }
+    if (result.empty()) {
         //TODO: this should throw something
         Base::Console().Message("Geometry::findEndPoints - OCC edge not found\n");
     }
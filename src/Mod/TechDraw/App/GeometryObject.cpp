@@ -303,6 +303,9 @@ void GeometryObject::projectShapeWithPolygonAlgo(const TopoDS_Shape& input,
     //work around for Mantis issue #3332
     //if 3332 gets fixed in OCC, this will produce shifted views and will need
     //to be reverted.
+    //Neither moving nor using input as is copies the geometry, so the mesh made
+    //below stays with input and is reused if input is projected again. The
+    //callers pass a private copy of the source shapes.
     TopoDS_Shape inCopy;
     if (!m_isPersp) {
         gp_Pnt gCenter = findCentroid(input,
@@ -310,8 +313,7 @@ void GeometryObject::projectShapeWithPolygonAlgo(const TopoDS_Shape& input,
         Base::Vector3d motion(-gCenter.X(),-gCenter.Y(),-gCenter.Z());
         inCopy = moveShape(input,motion);
     } else {
-        BRepBuilderAPI_Copy BuilderCopy(input);
-        inCopy = BuilderCopy.Shape();
+        inCopy = input;
     }
 
     auto start = chrono::high_resolution_clock::now();
@@ -319,13 +321,8 @@ void GeometryObject::projectShapeWithPolygonAlgo(const TopoDS_Shape& input,
     Handle(HLRBRep_PolyAlgo) brep_hlrPoly = NULL;
 
     try {
-        TopExp_Explorer faces(inCopy, TopAbs_FACE);
-        for (int i = 1; faces.More(); faces.Next(), i++) {
-            const TopoDS_Face& f = TopoDS::Face(faces.Current());
-            if (!f.IsNull()) {
-                BRepMesh_IncrementalMesh(f, 0.10); //Poly Algo requires a mesh!
-            }
-        }
+        //Poly Algo requires a mesh! Faces which are already meshed are skipped.
+        BRepMesh_IncrementalMesh(inCopy, 0.10, Standard_False, 0.5, Standard_True);
         brep_hlrPoly = new HLRBRep_PolyAlgo();
         brep_hlrPoly->Load(inCopy);
 
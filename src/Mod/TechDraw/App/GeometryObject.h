@@ -124,6 +124,7 @@ public:
     void clearFaceGeom();
     void setIsoCount(int i) { m_isoCount = i; }
     void setParentName(std::string n);                          //for debug messages
+    const std::string& getParentName(void) const { return m_parentName; }
     void isPerspective(bool b) { m_isPersp = b; }
     bool isPerspective(void) { return m_isPersp; }
     void usePolygonHLR(bool b) { m_usePolygonHLR = b; }
@@ -31,6 +31,8 @@
 #include <cmath>
 #endif
 
+#include <gp_Pnt.hxx>
+#include <BRepBuilderAPI_MakeEdge.hxx>
 #include <TopoDS_Vertex.hxx>
 #include <TopoDS_Edge.hxx>
 #include <TopExp.hxx>
@@ -45,6 +47,22 @@
 
 using namespace TechDraw;
 
+std::vector<TopoDS_Edge> LineSet::getEdges(void)
+{
+    //hatch lines are trimmed without OCC, the edges are only needed for export
+    if (m_edges.empty()) {
+        for (auto& g: m_geoms) {
+            Base::Vector3d s = g->getStartPoint();
+            Base::Vector3d e = g->getEndPoint();
+            BRepBuilderAPI_MakeEdge mkEdge(gp_Pnt(s.x, s.y, s.z), gp_Pnt(e.x, e.y, e.z));
+            if (mkEdge.IsDone()) {
+                m_edges.push_back(mkEdge.Edge());
+            }
+        }
+    }
+    return m_edges;
+}
+
 double LineSet::getMinX(void)
 {
     double xMin,yMin,zMin,xMax,yMax,zMax;
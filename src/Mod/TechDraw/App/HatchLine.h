@@ -120,8 +120,8 @@ public:
     void setGeoms(std::vector<TechDraw::BaseGeom*>  g) {m_geoms = g;}
     void setBBox(Bnd_Box bb) {m_box = bb;}
 
-    std::vector<TopoDS_Edge>    getEdges(void) { return m_edges; }
-    TopoDS_Edge                 getEdge(int i) {return m_edges.at(i);}
+    std::vector<TopoDS_Edge>    getEdges(void);                 //made from the geoms on first use
+    TopoDS_Edge                 getEdge(int i) {return getEdges().at(i);}
     std::vector<TechDraw::BaseGeom*> getGeoms(void) { return m_geoms; }
 
     PATLineSpec       getPATLineSpec(void) { return m_hatchLine; }
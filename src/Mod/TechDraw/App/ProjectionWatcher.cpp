@@ -0,0 +1,123 @@
+/***************************************************************************
+ *   Copyright (c) 2020 FreeCAD Developers                                 *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <QTimer>
+#endif
+
+#include <App/Document.h>
+#include <Base/Console.h>
+#include <Base/Exception.h>
+
+#include "DrawViewPart.h"
+#include "ProjectionWatcher.h"
+
+using namespace TechDraw;
+
+ProjectionWatcher::ProjectionWatcher(DrawViewPart* view)
+  : view(view), pending(false), deferred(false)
+{
+    connect(&watcher, SIGNAL(finished()), this, SLOT(onFinished()));
+}
+
+ProjectionWatcher::~ProjectionWatcher()
+{
+    discard();
+}
+
+void ProjectionWatcher::setFuture(const QFuture<void>& future)
+{
+    pending = true;
+    watcher.setFuture(future);
+}
+
+void ProjectionWatcher::waitForFinished(void)
+{
+    //taking over the result may start another projection, e.g. for automatic scaling
+    while (pending) {
+        watcher.waitForFinished();
+        pending = false;
+        if (isRecomputing()) {
+            //the caller only needs the geometry. Dimensions, balloons and the
+            //automatic scale are handled by onFinished() after the recompute.
+            if (view->installProjection() && !deferred) {
+                deferred = true;
+                QTimer::singleShot(0, this, SLOT(onFinished()));
+            }
+        }
+        else {
+            deferred = false;
+            view->onProjectionFinished();
+        }
+    }
+}
+
+void ProjectionWatcher::discard(void)
+{
+    watcher.waitForFinished();
+    pending = false;
+    deferred = false;
+}
+
+bool ProjectionWatcher::isRecomputing(void) const
+{
+    App::Document* doc = view->getDocument();
+    return doc && doc->testStatus(App::Document::Recomputing);
+}
+
+void ProjectionWatcher::onFinished(void)
+{
+    //a projection started after the deferred handover takes it over
+    if (pending ? !watcher.isFinished() : !deferred) {
+        return;
+    }
+
+    //the view updates dimensions and balloons, which must not happen while
+    //the document is recomputing, so try again a bit later
+    if (isRecomputing()) {
+        QTimer::singleShot(100, this, SLOT(onFinished()));
+        return;
+    }
+
+    bool install = pending;
+    pending = false;
+    deferred = false;
+    try {
+        if (install) {
+            view->onProjectionFinished();
+        }
+        else {
+            view->finishProjection();
+        }
+    }
+    catch (Base::Exception& e) {
+        e.ReportException();
+    }
+    catch (std::exception& e) {
+        Base::Console().Error("PW::onFinished - %s\n", e.what());
+    }
+}
+
+#include "moc_ProjectionWatcher.cpp"
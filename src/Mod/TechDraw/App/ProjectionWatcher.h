@@ -0,0 +1,73 @@
+/***************************************************************************
+ *   Copyright (c) 2020 FreeCAD Developers                                 *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef _TECHDRAW_PROJECTIONWATCHER_H_
+#define _TECHDRAW_PROJECTIONWATCHER_H_
+
+#include <QObject>
+#include <QFuture>
+#include <QFutureWatcher>
+
+namespace TechDraw
+{
+class DrawViewPart;
+
+/** Hands the geometry of a DrawViewPart projected in a worker thread back
+ *  to the view.
+ *
+ *  The result is handed over in the main thread, but never in the middle of
+ *  a document recompute. If waitForFinished() is called during a recompute,
+ *  only the geometry is installed and the rest of the handover is deferred.
+ *  There is at most one projection running per view.
+ */
+class TechDrawExport ProjectionWatcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    ProjectionWatcher(DrawViewPart* view);
+    ~ProjectionWatcher();
+
+    void setFuture(const QFuture<void>& future);
+    /// Returns true from setFuture() until the result has been handed over
+    bool isPending(void) const { return pending; }
+    /// Blocks until the view has taken over the result of the last projection
+    void waitForFinished(void);
+    /// Blocks until the worker thread is done, the result is not handed over
+    void discard(void);
+
+private Q_SLOTS:
+    void onFinished(void);
+
+private:
+    bool isRecomputing(void) const;
+
+    DrawViewPart* view;
+    QFutureWatcher<void> watcher;
+    bool pending;
+    bool deferred;
+};
+
+} //namespace TechDraw
+
+#endif
@@ -24,6 +24,7 @@
 
 import FreeCAD, os, unittest, tempfile
 import math
+import json
 
 #---------------------------------------------------------------------------
 # define the functions to test the FreeCAD Document code
@@ -608,6 +609,90 @@ class DocumentRecomputeCases(unittest.TestCase):
     self.Doc.removeObject(L7.Name)
     self.Doc.removeObject(L8.Name)
 
+  def testRecomputeProfile(self):
+    # L2 depends on L1 through an expression
+    self.L2.setExpression('Integer', self.L1.Name + '.Integer')
+    self.Doc.recompute()
+    self.L2.setExpression('Integer', self.L1.Name + '.Integer + 1')
+    self.Doc.startRecomputeProfile()
+
+    # only the touches done while recording count
+    self.Doc.recompute()
+    profile = self.Doc.getRecomputeProfile()
+    self.assertEqual([r["Object"] for r in profile], [self.L2.Name])
+    self.assertEqual(profile[0]["Cause"], "expression")
+
+    self.L1.Integer = 1
+    self.L1.Integer = 2
+    self.Doc.recompute()
+    self.assertEqual(self.L2.Integer, 3)
+    self.L1.enforceRecompute()
+    self.Doc.recompute()
+
+    profile = self.Doc.getRecomputeProfile()
+    self.assertEqual([r["Object"] for r in profile],
+                     [self.L2.Name, self.L1.Name, self.L2.Name, self.L1.Name, self.L2.Name])
+    self.assertEqual([r["Cause"] for r in profile],
+                     ["expression", "property:Integer", "dependency:" + self.L1.Name,
+                      "touched", "dependency:" + self.L1.Name])
+    self.assertEqual([r["TouchCount"] for r in profile], [0, 2, 0, 0, 0])
+    self.assertEqual([r["Depth"] for r in profile], [2, 1, 2, 1, 2])
+    serials = [r["Recompute"] for r in profile]
+    self.assertEqual([s - serials[0] for s in serials], [0, 1, 1, 2, 2])
+    for prev, rec in zip(profile, profile[1:]):
+      self.assertLessEqual(prev["Start"], rec["Start"])
+    for rec in profile:
+      self.assertEqual(rec["Label"], self.Doc.getObject(rec["Object"]).Label)
+      self.assertEqual(rec["Type"], "App::FeatureTest")
+      self.assertGreaterEqual(rec["Duration"], 0.0)
+      self.assertFalse(rec["Failed"])
+
+    # the export is a Chrome trace with one event per record
+    fileName = tempfile.gettempdir() + os.sep + "RecomputeProfile.json"
+    self.Doc.exportRecomputeProfile(fileName)
+    with open(fileName) as f:
+      trace = json.load(f)
+    os.remove(fileName)
+    events = trace["traceEvents"]
+    self.assertEqual(events[0]["ph"], "M")
+    self.assertEqual(events[0]["args"]["name"], self.Doc.Name)
+    self.assertEqual(len(events), len(profile) + 1)
+    for event, rec in zip(events[1:], profile):
+      self.assertEqual(event["ph"], "X")
+      self.assertEqual(event["name"], rec["Label"])
+      self.assertEqual(event["args"]["object"], rec["Object"])
+      self.assertEqual(event["args"]["cause"], rec["Cause"])
+
+    # stopping keeps the records but doesn't add new ones
+    self.Doc.stopRecomputeProfile()
+    self.L1.Integer = 3
+    self.Doc.recompute()
+    self.assertEqual(len(self.Doc.getRecomputeProfile()), len(profile))
+    self.Doc.clearRecomputeProfile()
+    self.assertEqual(self.Doc.getRecomputeProfile(), [])
+
+  def testRecomputeProfileCapacity(self):
+    self.assertRaises(ValueError, self.Doc.startRecomputeProfile, 0)
+    self.L2.setExpression('Integer', self.L1.Name + '.Integer')
+    self.Doc.recompute()
+
+    # the oldest records are dropped, the rest is returned oldest first
+    self.Doc.startRecomputeProfile(3)
+    for i in range(3):
+      self.L1.Integer = i
+      self.Doc.recompute()
+    profile = self.Doc.getRecomputeProfile()
+    self.assertEqual([r["Object"] for r in profile], [self.L2.Name, self.L1.Name, self.L2.Name])
+    serials = [r["Recompute"] for r in profile]
+    self.assertEqual([s - serials[0] for s in serials], [0, 1, 1])
+
+    # shrinking keeps the newest records
+    self.Doc.startRecomputeProfile(1)
+    profile = self.Doc.getRecomputeProfile()
+    self.assertEqual(len(profile), 1)
+    self.assertEqual(profile[0]["Recompute"], serials[-1])
+    self.Doc.stopRecomputeProfile()
+
   def tearDown(self):
     #closing doc
     FreeCAD.closeDocument("RecomputeTests")
@@ -1408,6 +1493,27 @@ class DocumentExpressionCases(unittest.TestCase):
     # must not raise a topological error
     self.assertEqual(self.Doc.recompute(), 2)
 
+  def testNativeEvaluation(self):
+    # A bound expression is evaluated natively where possible, while
+    # evalExpression() always goes through Python. Both must give the same
+    # value and type.
+    self.Obj1.addProperty("App::PropertyPythonObject","Result")
+    exprs = ['1 + 2', '1 + 2.5', '2 * 1.0', '3 / 2', '4 / 2',
+             '2 ^ 3', '2 ^ -1', '2.0 ^ 2',
+             '-7 % 3', '7 % -3', '-6 % 3', '-7.5 % 2', '7 % -2.5',
+             '2 ^ 53 - 1', '2 ^ 53', '2 ^ 53 + 1', '-(2 ^ 53) - 1', '2 ^ 53 * 3']
+    for expr in exprs:
+      self.Obj1.setExpression('Result', expr)
+      self.Doc.recompute()
+      expected = self.Obj1.evalExpression(expr)
+      self.assertEqual(type(self.Obj1.Result), type(expected), expr)
+      self.assertEqual(self.Obj1.Result, expected, expr)
+    # beyond 2^53 a double cannot hold the exact integer
+    self.assertEqual(self.Obj1.Result, 3 * 2**53)
+    self.Obj1.setExpression('Result', '2 ^ 53 + 1')
+    self.Doc.recompute()
+    self.assertEqual(self.Obj1.Result, 2**53 + 1)
+
   def tearDown(self):
     #closing doc
     FreeCAD.closeDocument(self.Doc.Name)